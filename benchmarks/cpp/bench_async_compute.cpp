@@ -0,0 +1,178 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmarks.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ia::gpu::bench
+{
+  static constexpr u32 ELEMENT_COUNT = 1 << 20;
+  static constexpr u32 DISPATCHES_PER_QUEUE = 8;
+  static constexpr u32 FILL_GROUP_SIZE = 64;
+
+  struct QueueWork
+  {
+    Vec<Buffer> buffers;
+    Vec<DescriptorTable> tables;
+  };
+
+  static auto create_queue_work(MutRef<Context> ctx, Ref<LoadedPipeline> fill, MutRef<QueueWork> work) -> bool
+  {
+    const Vec<BufferDesc> descs(DISPATCHES_PER_QUEUE, BufferDesc{
+                                                          .size_bytes = (u64) ELEMENT_COUNT * sizeof(u32),
+                                                          .usage = EBufferUsage::Storage,
+                                                          .debug_name = "bench_async_output",
+                                                      });
+    work.buffers.resize(DISPATCHES_PER_QUEUE);
+    work.tables.resize(DISPATCHES_PER_QUEUE);
+    if (!ctx.create_buffers(descs, work.buffers) || !ctx.create_descriptor_tables(fill.layouts[0], work.tables))
+      return false;
+
+    Mut<Vec<DescriptorUpdate>> updates;
+    for (Mut<u32> i = 0; i < DISPATCHES_PER_QUEUE; i++)
+      updates.push_back({.table = work.tables[i], .binding = 0, .buffer = work.buffers[i]});
+    ctx.update_descriptor_tables(updates);
+    return true;
+  }
+
+  static auto record_queue_work(Context::CmdListType *cmd, Ref<LoadedPipeline> fill, Ref<QueueWork> work,
+                                const char *scope) -> void
+  {
+    const FillPushConstants push_constants{.count = ELEMENT_COUNT, .value = 1};
+
+    cmd->begin_gpu_scope(scope);
+    for (const auto buffer : work.buffers)
+      cmd->transition_buffer(buffer, EResourceState::GeneralWrite);
+    cmd->begin_compute();
+    cmd->bind_pipeline(fill.pipeline);
+    cmd->push_constants(EShaderStage::Compute, 0, sizeof(push_constants), &push_constants);
+    for (const auto table : work.tables)
+    {
+      cmd->bind_descriptor_table(0, table);
+      cmd->dispatch(ELEMENT_COUNT / FILL_GROUP_SIZE, 1, 1);
+    }
+    cmd->end_compute();
+    cmd->end_gpu_scope();
+  }
+
+  // Submits the same work to both queues and waits for both. `serial` makes the async compute submission wait for the
+  // frame, which is the baseline the concurrent run is compared with.
+  static auto run_both_queues(MutRef<Context> ctx, Ref<LoadedPipeline> fill, Ref<QueueWork> main_work,
+                              Ref<QueueWork> async_work, bool serial) -> bool
+  {
+    const auto cmd = ctx.begin_frame().first;
+    record_queue_work(cmd, fill, main_work, "main_queue");
+
+    const auto async_cmd = ctx.begin_async_compute_commands();
+    if (!async_cmd)
+      return false;
+    record_queue_work(async_cmd, fill, async_work, "async_compute_queue");
+
+    Mut<u64> async_value = 0;
+    if (!serial)
+      async_value = ctx.submit_async_compute_commands(async_cmd, 0);
+    ctx.end_frame(cmd);
+    if (serial)
+      async_value = ctx.submit_async_compute_commands(async_cmd, ctx.get_last_submission_value());
+
+    ctx.wait_for_submission(ctx.get_last_submission_value(), UINT64_MAX);
+    return async_value && ctx.wait_for_async_compute(async_value, UINT64_MAX);
+  }
+
+  // Overlap of the two queues' scopes in the frame the profiler read back last, as a share of the shorter one.
+  static auto get_scope_overlap(Ref<GpuFrameTimings> timings) -> f64
+  {
+    const GpuScopeTiming *main_scope = nullptr;
+    const GpuScopeTiming *async_scope = nullptr;
+    for (const auto &scope : timings.scopes)
+    {
+      if (!strcmp(scope.name, "main_queue"))
+        main_scope = &scope;
+      else if (!strcmp(scope.name, "async_compute_queue"))
+        async_scope = &scope;
+    }
+    if (!main_scope || !async_scope)
+      return -1.0;
+
+    const u64 begin = std::max(main_scope->begin_ns, async_scope->begin_ns);
+    const u64 end = std::min(main_scope->end_ns, async_scope->end_ns);
+    const u64 shorter =
+        std::min(main_scope->end_ns - main_scope->begin_ns, async_scope->end_ns - async_scope->begin_ns);
+    if (end <= begin || !shorter)
+      return 0.0;
+    return 100.0 * (f64) (end - begin) / (f64) shorter;
+  }
+
+  static auto destroy_queue_work(MutRef<Context> ctx, MutRef<QueueWork> work) -> void
+  {
+    for (Mut<DescriptorTable> table : work.tables)
+    {
+      if (table)
+        ctx.destroy_descriptor_tables({&table, 1});
+    }
+    for (const auto buffer : work.buffers)
+    {
+      if (buffer)
+        ctx.destroy_buffers({&buffer, 1});
+    }
+  }
+
+  auto run_async_compute_benchmarks(MutRef<Harness> harness, Ref<BenchmarkEnv> env) -> void
+  {
+    if (!harness.is_selected("async_compute_concurrent") && !harness.is_selected("async_compute_serial") &&
+        !harness.is_selected("async_compute_overlap"))
+      return;
+    if (!env.fill)
+    {
+      harness.skip("async_compute_concurrent", "no pipeline archive");
+      return;
+    }
+
+    MutRef<Context> ctx = *env.ctx;
+    Mut<QueueWork> main_work;
+    Mut<QueueWork> async_work;
+    if (create_queue_work(ctx, *env.fill, main_work) && create_queue_work(ctx, *env.fill, async_work))
+    {
+      const u64 elements = 2ull * ELEMENT_COUNT * DISPATCHES_PER_QUEUE;
+      harness.measure("async_compute_concurrent", "elements", elements,
+                      [&] { return time_ns([&] { run_both_queues(ctx, *env.fill, main_work, async_work, false); }); });
+      harness.measure("async_compute_serial", "elements", elements,
+                      [&] { return time_ns([&] { run_both_queues(ctx, *env.fill, main_work, async_work, true); }); });
+
+      // The profiler reads a frame slot back when the slot is reopened, MAX_PENDING_FRAME_COUNT frames later.
+      run_both_queues(ctx, *env.fill, main_work, async_work, false);
+      for (Mut<u32> i = 0; i < MAX_PENDING_FRAME_COUNT; i++)
+        ctx.end_frame(ctx.begin_frame().first);
+
+      // Uncalibrated timestamps of two queues need not share a time base, their overlap would be meaningless.
+      const auto timings = ctx.get_gpu_frame_timings();
+      const f64 overlap = get_scope_overlap(timings);
+      if (!timings.is_calibrated)
+        harness.skip("async_compute_overlap", "GPU timestamps are not calibrated");
+      else if (overlap < 0.0)
+        harness.skip("async_compute_overlap", "GPU timestamps are unavailable on one of the queues");
+      else
+        harness.record_metric("async_compute_overlap", "percent", overlap);
+    }
+    else
+      harness.skip("async_compute_concurrent", "resource creation failed");
+
+    destroy_queue_work(ctx, main_work);
+    destroy_queue_work(ctx, async_work);
+    ctx.wait_idle();
+  }
+} // namespace ia::gpu::bench
@@ -0,0 +1,186 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmarks.hpp>
+
+#include <format>
+#include <latch>
+#include <thread>
+
+namespace ia::gpu::bench
+{
+  static constexpr u32 RECORDED_DISPATCH_COUNT = 16 * 1024;
+  static constexpr u32 THREAD_COUNTS[] = {1, 2, 4, 8};
+
+  static constexpr u32 THROUGHPUT_ELEMENT_COUNT = 1 << 20;
+  static constexpr u32 THROUGHPUT_DISPATCHES_PER_FRAME = 16;
+  static constexpr u32 FILL_GROUP_SIZE = 64;
+
+  // Records `count` empty dispatches, so that the GPU side of the frame stays negligible next to the recording.
+  static auto record_empty_dispatches(Context::CmdListType *cmd, Ref<BenchmarkEnv> env, DescriptorTable table,
+                                      u32 count) -> void
+  {
+    const FillPushConstants push_constants{.count = 0, .value = 0};
+    for (Mut<u32> i = 0; i < count; i++)
+    {
+      cmd->bind_pipeline(env.fill->pipeline);
+      cmd->bind_descriptor_table(0, table);
+      cmd->push_constants(EShaderStage::Compute, 0, sizeof(push_constants), &push_constants);
+      cmd->dispatch(1, 1, 1);
+    }
+  }
+
+  // Submits the frame and waits for it outside of the timing of the recording benchmarks.
+  static auto finish_frame(MutRef<Context> ctx, Context::CmdListType *cmd) -> void
+  {
+    ctx.end_frame(cmd);
+    ctx.wait_for_submission(ctx.get_last_submission_value(), UINT64_MAX);
+  }
+
+  static auto run_recording_benchmarks(MutRef<Harness> harness, Ref<BenchmarkEnv> env, DescriptorTable table) -> void
+  {
+    MutRef<Context> ctx = *env.ctx;
+
+    harness.measure("record_dispatch", "dispatches", RECORDED_DISPATCH_COUNT, [&] {
+      const auto cmd = ctx.begin_frame().first;
+      const u64 elapsed = time_ns([&] { record_empty_dispatches(cmd, env, table, RECORDED_DISPATCH_COUNT); });
+      finish_frame(ctx, cmd);
+      return elapsed;
+    });
+
+    // The same total work split over worker threads, timed from the moment all of them are released until the last
+    // one ends its list. Thread start-up stays outside of the timing.
+    for (const u32 thread_count : THREAD_COUNTS)
+    {
+      const std::string name = std::format("record_dispatch_threads_{}", thread_count);
+      harness.measure(name.c_str(), "dispatches", RECORDED_DISPATCH_COUNT, [&] {
+        const auto cmd = ctx.begin_frame().first;
+
+        Mut<std::latch> ready(thread_count + 1);
+        Mut<std::latch> start(1);
+        Mut<Vec<std::thread>> threads;
+        threads.reserve(thread_count);
+        for (Mut<u32> t = 0; t < thread_count; t++)
+        {
+          threads.emplace_back([&, t] {
+            ready.count_down();
+            start.wait();
+            const auto thread_cmd = ctx.begin_thread_commands(t);
+            if (!thread_cmd)
+              return;
+            record_empty_dispatches(thread_cmd, env, table, RECORDED_DISPATCH_COUNT / thread_count);
+            ctx.end_thread_commands(thread_cmd);
+          });
+        }
+        ready.arrive_and_wait();
+
+        const u64 elapsed = time_ns([&] {
+          start.count_down();
+          for (auto &thread : threads)
+            thread.join();
+        });
+        finish_frame(ctx, cmd);
+        return elapsed;
+      });
+    }
+  }
+
+  static auto run_dispatch_throughput_benchmark(MutRef<Harness> harness, Ref<BenchmarkEnv> env) -> void
+  {
+    static constexpr const char *NAME = "dispatch_throughput";
+    if (!harness.is_selected(NAME))
+      return;
+
+    MutRef<Context> ctx = *env.ctx;
+
+    // One output buffer per dispatch so that the dispatches of a frame need no barriers between them.
+    const Vec<BufferDesc> buffer_descs(THROUGHPUT_DISPATCHES_PER_FRAME,
+                                       BufferDesc{
+                                           .size_bytes = (u64) THROUGHPUT_ELEMENT_COUNT * sizeof(u32),
+                                           .usage = EBufferUsage::Storage,
+                                           .debug_name = "bench_dispatch_output",
+                                       });
+    Mut<Vec<Buffer>> buffers(THROUGHPUT_DISPATCHES_PER_FRAME);
+    Mut<Vec<DescriptorTable>> tables(THROUGHPUT_DISPATCHES_PER_FRAME);
+    if (!ctx.create_buffers(buffer_descs, buffers) || !ctx.create_descriptor_tables(env.fill->layouts[0], tables))
+    {
+      harness.skip(NAME, "resource creation failed");
+      return;
+    }
+
+    Mut<Vec<DescriptorUpdate>> updates;
+    for (Mut<u32> i = 0; i < THROUGHPUT_DISPATCHES_PER_FRAME; i++)
+      updates.push_back({.table = tables[i], .binding = 0, .buffer = buffers[i]});
+    ctx.update_descriptor_tables(updates);
+
+    const FillPushConstants push_constants{.count = THROUGHPUT_ELEMENT_COUNT, .value = 1};
+    harness.measure(NAME, "elements", (u64) THROUGHPUT_ELEMENT_COUNT * THROUGHPUT_DISPATCHES_PER_FRAME, [&] {
+      return time_ns([&] {
+        const auto cmd = ctx.begin_frame().first;
+
+        for (const auto buffer : buffers)
+          cmd->transition_buffer(buffer, EResourceState::GeneralWrite);
+        cmd->begin_compute();
+        cmd->bind_pipeline(env.fill->pipeline);
+        cmd->push_constants(EShaderStage::Compute, 0, sizeof(push_constants), &push_constants);
+        for (const auto table : tables)
+        {
+          cmd->bind_descriptor_table(0, table);
+          cmd->dispatch(THROUGHPUT_ELEMENT_COUNT / FILL_GROUP_SIZE, 1, 1);
+        }
+        cmd->end_compute();
+
+        finish_frame(ctx, cmd);
+      });
+    });
+
+    ctx.destroy_descriptor_tables(tables);
+    ctx.destroy_buffers(buffers);
+  }
+
+  auto run_command_benchmarks(MutRef<Harness> harness, Ref<BenchmarkEnv> env) -> void
+  {
+    MutRef<Context> ctx = *env.ctx;
+
+    // An empty submission measures the submit, signal and wait round trip on its own.
+    harness.measure("immediate_round_trip", "submissions", 1,
+                    [&] { return time_ns([&] { ctx.execute_immediate_commands([](Context::CmdListType *) {}); }); });
+
+    if (!env.fill)
+    {
+      harness.skip("record_dispatch", "no pipeline archive");
+      harness.skip("dispatch_throughput", "no pipeline archive");
+      return;
+    }
+
+    const BufferDesc desc{.size_bytes = 256, .usage = EBufferUsage::Storage, .debug_name = "bench_record_output"};
+    Mut<Buffer> buffer{};
+    Mut<DescriptorTable> table{};
+    if (ctx.create_buffers({&desc, 1}, {&buffer, 1}) && ctx.create_descriptor_tables(env.fill->layouts[0], {&table, 1}))
+    {
+      const DescriptorUpdate update{.table = table, .binding = 0, .buffer = buffer};
+      ctx.update_descriptor_tables({&update, 1});
+      run_recording_benchmarks(harness, env, table);
+      ctx.destroy_descriptor_tables({&table, 1});
+    }
+    else
+      harness.skip("record_dispatch", "resource creation failed");
+    if (buffer)
+      ctx.destroy_buffers({&buffer, 1});
+
+    run_dispatch_throughput_benchmark(harness, env);
+    ctx.wait_idle();
+  }
+} // namespace ia::gpu::bench
@@ -0,0 +1,115 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmarks.hpp>
+
+#include <filesystem>
+#include <optional>
+
+namespace ia::gpu::bench
+{
+  static constexpr const char *PIPELINE_CACHE_FILE_NAME = "iagpu_benchmarks_pipelines.cache";
+
+  // Creates a context on `cache_path`, loads the archive and creates every variant pipeline, then saves the cache.
+  // Returns the nanoseconds spent from context creation to the last pipeline, 0 if any step failed.
+  static auto create_context_and_pipelines(Ref<BenchmarkEnv> env, Ref<std::string> cache_path) -> u64
+  {
+    Mut<ContextConfig> config = *env.config;
+    config.pipeline_cache_path = cache_path.c_str();
+    config.async_compute_enabled = 0;
+    config.gpu_profiling_enabled = 0;
+
+    Mut<std::optional<Context>> ctx;
+    Mut<LoadedPipelineArchive> archive;
+    Mut<Vec<Pipeline>> pipelines;
+    Mut<bool> succeeded = false;
+    const u64 elapsed = time_ns([&] {
+      auto created = Context::create(config);
+      if (!created)
+      {
+        BENCH_LOG_WARN("Pipeline cache benchmark context: {}", created.error());
+        return;
+      }
+      ctx.emplace(std::move(*created));
+
+      auto loaded = ctx->load_pipeline_archive(env.archive_path, 0);
+      if (!loaded)
+      {
+        BENCH_LOG_WARN("Pipeline cache benchmark archive: {}", loaded.error());
+        return;
+      }
+      archive = std::move(*loaded);
+
+      for (Mut<u32> i = 0; i < FILL_VARIANT_COUNT; i++)
+      {
+        const auto shader = archive.shaders[FILL_VARIANT_FIRST_SHADER_INDEX + i];
+        const auto pipeline = ctx->create_compute_pipeline(ComputePipelineDesc{}.set_shader(shader));
+        if (pipeline)
+          pipelines.push_back(*pipeline);
+      }
+      succeeded = true;
+    });
+
+    if (!ctx)
+      return 0;
+
+    for (const auto pipeline : pipelines)
+      ctx->destroy_pipeline(pipeline);
+    if (succeeded)
+    {
+      ctx->unload_pipeline_archive(archive);
+      succeeded = ctx->save_pipeline_cache();
+    }
+    ctx.reset();
+
+    return succeeded ? elapsed : 0;
+  }
+
+  auto run_pipeline_benchmarks(MutRef<Harness> harness, Ref<BenchmarkEnv> env) -> void
+  {
+    if (!env.archive || env.archive->shaders.size() < FILL_VARIANT_FIRST_SHADER_INDEX + FILL_VARIANT_COUNT)
+    {
+      harness.skip("pipeline_create_cold", "no pipeline archive");
+      harness.skip("pipeline_create_warm", "no pipeline archive");
+      return;
+    }
+    if (!harness.is_selected("pipeline_create_cold") && !harness.is_selected("pipeline_create_warm"))
+      return;
+
+    // Both runs go through a context of their own, so the in-memory cache of `env.ctx` never helps. The cold one
+    // starts from an empty cache file and saves it, the warm one starts from that file. Driver-internal shader caches
+    // are outside of this and can still make the cold run faster than a first launch.
+    Mut<std::error_code> ec;
+    const std::string cache_path = (std::filesystem::temp_directory_path(ec) / PIPELINE_CACHE_FILE_NAME).string();
+    std::filesystem::remove(cache_path, ec);
+
+    Mut<bool> cache_saved = false;
+    const auto measure = [&](const char *name) {
+      harness.measure_once(name, "contexts", 1, [&] {
+        const u64 elapsed = create_context_and_pipelines(env, cache_path);
+        cache_saved = elapsed != 0;
+        return elapsed;
+      });
+    };
+
+    measure("pipeline_create_cold");
+    // The warm run needs the file of a cold one, even when only the warm run was selected.
+    if (!cache_saved && harness.is_selected("pipeline_create_warm"))
+      create_context_and_pipelines(env, cache_path);
+    measure("pipeline_create_warm");
+
+    std::filesystem::remove(cache_path, ec);
+  }
+} // namespace ia::gpu::bench
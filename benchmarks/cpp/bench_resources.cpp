@@ -0,0 +1,236 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmarks.hpp>
+
+#include <stream_copy.hpp>
+
+#include <string>
+
+namespace ia::gpu::bench
+{
+  static constexpr u32 BUFFER_BATCH_SIZE = 1024;
+  static constexpr u32 TEXTURE_BATCH_SIZE = 256;
+  static constexpr u32 DESCRIPTOR_TABLE_COUNT = 256;
+  static constexpr u32 DESCRIPTORS_PER_TABLE = 16;
+
+  static auto run_creation_benchmarks(MutRef<Harness> harness, MutRef<Context> ctx) -> void
+  {
+    // Handles are destroyed inside the timing, the deferred Vulkan destruction is drained outside of it.
+    const Vec<BufferDesc> buffer_descs(
+        BUFFER_BATCH_SIZE, BufferDesc{.size_bytes = 4096, .usage = EBufferUsage::Storage, .debug_name = "bench"});
+    Mut<Vec<Buffer>> buffers(BUFFER_BATCH_SIZE);
+    harness.measure("buffer_create_destroy", "buffers", BUFFER_BATCH_SIZE, [&] {
+      const u64 elapsed = time_ns([&] {
+        if (ctx.create_buffers(buffer_descs, buffers))
+          ctx.destroy_buffers(buffers);
+      });
+      ctx.wait_idle();
+      return elapsed;
+    });
+
+    const Vec<TextureDesc> texture_descs(TEXTURE_BATCH_SIZE, TextureDesc{
+                                                                 .width = 64,
+                                                                 .height = 64,
+                                                                 .format = EFormat::R8G8B8A8Unorm,
+                                                                 .debug_name = "bench",
+                                                             });
+    Mut<Vec<Texture>> textures(TEXTURE_BATCH_SIZE);
+    harness.measure("texture_create_destroy", "textures", TEXTURE_BATCH_SIZE, [&] {
+      const u64 elapsed = time_ns([&] {
+        if (ctx.create_textures(texture_descs, textures))
+          ctx.destroy_textures(textures);
+      });
+      ctx.wait_idle();
+      return elapsed;
+    });
+  }
+
+  static auto run_host_bandwidth_benchmarks(MutRef<Harness> harness, MutRef<Context> ctx) -> void
+  {
+    struct Size
+    {
+      const char *write_name;
+      const char *read_name;
+      u64 bytes;
+    };
+    static constexpr Size SIZES[] = {
+        {"host_write_64k", "host_read_64k", 64ull * 1024},
+        {"host_write_16m", "host_read_16m", 16ull * 1024 * 1024},
+    };
+
+    for (const auto &size : SIZES)
+    {
+      if (!harness.is_selected(size.write_name) && !harness.is_selected(size.read_name))
+        continue;
+
+      Mut<Buffer> buffer{};
+      const BufferDesc desc{
+          .size_bytes = size.bytes, .usage = EBufferUsage::Storage, .host_visible = 1, .debug_name = "bench"};
+      if (!ctx.create_buffers({&desc, 1}, {&buffer, 1}))
+      {
+        harness.skip(size.write_name, "host-visible buffer creation failed");
+        harness.skip(size.read_name, "host-visible buffer creation failed");
+        continue;
+      }
+
+      Mut<Vec<u8>> data(size.bytes);
+      for (Mut<u64> i = 0; i < data.size(); i++)
+        data[i] = (u8) i;
+
+      harness.measure(size.write_name, "bytes", size.bytes,
+                      [&] { return time_ns([&] { ctx.update_host_visible_buffer(buffer, 0, data); }); });
+      harness.measure(size.read_name, "bytes", size.bytes,
+                      [&] { return time_ns([&] { ctx.read_host_visible_buffer(buffer, 0, data); }); });
+
+      ctx.destroy_buffers({&buffer, 1});
+    }
+  }
+
+  // Copies into the mapping of a host-visible buffer through every stream copy path the CPU supports, into cached
+  // memory and into the write-combined memory host_write_only buffers may get. Large enough to miss the caches.
+  static auto run_stream_copy_benchmarks(MutRef<Harness> harness, MutRef<Context> ctx) -> void
+  {
+    static constexpr u64 COPY_SIZE = 64ull * 1024 * 1024;
+    static constexpr EStreamCopyPath PATHS[] = {EStreamCopyPath::Memcpy, EStreamCopyPath::Sse2, EStreamCopyPath::Avx2,
+                                                EStreamCopyPath::Avx512, EStreamCopyPath::Neon};
+
+    struct Memory
+    {
+      const char *name;
+      u8 host_write_only;
+    };
+    static constexpr Memory MEMORIES[] = {{"cached", 0}, {"write_only", 1}};
+
+    Mut<Vec<u8>> data;
+    for (const auto &memory : MEMORIES)
+    {
+      const std::string prefix = std::string("stream_copy_") + memory.name + "_";
+
+      Mut<Vec<EStreamCopyPath>> paths;
+      for (const auto path : PATHS)
+      {
+        const std::string name = prefix + get_stream_copy_path_name(path);
+        if (is_stream_copy_path_supported(path) && harness.is_selected(name.c_str()))
+          paths.push_back(path);
+      }
+      if (paths.empty())
+        continue;
+
+      if (data.empty())
+      {
+        data.resize(COPY_SIZE);
+        for (Mut<u64> i = 0; i < data.size(); i++)
+          data[i] = (u8) i;
+      }
+
+      Mut<Buffer> buffer{};
+      const BufferDesc desc{.size_bytes = COPY_SIZE,
+                            .usage = EBufferUsage::Storage,
+                            .host_visible = 1,
+                            .debug_name = "bench",
+                            .host_write_only = memory.host_write_only};
+      void *mapped = ctx.create_buffers({&desc, 1}, {&buffer, 1}) ? ctx.get_host_visible_pointer(buffer, 0) : nullptr;
+
+      for (const auto path : paths)
+      {
+        const std::string name = prefix + get_stream_copy_path_name(path);
+        if (!mapped)
+        {
+          harness.skip(name.c_str(), "host-visible buffer creation failed");
+          continue;
+        }
+
+        harness.measure(name.c_str(), "bytes", COPY_SIZE, [&] {
+          return time_ns([&] {
+            stream_copy(path, mapped, data.data(), COPY_SIZE);
+            ctx.flush_host_visible_buffer(buffer, 0, COPY_SIZE);
+          });
+        });
+
+        if (const auto result = harness.find_result(name.c_str()))
+          harness.record_metric((name + "_gbps").c_str(), "GB/s", result->throughput / 1e9);
+      }
+
+      if (buffer)
+        ctx.destroy_buffers({&buffer, 1});
+    }
+  }
+
+  static auto run_descriptor_benchmarks(MutRef<Harness> harness, MutRef<Context> ctx) -> void
+  {
+    if (!harness.is_selected("descriptor_update") && !harness.is_selected("descriptor_write_table"))
+      return;
+
+    const BindingLayoutEntry entry{
+        .binding = 0,
+        .count = DESCRIPTORS_PER_TABLE,
+        .visibility = EShaderStage::Compute,
+        .type = EDescriptorType::StorageBuffer,
+    };
+    const auto layout = ctx.create_binding_layout({&entry, 1});
+    if (!layout)
+    {
+      harness.skip("descriptor_update", "binding layout creation failed");
+      harness.skip("descriptor_write_table", "binding layout creation failed");
+      return;
+    }
+
+    const Vec<BufferDesc> buffer_descs(
+        DESCRIPTORS_PER_TABLE, BufferDesc{.size_bytes = 256, .usage = EBufferUsage::Storage, .debug_name = "bench"});
+    Mut<Vec<Buffer>> buffers(DESCRIPTORS_PER_TABLE);
+    Mut<Vec<DescriptorTable>> tables(DESCRIPTOR_TABLE_COUNT);
+    if (!ctx.create_buffers(buffer_descs, buffers) || !ctx.create_descriptor_tables(*layout, tables))
+    {
+      harness.skip("descriptor_update", "resource creation failed");
+      harness.skip("descriptor_write_table", "resource creation failed");
+      ctx.destroy_binding_layout(*layout);
+      return;
+    }
+
+    Mut<Vec<DescriptorUpdate>> updates;
+    updates.reserve(DESCRIPTOR_TABLE_COUNT * DESCRIPTORS_PER_TABLE);
+    for (const auto table : tables)
+    {
+      for (Mut<u32> i = 0; i < DESCRIPTORS_PER_TABLE; i++)
+        updates.push_back({.table = table, .binding = 0, .array_element = i, .buffer = buffers[i]});
+    }
+    harness.measure("descriptor_update", "descriptors", updates.size(),
+                    [&] { return time_ns([&] { ctx.update_descriptor_tables(updates); }); });
+
+    Mut<Vec<DescriptorSlot>> slots(DESCRIPTORS_PER_TABLE);
+    for (Mut<u32> i = 0; i < DESCRIPTORS_PER_TABLE; i++)
+      slots[i].buffer = buffers[i];
+    harness.measure("descriptor_write_table", "descriptors", updates.size(), [&] {
+      return time_ns([&] {
+        for (const auto table : tables)
+          ctx.write_descriptor_table(table, slots);
+      });
+    });
+
+    ctx.destroy_descriptor_tables(tables);
+    ctx.destroy_buffers(buffers);
+    ctx.destroy_binding_layout(*layout);
+  }
+
+  auto run_resource_benchmarks(MutRef<Harness> harness, Ref<BenchmarkEnv> env) -> void
+  {
+    run_creation_benchmarks(harness, *env.ctx);
+    run_host_bandwidth_benchmarks(harness, *env.ctx);
+    run_stream_copy_benchmarks(harness, *env.ctx);
+    run_descriptor_benchmarks(harness, *env.ctx);
+    env.ctx->wait_idle();
+  }
+} // namespace ia::gpu::bench
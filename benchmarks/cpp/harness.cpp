@@ -0,0 +1,128 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <harness.hpp>
+
+#include <algorithm>
+#include <format>
+
+namespace ia::gpu::bench
+{
+  static auto append_json_string(MutRef<std::string> out, Ref<std::string> value) -> void
+  {
+    out.push_back('"');
+    for (const char c : value)
+    {
+      if (c == '"' || c == '\\')
+        out.push_back('\\');
+      if ((u8) c < 0x20)
+        out.append(std::format("\\u{:04x}", (u32) (u8) c));
+      else
+        out.push_back(c);
+    }
+    out.push_back('"');
+  }
+
+  auto Harness::skip(const char *name, const char *reason) -> void
+  {
+    if (!is_selected(name))
+      return;
+
+    BENCH_LOG_WARN("Skipping {}: {}", name, reason);
+    m_results.push_back({.name = name, .skip_reason = reason});
+  }
+
+  auto Harness::record_metric(const char *name, const char *unit, f64 value) -> void
+  {
+    if (!is_selected(name))
+      return;
+
+    BENCH_LOG_INFO("{}: {:.4g} {}", name, value, unit);
+    m_results.push_back({.name = name, .unit = unit, .is_metric = true, .value = value});
+  }
+
+  auto Harness::is_selected(const char *name) const -> bool
+  {
+    return m_filter.empty() || std::string_view(name).find(m_filter) != std::string_view::npos;
+  }
+
+  auto Harness::find_result(const char *name) const -> const BenchmarkResult *
+  {
+    for (const auto &result : m_results)
+    {
+      if (result.name == name)
+        return &result;
+    }
+    return nullptr;
+  }
+
+  auto Harness::add_result(const char *name, const char *unit, u64 items, MutRef<Vec<u64>> samples) -> void
+  {
+    std::sort(samples.begin(), samples.end());
+
+    Mut<BenchmarkResult> result{
+        .name = name,
+        .unit = unit,
+        .items_per_run = items,
+        .runs = (u32) samples.size(),
+        .min_ns = samples.front(),
+        .median_ns = samples[samples.size() / 2],
+        .p90_ns = samples[(samples.size() * 9) / 10],
+        .max_ns = samples.back(),
+    };
+    if (result.median_ns)
+      result.throughput = (f64) items * 1e9 / (f64) result.median_ns;
+
+    BENCH_LOG_INFO("{}: median {:.3f} ms, {:.4g} {}/s", name, (f64) result.median_ns / 1e6, result.throughput, unit);
+    m_results.push_back(std::move(result));
+  }
+
+  auto Harness::write_json(std::FILE *file) const -> void
+  {
+    Mut<std::string> out = "{\n  \"schema\": 1,\n";
+    out.append(std::format("  \"runs\": {},\n  \"counters_enabled\": {},\n  \"benchmarks\": [", m_runs,
+                           IAGPU_ENABLE_COUNTERS ? "true" : "false"));
+
+    for (Mut<size_t> i = 0; i < m_results.size(); i++)
+    {
+      Ref<BenchmarkResult> result = m_results[i];
+      out.append(i ? ",\n    {\"name\": " : "\n    {\"name\": ");
+      append_json_string(out, result.name);
+
+      if (!result.skip_reason.empty())
+      {
+        out.append(", \"skipped\": ");
+        append_json_string(out, result.skip_reason);
+        out.append("}");
+        continue;
+      }
+
+      out.append(", \"unit\": ");
+      append_json_string(out, result.unit);
+      if (result.is_metric)
+      {
+        out.append(std::format(", \"value\": {:.6g}}}", result.value));
+        continue;
+      }
+      out.append(std::format(", \"items_per_run\": {}, \"runs\": {}, \"min_ns\": {}, \"median_ns\": {}, "
+                             "\"p90_ns\": {}, \"max_ns\": {}, \"items_per_second\": {:.6g}}}",
+                             result.items_per_run, result.runs, result.min_ns, result.median_ns, result.p90_ns,
+                             result.max_ns, result.throughput));
+    }
+
+    out.append("\n  ]\n}\n");
+    std::fputs(out.c_str(), file);
+  }
+} // namespace ia::gpu::bench
@@ -0,0 +1,144 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmarks.hpp>
+
+#include <charconv>
+#include <cstdio>
+
+using namespace ia;
+using namespace ia::gpu;
+using namespace ia::gpu::bench;
+
+static constexpr const char *USAGE = "usage: iagpu_benchmarks [-o <json>] [--filter <substring>] [--runs <count>] "
+                                     "[--archive <path>] [--pipeline-cache <path>]\n";
+
+#ifdef IAGPU_BENCHMARK_ARCHIVE
+static constexpr const char *DEFAULT_ARCHIVE_PATH = IAGPU_BENCHMARK_ARCHIVE;
+#else
+static constexpr const char *DEFAULT_ARCHIVE_PATH = "benchmarks.iapa";
+#endif
+
+struct Options
+{
+  std::string output = "iagpu_benchmarks.json";
+  std::string filter;
+  std::string archive = DEFAULT_ARCHIVE_PATH;
+  std::string pipeline_cache;
+  u32 runs = 10;
+};
+
+static auto parse_options(int argc, char **argv) -> Result<Options>
+{
+  Mut<Options> options;
+  for (Mut<int> i = 1; i < argc; i++)
+  {
+    const std::string_view arg = argv[i];
+    if (i + 1 == argc)
+      return fail("'{}' expects a value", arg);
+
+    const std::string_view value = argv[++i];
+    if (arg == "-o")
+      options.output = value;
+    else if (arg == "--filter")
+      options.filter = value;
+    else if (arg == "--archive")
+      options.archive = value;
+    else if (arg == "--pipeline-cache")
+      options.pipeline_cache = value;
+    else if (arg == "--runs")
+    {
+      const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), options.runs);
+      if (error != std::errc{} || end != value.data() + value.size() || options.runs == 0)
+        return fail("'{}' is not a valid run count", value);
+    }
+    else
+      return fail("unexpected argument '{}'", arg);
+  }
+
+  return options;
+}
+
+static auto run(Ref<Options> options) -> Result<void>
+{
+  // Validation is off so that the layers do not dominate the CPU-side numbers. Set VK_ICD_FILENAMES to run on
+  // lavapipe or SwiftShader. Profiling only costs a readback per frame unless scopes are recorded.
+  const ContextConfig config{
+      .app_name = "iagpu_benchmarks",
+      .validation_enabled = 0,
+      .pipeline_cache_path = options.pipeline_cache.empty() ? nullptr : options.pipeline_cache.c_str(),
+      .async_compute_enabled = 1,
+      .gpu_profiling_enabled = 1,
+  };
+  Mut<Context> ctx = AU_TRY(Context::create(config));
+
+  Mut<Harness> harness(options.runs, options.filter);
+
+  Mut<LoadedPipelineArchive> archive;
+  Mut<BenchmarkEnv> env{.ctx = &ctx, .config = &config, .archive_path = options.archive.c_str()};
+  const auto load_archive = [&] {
+    auto loaded = ctx.load_pipeline_archive(options.archive.c_str(), 0);
+    if (!loaded)
+    {
+      BENCH_LOG_WARN("Benchmarks that need a pipeline are skipped: {}", loaded.error());
+      return;
+    }
+    archive = std::move(*loaded);
+    env.archive = &archive;
+    env.fill = archive.find_pipeline("fill");
+  };
+  if (harness.is_selected("pipeline_archive_load"))
+    harness.measure_once("pipeline_archive_load", "archives", 1, [&] { return time_ns(load_archive); });
+  else
+    load_archive();
+
+  run_resource_benchmarks(harness, env);
+  run_command_benchmarks(harness, env);
+  run_async_compute_benchmarks(harness, env);
+  run_pipeline_benchmarks(harness, env);
+
+  if (env.archive)
+    ctx.unload_pipeline_archive(archive);
+  ctx.wait_idle();
+
+  std::FILE *file = std::fopen(options.output.c_str(), "w");
+  if (!file)
+    return fail("failed to open '{}' for writing", options.output);
+  harness.write_json(file);
+  std::fclose(file);
+
+  BENCH_LOG_INFO("Wrote results to {}", options.output);
+  return {};
+}
+
+int main(int argc, char **argv)
+{
+  const auto options = parse_options(argc, argv);
+  if (!options)
+  {
+    BENCH_LOG_ERROR("{}", options.error());
+    fputs(USAGE, stderr);
+    return 2;
+  }
+
+  const auto result = run(*options);
+  if (!result)
+  {
+    BENCH_LOG_ERROR("{}", result.error());
+    return 1;
+  }
+
+  return 0;
+}
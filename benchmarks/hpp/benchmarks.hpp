@@ -0,0 +1,62 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <harness.hpp>
+
+#include <vulkan/context.hpp>
+
+namespace ia::gpu::bench
+{
+  using vulkan::Context;
+
+  // Shaders of benchmarks.manifest in archive order: `fill` first, then one `fill_variant` permutation per SCALE
+  // value. The variants have no pipeline in the archive, so creating one is never a cache hit within a process.
+  static constexpr u32 FILL_SHADER_INDEX = 0;
+  static constexpr u32 FILL_VARIANT_FIRST_SHADER_INDEX = 1;
+  static constexpr u32 FILL_VARIANT_COUNT = 16;
+
+  struct FillPushConstants
+  {
+    u32 count;
+    u32 value;
+  };
+
+  // Everything the groups share. `archive` is null when no baked archive could be loaded, groups then skip the
+  // benchmarks that need a pipeline. `config` and `archive_path` let a group create contexts of its own.
+  struct BenchmarkEnv
+  {
+    Context *ctx = nullptr;
+    const ContextConfig *config = nullptr;
+    const char *archive_path = nullptr;
+    const LoadedPipelineArchive *archive = nullptr;
+    const LoadedPipeline *fill = nullptr;
+  };
+
+  // Creation and destruction of buffers and textures, host-visible buffer bandwidth, stream copies and descriptor
+  // updates.
+  auto run_resource_benchmarks(MutRef<Harness> harness, Ref<BenchmarkEnv> env) -> void;
+
+  // Command recording on one and several threads, immediate submission latency and dispatch throughput.
+  auto run_command_benchmarks(MutRef<Harness> harness, Ref<BenchmarkEnv> env) -> void;
+
+  // Dispatches on the main and the async compute queue at once and one after the other, and how much the two
+  // overlapped according to GPU timestamps.
+  auto run_async_compute_benchmarks(MutRef<Harness> harness, Ref<BenchmarkEnv> env) -> void;
+
+  // Context and compute pipeline creation against an empty and a saved on-disk pipeline cache.
+  auto run_pipeline_benchmarks(MutRef<Harness> harness, Ref<BenchmarkEnv> env) -> void;
+} // namespace ia::gpu::bench
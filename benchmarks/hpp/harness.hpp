@@ -0,0 +1,123 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <gpu/gpu.hpp>
+
+#include <crux/logger.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#define BENCH_LOG_INFO(...) IA_LOG_INFO("[Bench]: " __VA_ARGS__)
+#define BENCH_LOG_WARN(...) IA_LOG_WARN("[Bench]: " __VA_ARGS__)
+#define BENCH_LOG_ERROR(...) IA_LOG_ERROR("[Bench]: " __VA_ARGS__)
+
+namespace ia::gpu::bench
+{
+  struct BenchmarkResult
+  {
+    std::string name;
+    std::string unit; // what one item of work is, e.g. "bytes" or "dispatches"
+    u64 items_per_run = 0;
+    u32 runs = 0;
+
+    u64 min_ns = 0;
+    u64 median_ns = 0;
+    u64 p90_ns = 0;
+    u64 max_ns = 0;
+
+    // Items per second at the median run time.
+    f64 throughput = 0.0;
+
+    // Set for derived measurements that are not a timing, which then only have a value in `unit`.
+    bool is_metric = false;
+    f64 value = 0.0;
+
+    std::string skip_reason; // non-empty when the benchmark could not run
+  };
+
+  // Runs each benchmark a fixed number of times after a warm-up run and keeps order statistics rather than means, so
+  // that results stay comparable between CI runs on noisy machines.
+  class Harness
+  {
+public:
+    Harness(u32 runs, std::string filter) : m_runs(runs), m_filter(std::move(filter))
+    {
+    }
+
+    // `body` performs one run of `items` units of work and returns the nanoseconds it spent on the part being
+    // measured, so setup and teardown can stay outside of the timing.
+    template<typename Func> auto measure(const char *name, const char *unit, u64 items, Func &&body) -> void
+    {
+      measure(name, unit, items, m_runs, body);
+    }
+
+    template<typename Func> auto measure(const char *name, const char *unit, u64 items, u32 runs, Func &&body) -> void
+    {
+      if (!is_selected(name))
+        return;
+
+      body();
+
+      Mut<Vec<u64>> samples;
+      samples.reserve(runs);
+      for (Mut<u32> i = 0; i < runs; i++)
+        samples.push_back(body());
+
+      add_result(name, unit, items, samples);
+    }
+
+    // Measures a single run without warm-up, for effects that only happen once per process such as a cold cache.
+    template<typename Func> auto measure_once(const char *name, const char *unit, u64 items, Func &&body) -> void
+    {
+      if (!is_selected(name))
+        return;
+
+      Mut<Vec<u64>> samples;
+      samples.push_back(body());
+      add_result(name, unit, items, samples);
+    }
+
+    auto skip(const char *name, const char *reason) -> void;
+
+    auto record_metric(const char *name, const char *unit, f64 value) -> void;
+
+    [[nodiscard]] auto is_selected(const char *name) const -> bool;
+
+    // Result recorded under `name`, null if it was not selected.
+    [[nodiscard]] auto find_result(const char *name) const -> const BenchmarkResult *;
+
+    auto write_json(std::FILE *file) const -> void;
+
+private:
+    auto add_result(const char *name, const char *unit, u64 items, MutRef<Vec<u64>> samples) -> void;
+
+    u32 m_runs;
+    std::string m_filter;
+    Vec<BenchmarkResult> m_results;
+  };
+
+  template<typename Func> auto time_ns(Func &&func) -> u64
+  {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return (u64) std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  }
+} // namespace ia::gpu::bench
@@ -28,7 +28,7 @@ namespace ia::gpu
                                    Pipeline pipeline, DescriptorTable descriptor_table,
                                    const ColorAttachment *color_attachments, const DepthAttachment *depth_attachment,
                                    const Viewport &viewport, const Rect2D &scissor, EShaderStage shader_stage,
-                                   EResourceState resource_state, const void *const_void_ptr) {
+                                   EResourceState resource_state, const void *const_void_ptr, QueryPool query_pool) {
     { cmd.begin_rendering(u32_val, color_attachments, depth_attachment) } -> std::same_as<void>;
     { cmd.end_rendering() } -> std::same_as<void>;
 
@@ -39,6 +39,7 @@ namespace ia::gpu
     { cmd.bind_index_buffer(buffer, u64_val, bool_val) } -> std::same_as<void>;
     { cmd.bind_pipeline(pipeline) } -> std::same_as<void>;
     { cmd.bind_descriptor_table(u32_val, descriptor_table) } -> std::same_as<void>;
+    { cmd.bind_bindless_heap(u32_val) } -> std::same_as<void>;
 
     { cmd.push_constants(shader_stage, u32_val, u32_val, const_void_ptr) } -> std::same_as<void>;
 
@@ -64,6 +65,16 @@ namespace ia::gpu
     {
       cmd.blit_texture(texture, resource_state, texture, resource_state, std::span<const TextureBlitRegion>{}, bool_val)
     } -> std::same_as<void>;
+
+    { cmd.reset_queries(query_pool, u32_val, u32_val) } -> std::same_as<void>;
+    { cmd.begin_query(query_pool, u32_val) } -> std::same_as<void>;
+    { cmd.end_query(query_pool, u32_val) } -> std::same_as<void>;
+    { cmd.copy_query_results(query_pool, u32_val, u32_val, buffer, u64_val) } -> std::same_as<void>;
+    { cmd.begin_conditional_rendering(buffer, u64_val, bool_val) } -> std::same_as<void>;
+    { cmd.end_conditional_rendering() } -> std::same_as<void>;
+
+    { cmd.begin_gpu_scope("") } -> std::same_as<void>;
+    { cmd.end_gpu_scope() } -> std::same_as<void>;
   };
 
   template<typename T>
@@ -74,12 +85,18 @@ namespace ia::gpu
                const GraphicsPipelineDesc &graphics_desc, std::span<const BufferDesc> buffer_descs,
                std::span<Buffer> out_buffers, std::span<const Buffer> buffers,
                std::span<const TextureDesc> texture_descs, std::span<Texture> out_textures, std::span<Texture> textures,
+               std::span<const TransientTextureDesc> transient_texture_descs,
+               std::span<const TransientBufferDesc> transient_buffer_descs,
                std::span<const SamplerDesc> sampler_descs, std::span<Sampler> out_samplers, std::span<Sampler> samplers,
                std::span<Fence> out_fences, std::span<const Fence> fences, std::span<const u8> data_span,
                std::span<u8> mut_data_span, std::span<const BindingLayoutEntry> binding_layout_entries,
                std::span<DescriptorTable> out_descriptor_tables, std::span<DescriptorTable> descriptor_tables,
                std::span<const BufferTextureCopyRegion> buffer_texture_copy_regions,
-               std::span<const DescriptorUpdate> descriptor_updates) {
+               std::span<const DescriptorUpdate> descriptor_updates, std::span<const DescriptorSlot> descriptor_slots,
+               LoadedPipelineArchive &loaded_archive, QueryPool query_pool,
+               std::span<const QueryPoolDesc> query_pool_descs, std::span<QueryPool> out_query_pools,
+               std::span<const QueryPool> query_pools, std::span<u64> u64_span,
+               std::span<PipelineStatistics> pipeline_statistics, ReadbackTicket readback_ticket) {
         typename T::CmdListType;
         requires IsCommandList<typename T::CmdListType>;
 
@@ -88,19 +105,43 @@ namespace ia::gpu
         { ctx.begin_frame() } -> std::same_as<std::pair<typename T::CmdListType *, u32>>;
         { ctx.end_frame(cmd_list) } -> std::same_as<bool>;
 
+        { ctx.begin_thread_commands(u32_val) } -> std::same_as<typename T::CmdListType *>;
+        { ctx.end_thread_commands(cmd_list) } -> std::same_as<void>;
+
+        { ctx.begin_async_compute_commands() } -> std::same_as<typename T::CmdListType *>;
+        { ctx.submit_async_compute_commands(cmd_list, u64_val) } -> std::same_as<u64>;
+        { ctx.add_async_compute_dependency(u64_val) } -> std::same_as<void>;
+        { ctx.get_completed_async_compute_value() } -> std::same_as<u64>;
+        { ctx.wait_for_async_compute(u64_val, u64_val) } -> std::same_as<bool>;
+        { ctx.has_async_compute_family() } -> std::same_as<bool>;
+
         { ctx.create_buffers(buffer_descs, out_buffers) } -> std::convertible_to<bool>;
         { ctx.destroy_buffers(buffers) } -> std::same_as<void>;
 
         { ctx.create_textures(texture_descs, out_textures) } -> std::convertible_to<bool>;
         { ctx.destroy_textures(textures) } -> std::same_as<void>;
 
+        {
+          ctx.create_transient_resources(transient_texture_descs, out_textures, transient_buffer_descs, out_buffers)
+        } -> std::convertible_to<bool>;
+        { ctx.get_transient_memory_stats() } -> std::same_as<TransientMemoryStats>;
+
         { ctx.create_compute_pipeline(compute_desc) } -> std::same_as<Result<Pipeline>>;
         { ctx.create_graphics_pipeline(graphics_desc) } -> std::same_as<Result<Pipeline>>;
         { ctx.destroy_pipeline(pipeline) } -> std::same_as<void>;
+        { ctx.get_pipeline_binding_layout(pipeline, u32_val) } -> std::same_as<Result<BindingLayout>>;
+        { ctx.save_pipeline_cache() } -> std::same_as<bool>;
+        { ctx.load_pipeline_archive("", u32_val) } -> std::same_as<Result<LoadedPipelineArchive>>;
+        { ctx.unload_pipeline_archive(loaded_archive) } -> std::same_as<void>;
 
         { ctx.create_samplers(sampler_descs, out_samplers) } -> std::convertible_to<bool>;
         { ctx.destroy_samplers(samplers) } -> std::same_as<void>;
 
+        { ctx.create_query_pools(query_pool_descs, out_query_pools) } -> std::convertible_to<bool>;
+        { ctx.destroy_query_pools(query_pools) } -> std::same_as<void>;
+        { ctx.get_occlusion_results(query_pool, u32_val, u64_span) } -> std::same_as<bool>;
+        { ctx.get_pipeline_statistics(query_pool, u32_val, pipeline_statistics) } -> std::same_as<bool>;
+
         { ctx.create_fences(out_fences, bool_val) } -> std::convertible_to<bool>;
         { ctx.destroy_fences(fences) } -> std::same_as<void>;
         { ctx.wait_for_fences(fences, bool_val, u64_val) } -> std::same_as<bool>;
@@ -113,14 +154,26 @@ namespace ia::gpu
         { ctx.destroy_binding_layout(binding_layout) } -> std::same_as<void>;
 
         { ctx.create_descriptor_tables(binding_layout, out_descriptor_tables) } -> std::convertible_to<bool>;
+        { ctx.create_transient_descriptor_tables(binding_layout, out_descriptor_tables) } -> std::convertible_to<bool>;
+        { ctx.get_bindless_index(texture) } -> std::same_as<u32>;
+        { ctx.get_bindless_index(buffer) } -> std::same_as<u32>;
+        { ctx.get_bindless_index(sampler) } -> std::same_as<u32>;
+        { ctx.get_bindless_layout() } -> std::same_as<Result<BindingLayout>>;
         { ctx.destroy_descriptor_tables(descriptor_tables) } -> std::same_as<void>;
         { ctx.update_descriptor_tables(descriptor_updates) } -> std::same_as<void>;
+        { ctx.write_descriptor_table(descriptor_table, descriptor_slots) } -> std::same_as<void>;
 
         { ctx.resize_swapchain(u32_val, u32_val) } -> std::same_as<Result<void>>;
         { ctx.get_back_buffer() } -> std::same_as<Texture>;
 
         { ctx.update_host_visible_buffer(buffer, u64_val, data_span) } -> std::same_as<void>;
         { ctx.read_host_visible_buffer(buffer, u64_val, mut_data_span) } -> std::same_as<void>;
+        { ctx.get_host_visible_pointer(buffer, u64_val) } -> std::same_as<void *>;
+        { ctx.flush_host_visible_buffer(buffer, u64_val, u64_val) } -> std::same_as<void>;
+
+        { ctx.read_buffer_async(cmd_list, buffer, u64_val, u64_val) } -> std::same_as<Result<ReadbackTicket>>;
+        { ctx.get_readback_data(readback_ticket) } -> std::same_as<std::span<const u8>>;
+        { ctx.release_readback(readback_ticket) } -> std::same_as<void>;
 
         { ctx.update_texture(texture, data_span, buffer_texture_copy_regions) } -> std::convertible_to<bool>;
         { ctx.generate_mipmaps(texture) } -> std::convertible_to<bool>;
@@ -129,6 +182,21 @@ namespace ia::gpu
         { ctx.get_buffer_size(buffer) } -> std::same_as<u32>;
         { ctx.get_texture_info(texture) } -> std::same_as<TextureInfo>;
 
+        { ctx.get_staging_stats() } -> std::same_as<StagingStats>;
+        { ctx.get_memory_budget() } -> std::same_as<MemoryBudget>;
+        { ctx.get_gpu_frame_timings() } -> std::same_as<GpuFrameTimings>;
+        { ctx.get_frame_counters() } -> std::same_as<ApiCounters>;
+
+        { ctx.get_last_submission_value() } -> std::same_as<u64>;
+        { ctx.get_completed_submission_value() } -> std::same_as<u64>;
+        { ctx.wait_for_submission(u64_val, u64_val) } -> std::same_as<bool>;
+
+        { ctx.upload_buffer_async(buffer, u64_val, data_span) } -> std::same_as<u64>;
+        { ctx.upload_texture_async(texture, data_span, buffer_texture_copy_regions) } -> std::same_as<u64>;
+        { ctx.flush_async_uploads() } -> std::same_as<u64>;
+        { ctx.get_completed_upload_value() } -> std::same_as<u64>;
+        { ctx.wait_for_upload(u64_val, u64_val) } -> std::same_as<bool>;
+
         {
           ctx.execute_immediate_commands([](typename T::CmdListType * _) {})
         } -> std::convertible_to<bool>;
@@ -83,7 +83,17 @@ namespace ia::gpu
     Uniform = (1 << 2),
     Storage = (1 << 3),
     Transfer = (1 << 4),
-    Indirect = (1 << 5)
+    Indirect = (1 << 5),
+    Predicate = (1 << 6), // conditional rendering source, also a valid query results destination
+  };
+
+  // How readily a resource gives up device memory under pressure. Low priority resources are demoted first and placed
+  // in host memory while the context is over its pressure threshold, high priority ones are kept resident the longest.
+  enum class EMemoryPriority
+  {
+    Normal = 0,
+    High,
+    Low,
   };
 
   enum class EResourceState
@@ -96,6 +106,13 @@ namespace ia::gpu
     ColorTarget,
     DepthTarget,
     Present,
+    Predicate, // buffers only, read by conditional rendering
+  };
+
+  enum class EQueryType
+  {
+    Occlusion = 0,
+    PipelineStatistics,
   };
 
   enum class EDescriptorType
@@ -18,7 +18,14 @@
 #include <gpu/config.hpp>
 #include <gpu/concepts.hpp>
 
+#include <span>
+#include <string>
+
 namespace ia::gpu
 {
   static constexpr u32 MAX_PENDING_FRAME_COUNT = 3;
+
+  // Serializes GPU frame timings as Chrome trace-event JSON, loadable in chrome://tracing and Perfetto. Each scope
+  // becomes a complete event on the thread of its command list track.
+  auto export_chrome_trace(std::span<const GpuFrameTimings> frames, u32 process_id = 0) -> std::string;
 }
\ No newline at end of file
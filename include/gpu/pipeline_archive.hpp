@@ -0,0 +1,128 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <gpu/enums.hpp>
+
+namespace ia::gpu
+{
+  // On-disk layout of a baked pipeline archive, as written by the pipeline baker.
+  //
+  // The file is a header followed by flat tables of the fixed-size records below; every offset is in bytes from the
+  // start of the file and every table and SPIR-V blob starts 8-byte aligned, so a loader can map the file and point
+  // straight into it. Names live in a string table and are not null terminated. Enums are stored as their u32 value.
+  static constexpr u32 PIPELINE_ARCHIVE_MAGIC = 0x41504149; // "IAPA"
+  static constexpr u32 PIPELINE_ARCHIVE_VERSION = 1;
+
+  static constexpr u32 PIPELINE_ARCHIVE_INVALID_INDEX = UINT32_MAX;
+
+  struct PipelineArchiveHeader
+  {
+    u32 magic;
+    u32 version;
+
+    u32 shader_count;
+    u32 pipeline_count;
+    u32 binding_count;
+    u32 vertex_binding_count;
+    u32 vertex_attribute_count;
+    u32 reserved;
+
+    u64 shader_table_offset;
+    u64 pipeline_table_offset;
+    u64 binding_table_offset;
+    u64 vertex_binding_table_offset;
+    u64 vertex_attribute_table_offset;
+    u64 string_table_offset;
+    u64 string_table_size;
+  };
+
+  struct PipelineArchiveString
+  {
+    u32 offset; // into the string table
+    u32 length;
+  };
+
+  // One compiled permutation of a shader entry point, with the resource interface reflected from its SPIR-V.
+  struct PipelineArchiveShader
+  {
+    PipelineArchiveString name;
+    PipelineArchiveString entry_point;
+
+    u64 code_offset;
+    u64 code_size; // bytes, a multiple of 4
+
+    u32 stage; // EShaderStage
+    u32 first_binding;
+    u32 binding_count;
+    u32 push_constant_size;
+  };
+
+  struct PipelineArchiveBinding
+  {
+    u32 set;
+    u32 binding;
+    u32 count;
+    u32 type;       // EDescriptorType
+    u32 visibility; // EShaderStage
+  };
+
+  struct PipelineArchiveVertexBinding
+  {
+    u32 binding;
+    u32 stride;
+    u32 input_rate; // EInputRate
+  };
+
+  struct PipelineArchiveVertexAttribute
+  {
+    u32 location;
+    u32 binding;
+    u32 format; // EFormat
+    u32 offset;
+  };
+
+  struct PipelineArchivePipeline
+  {
+    PipelineArchiveString name;
+
+    // Compute pipelines only use compute_shader, graphics pipelines use vertex_shader and fragment_shader. The
+    // unused slots hold PIPELINE_ARCHIVE_INVALID_INDEX.
+    u32 compute_shader;
+    u32 vertex_shader;
+    u32 fragment_shader;
+
+    u32 push_constant_size;
+    u32 push_constant_stages; // EShaderStage
+
+    u32 color_attachment_count;
+    u32 color_formats[7]; // EFormat
+    u32 depth_format;     // EFormat
+
+    u32 cull_mode;      // ECullMode
+    u32 blend_mode;     // EBlendMode
+    u32 polygon_mode;   // EPolygonMode
+    u32 primitive_type; // EPrimitiveType
+
+    u32 first_vertex_binding;
+    u32 vertex_binding_count;
+    u32 first_vertex_attribute;
+    u32 vertex_attribute_count;
+  };
+
+  static_assert(sizeof(PipelineArchiveHeader) % 8 == 0);
+  static_assert(sizeof(PipelineArchiveShader) % 8 == 0);
+} // namespace ia::gpu
@@ -17,6 +17,8 @@
 
 #include <gpu/enums.hpp>
 
+#include <string>
+
 namespace ia::gpu
 {
   typedef struct Context_T *Context;
@@ -30,8 +32,16 @@ namespace ia::gpu
   typedef struct CommandListT *CommandList;
   typedef struct Fence_T *Fence;
   typedef struct Semaphore_T *Semaphore;
+  typedef struct QueryPool_T *QueryPool;
+  typedef struct ReadbackTicket_T *ReadbackTicket;
+
+  struct MemoryBudget;
 
   typedef void *(*SurfaceCreationCallback)(void *instance_handle, void *user_data);
+  typedef void (*MemoryPressureCallback)(const MemoryBudget *budget, void *user_data);
+
+  // Bindless index of a resource that has none, because bindless is disabled or the resource cannot be bound that way.
+  static constexpr u32 BINDLESS_INVALID_INDEX = UINT32_MAX;
 
   struct ContextConfig
   {
@@ -39,8 +49,136 @@ namespace ia::gpu
     u8 validation_enabled = 1;
     EBackendType backend_type = EBackendType::Auto;
 
+    // Physical device override, the first one set is used and must match a suitable device. Without one the highest
+    // scoring device wins, the log lists the score of every candidate.
+    u32 device_index = UINT32_MAX;     // in enumeration order
+    const char *device_uuid = nullptr; // deviceUUID as 32 hex digits, dashes are ignored
+    const char *device_name = nullptr; // case-insensitive substring of the device name
+
     void *surface_creation_callback_user_data = nullptr;
     SurfaceCreationCallback surface_creation_callback = nullptr;
+
+    // Ceiling on the memory this context allocates from each device-local heap, 0 leaves it at the heap's budget.
+    // Allocations past it fall back to host memory where the resource allows it and fail cleanly otherwise.
+    u64 device_memory_limit = 0;
+
+    // Fraction of the ceiling (or budget) past which the context is under pressure: low priority resources get
+    // demoted, and the callback is called once as the next frame begins so it can release what it can recreate.
+    f32 memory_pressure_threshold = 0.9f;
+    void *memory_pressure_callback_user_data = nullptr;
+    MemoryPressureCallback memory_pressure_callback = nullptr;
+
+    u64 staging_ring_size = 64ull * 1024 * 1024;
+
+    // Host-cached memory the non-blocking buffer readbacks copy into. Readbacks larger than half of it, or that find it
+    // full, get a dedicated buffer instead.
+    u64 readback_ring_size = 16ull * 1024 * 1024;
+
+    // Opt-in pooling of small buffers. Buffers of up to buffer_pool_max_size bytes with normal memory priority are
+    // suballocated from shared pages of buffer_pool_page_size bytes, one set of pages per usage and host visibility,
+    // which saves a VkBuffer and a device allocation per buffer.
+    u8 buffer_pooling_enabled = 0;
+    u64 buffer_pool_max_size = 64 * 1024;
+    u64 buffer_pool_page_size = 4ull * 1024 * 1024;
+    u64 async_upload_ring_size = 64ull * 1024 * 1024;
+
+    // Number of worker threads that may record command lists for a frame at once.
+    u32 max_recording_threads = 8;
+
+    // File the pipeline cache is loaded from at startup and saved to on shutdown, nullptr keeps it in memory only.
+    const char *pipeline_cache_path = nullptr;
+
+    // Sets in the first descriptor pool, later pools are chained on demand and grow from there.
+    u32 descriptor_pool_set_count = 1024;
+    u32 transient_descriptor_pool_set_count = 256; // per pending frame
+
+    // Opt-in bindless heap: every texture, storage buffer and sampler gets a stable index into one descriptor set that
+    // is bound once per command list. Capacities are clamped to the device limits.
+    u8 bindless_enabled = 0;
+    u32 bindless_resource_capacity = 64 * 1024;
+    u32 bindless_sampler_capacity = 1024;
+
+    // Opt-in async compute queue for Context::begin_async_compute_commands. When it lives in another queue family than
+    // the main queue, buffers and textures are shared between the families concurrently, which may cost some texture
+    // compression. Without it, or without a spare queue, async compute lists run on the main queue.
+    u8 async_compute_enabled = 0;
+
+    // Opt-in GPU timing scopes (CommandList::begin_gpu_scope), read back per frame through get_gpu_frame_timings.
+    u8 gpu_profiling_enabled = 0;
+    u32 gpu_profiler_max_scopes = 1024; // per frame
+  };
+
+  struct StagingStats
+  {
+    u64 ring_capacity = 0;
+    u64 ring_bytes_in_use = 0;
+    u64 ring_high_water_mark = 0;  // peak bytes in flight across all pending frames
+    u64 frame_high_water_mark = 0; // peak bytes consumed by a single frame
+    u64 spill_count = 0;           // uploads served by a dedicated allocation
+    u64 spill_bytes = 0;
+    u64 ring_full_count = 0; // spills caused by the ring being full rather than by upload size
+  };
+
+  // One memory heap of the device. Budget and usage come from VK_EXT_memory_budget when the device has it and are
+  // estimated from the heap size and this context's own allocations otherwise.
+  struct MemoryHeapBudget
+  {
+    u64 size = 0;
+    u64 budget = 0;          // what the process may allocate from the heap, at most ContextConfig::device_memory_limit
+    u64 usage = 0;           // allocated by the whole process, other contexts and APIs included
+    u64 allocated_bytes = 0; // live allocations of this context
+    u64 block_bytes = 0;     // device memory blocks this context holds them in
+    u64 demoted_bytes = 0;   // low priority allocations currently demoted by the residency manager
+    u8 device_local = 0;
+  };
+
+  struct MemoryBudget
+  {
+    Vec<MemoryHeapBudget> heaps; // in the device's heap order
+    u8 is_driver_budget = 0;     // reported by VK_EXT_memory_budget rather than estimated
+    u8 is_under_pressure = 0;
+  };
+
+  // CPU-side API usage of one frame, counted from one begin_frame to the next. All zero unless the library was built
+  // with IAGPU_ENABLE_COUNTERS.
+  struct ApiCounters
+  {
+    u64 draws = 0;
+    u64 dispatches = 0;
+    u64 pipeline_binds = 0;
+    u64 descriptor_binds = 0;
+    u64 barriers = 0;        // buffer and image barriers
+    u64 barrier_batches = 0; // pipeline barrier commands they were issued in
+    u64 descriptor_writes = 0;
+    u64 staging_bytes = 0;      // through the per-frame staging ring
+    u64 async_upload_bytes = 0; // through the transfer queue
+    u64 resources_created = 0;  // handles of any type
+    u64 resources_destroyed = 0;
+    u64 immediate_submissions = 0;
+    u64 async_compute_submissions = 0;
+
+    u64 begin_frame_ns = 0;
+    u64 end_frame_ns = 0;
+    u64 immediate_commands_ns = 0;
+  };
+
+  // One GPU scope of a frame. Times are nanoseconds of the host's steady clock when the device can calibrate its
+  // timestamps against it (GpuFrameTimings::is_calibrated), and relative to the frame's first scope otherwise.
+  struct GpuScopeTiming
+  {
+    const char *name = nullptr;
+    u32 parent = UINT32_MAX; // index into GpuFrameTimings::scopes, UINT32_MAX for a root scope
+    u32 depth = 0;
+    u32 track = 0; // command list the scope was recorded on, in the order lists first recorded a scope
+    u64 begin_ns = 0;
+    u64 end_ns = 0;
+  };
+
+  struct GpuFrameTimings
+  {
+    u64 submission_value = 0; // main timeline value of the frame's submission, 0 before any frame was read back
+    bool is_calibrated = false;
+    Vec<GpuScopeTiming> scopes; // parents always come before their children
   };
 
   struct Rect2D
@@ -67,6 +205,11 @@ namespace ia::gpu
     EBufferUsage usage = EBufferUsage::Uniform;
     u8 host_visible = 0;
     const char *debug_name = nullptr;
+    EMemoryPriority memory_priority = EMemoryPriority::Normal;
+
+    // With host_visible, promises that the host only writes the buffer, front to back, and never reads it back. The
+    // memory may then be write-combined, or device-local where the device exposes that to the host.
+    u8 host_write_only = 0;
   };
 
   struct TextureDesc
@@ -79,6 +222,30 @@ namespace ia::gpu
     u32 array_layers = 1;
     ETextureType type = ETextureType::Texture2D;
     const char *debug_name = nullptr;
+    EMemoryPriority memory_priority = EMemoryPriority::Normal;
+  };
+
+  // A resource that only lives between two points of a frame, given in the caller's own numbering (e.g. pass indices)
+  // and inclusive. Transient resources whose intervals do not overlap may share memory.
+  struct TransientTextureDesc
+  {
+    TextureDesc texture = {};
+    u32 first_use = 0;
+    u32 last_use = 0;
+  };
+
+  struct TransientBufferDesc
+  {
+    BufferDesc buffer = {}; // host_visible is not supported
+    u32 first_use = 0;
+    u32 last_use = 0;
+  };
+
+  struct TransientMemoryStats
+  {
+    u64 requested_bytes = 0; // summed sizes of the resources of the last create_transient_resources call
+    u64 packed_bytes = 0;    // heap bytes those resources were packed into
+    u64 heap_bytes = 0;      // transient heap memory held across all pending frames
   };
 
   struct BufferCopyRegion
@@ -95,6 +262,25 @@ namespace ia::gpu
     const char *debug_name = nullptr;
   };
 
+  struct QueryPoolDesc
+  {
+    EQueryType type = EQueryType::Occlusion;
+    u32 query_count = 0;
+    const char *debug_name = nullptr;
+  };
+
+  // One pipeline statistics query. Headless builds only count compute invocations, the graphics counters stay 0.
+  struct PipelineStatistics
+  {
+    u64 input_assembly_vertices = 0;
+    u64 input_assembly_primitives = 0;
+    u64 vertex_shader_invocations = 0;
+    u64 clipping_invocations = 0;
+    u64 clipping_primitives = 0;
+    u64 fragment_shader_invocations = 0;
+    u64 compute_shader_invocations = 0;
+  };
+
   struct BindingLayoutEntry
   {
     u32 binding = 0;
@@ -119,6 +305,18 @@ namespace ia::gpu
     bool skip_update = {};
   };
 
+  // One descriptor of a table written as a whole by write_descriptor_table. Only the members matching the binding's
+  // type are read.
+  struct DescriptorSlot
+  {
+    Buffer buffer = {};
+    u64 buffer_offset = 0;
+    u64 buffer_range = 0; // 0 = whole buffer
+
+    Texture texture = {};
+    Sampler sampler = {}; // null = default sampler
+  };
+
   struct TextureBarrier
   {
     Texture texture = {};
@@ -255,6 +453,8 @@ namespace ia::gpu
     u32 depth = 1;
   };
 
+  // With no layouts, the binding layouts are derived from the shaders' SPIR-V, and with a push constant size of 0 so is
+  // the push constant range. Pipelines with the same interface share their layouts either way.
   struct GraphicsPipelineDesc
   {
     Shader vertex_shader;
@@ -377,18 +577,27 @@ namespace ia::gpu
     }
   };
 
+  // See GraphicsPipelineDesc for how empty layouts and push constants are filled in.
   struct ComputePipelineDesc
   {
     Shader compute_shader = {};
     BindingLayout *layouts = nullptr;
     u32 layout_count = 0;
 
+    u8 push_constant_size = 0;
+
     ComputePipelineDesc &set_shader(Shader cs)
     {
       compute_shader = cs;
       return *this;
     }
 
+    ComputePipelineDesc &set_push_constants(u8 size)
+    {
+      push_constant_size = size;
+      return *this;
+    }
+
     ComputePipelineDesc &set_layouts(BindingLayout *ptr, u32 count)
     {
       layouts = ptr;
@@ -401,4 +610,25 @@ namespace ia::gpu
       return set_layouts(ptr, 1);
     }
   };
+
+  struct LoadedPipeline
+  {
+    Pipeline pipeline = {};
+    Vec<BindingLayout> layouts; // one per descriptor set, owned by the archive
+  };
+
+  // Everything created from a baked pipeline archive. Pipelines are keyed by the name the baker gave them,
+  // "<pipeline>[MACRO=value,...]" for permutations.
+  struct LoadedPipelineArchive
+  {
+    Vec<Shader> shaders;
+    Vec<BindingLayout> binding_layouts;
+    HashMap<std::string, LoadedPipeline> pipelines;
+
+    const LoadedPipeline *find_pipeline(const std::string &name) const
+    {
+      const auto it = pipelines.find(name);
+      return it == pipelines.end() ? nullptr : &it->second;
+    }
+  };
 } // namespace ia::gpu
\ No newline at end of file
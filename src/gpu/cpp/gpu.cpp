@@ -15,6 +15,61 @@
 
 #include <gpu/gpu.hpp>
 
+#include <format>
+
 namespace ia::gpu
 {
+  static auto append_json_string(MutRef<std::string> out, const char *value) -> void
+  {
+    out.push_back('"');
+    for (Mut<const char *> c = value ? value : ""; *c; c++)
+    {
+      switch (*c)
+      {
+      case '"':
+        out.append("\\\"");
+        break;
+      case '\\':
+        out.append("\\\\");
+        break;
+      case '\n':
+        out.append("\\n");
+        break;
+      case '\t':
+        out.append("\\t");
+        break;
+      default:
+        if ((u8) *c < 0x20)
+          out.append(std::format("\\u{:04x}", (u32) (u8) *c));
+        else
+          out.push_back(*c);
+      }
+    }
+    out.push_back('"');
+  }
+
+  auto export_chrome_trace(std::span<const GpuFrameTimings> frames, u32 process_id) -> std::string
+  {
+    Mut<std::string> out = "{\"traceEvents\":[";
+    Mut<bool> is_first = true;
+    for (const auto &frame : frames)
+    {
+      for (const auto &scope : frame.scopes)
+      {
+        if (!is_first)
+          out.push_back(',');
+        is_first = false;
+
+        // Trace timestamps are in microseconds, fractional values keep the nanosecond precision.
+        out.append("{\"name\":");
+        append_json_string(out, scope.name);
+        out.append(std::format(",\"cat\":\"gpu\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":{},\"tid\":{},"
+                               "\"args\":{{\"frame\":{},\"depth\":{}}}}}",
+                               (f64) scope.begin_ns / 1000.0, (f64) (scope.end_ns - scope.begin_ns) / 1000.0,
+                               process_id, scope.track, frame.submission_value, scope.depth));
+      }
+    }
+    out.append("]}");
+    return out;
+  }
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mapped_file.hpp>
+
+#include <utility>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace ia::gpu
+{
+  MappedFile::~MappedFile()
+  {
+    close();
+  }
+
+  MappedFile::MappedFile(MappedFile &&other) noexcept
+      : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+#if defined(_WIN32)
+        ,
+        m_file(std::exchange(other.m_file, nullptr)), m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+  {
+  }
+
+  MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+  {
+    if (this != &other)
+    {
+      close();
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+#if defined(_WIN32)
+      m_file = std::exchange(other.m_file, nullptr);
+      m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+  }
+
+#if defined(_WIN32)
+  auto MappedFile::open(const char *path) -> Result<MappedFile>
+  {
+    Mut<MappedFile> result;
+
+    result.m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (result.m_file == INVALID_HANDLE_VALUE)
+    {
+      result.m_file = nullptr;
+      return fail("Failed to open '{}'", path);
+    }
+
+    Mut<LARGE_INTEGER> size{};
+    if (!GetFileSizeEx(result.m_file, &size))
+      return fail("Failed to query the size of '{}'", path);
+    result.m_size = (u64) size.QuadPart;
+    if (result.m_size == 0)
+      return result;
+
+    result.m_mapping = CreateFileMappingA(result.m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!result.m_mapping)
+      return fail("Failed to map '{}'", path);
+
+    result.m_data = MapViewOfFile(result.m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!result.m_data)
+      return fail("Failed to map '{}'", path);
+
+    return result;
+  }
+
+  auto MappedFile::close() -> void
+  {
+    if (m_data)
+      UnmapViewOfFile(m_data);
+    if (m_mapping)
+      CloseHandle(m_mapping);
+    if (m_file)
+      CloseHandle(m_file);
+
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+  }
+#else
+  auto MappedFile::open(const char *path) -> Result<MappedFile>
+  {
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return fail("Failed to open '{}'", path);
+
+    Mut<struct stat> st{};
+    if (fstat(fd, &st) != 0)
+    {
+      ::close(fd);
+      return fail("Failed to query the size of '{}'", path);
+    }
+
+    Mut<MappedFile> result;
+    result.m_size = (u64) st.st_size;
+    if (result.m_size == 0)
+    {
+      ::close(fd);
+      return result;
+    }
+
+    // The descriptor is not needed once the mapping exists.
+    void *data = mmap(nullptr, result.m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+      return fail("Failed to map '{}'", path);
+
+    result.m_data = data;
+    return result;
+  }
+
+  auto MappedFile::close() -> void
+  {
+    if (m_data)
+      munmap(const_cast<void *>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+  }
+#endif
+} // namespace ia::gpu
@@ -0,0 +1,311 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stream_copy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define IAGPU_STREAM_COPY_X64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define IAGPU_STREAM_COPY_ARM64 1
+#include <arm_neon.h>
+#endif
+
+// MSVC compiles every intrinsic without being asked, GCC and Clang need the ISA enabled per function.
+#if defined(__GNUC__) || defined(__clang__)
+#define IAGPU_TARGET(features) __attribute__((target(features)))
+#else
+#define IAGPU_TARGET(features)
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_nontemporal_store)
+#define IAGPU_HAS_NONTEMPORAL_STORE 1
+#endif
+#endif
+
+namespace ia::gpu
+{
+  static constexpr u64 CACHE_LINE_SIZE = 64;
+
+  // Below this the head and tail dominate and a plain copy is as fast.
+  static constexpr u64 MIN_STREAM_COPY_SIZE = 4 * CACHE_LINE_SIZE;
+
+  // Plain-copies up to the first cache line boundary of `dst` and returns how much was copied.
+  static auto copy_head(u8 *dst, const u8 *src, u64 size) -> u64
+  {
+    const u64 head = std::min<u64>((CACHE_LINE_SIZE - (reinterpret_cast<uintptr_t>(dst) & (CACHE_LINE_SIZE - 1))) &
+                                       (CACHE_LINE_SIZE - 1),
+                                   size);
+    memcpy(dst, src, head);
+    return head;
+  }
+
+#if IAGPU_STREAM_COPY_X64
+  struct CpuFeatures
+  {
+    bool avx2{};
+    bool avx512{};
+  };
+
+  static auto cpuid(u32 leaf, u32 subleaf, u32 (&regs)[4]) -> void
+  {
+#if defined(_MSC_VER) && !defined(__clang__)
+    Mut<int> values[4]{};
+    __cpuidex(values, (int) leaf, (int) subleaf);
+    for (Mut<u32> i = 0; i < 4; i++)
+      regs[i] = (u32) values[i];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+  }
+
+  static auto read_xcr0() -> u64
+  {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+#else
+    Mut<u32> low{};
+    Mut<u32> high{};
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((u64) high << 32) | low;
+#endif
+  }
+
+  // The CPU flags alone are not enough, the OS also has to save the wider registers on a context switch.
+  static auto detect_cpu_features() -> CpuFeatures
+  {
+    static constexpr u32 OSXSAVE_BIT = 1u << 27;
+    static constexpr u32 AVX2_BIT = 1u << 5;
+    static constexpr u32 AVX512F_BIT = 1u << 16;
+    static constexpr u64 XCR0_AVX_STATE = 0x6;     // XMM and YMM
+    static constexpr u64 XCR0_AVX512_STATE = 0xE0; // opmask, ZMM0-15 upper halves, ZMM16-31
+
+    Mut<CpuFeatures> features{};
+    Mut<u32> regs[4]{};
+    cpuid(0, 0, regs);
+    const u32 max_leaf = regs[0];
+    if (max_leaf < 7)
+      return features;
+
+    cpuid(1, 0, regs);
+    if (!(regs[2] & OSXSAVE_BIT))
+      return features;
+    const u64 xcr0 = read_xcr0();
+
+    cpuid(7, 0, regs);
+    features.avx2 = (regs[1] & AVX2_BIT) && (xcr0 & XCR0_AVX_STATE) == XCR0_AVX_STATE;
+    features.avx512 = features.avx2 && (regs[1] & AVX512F_BIT) &&
+                      (xcr0 & XCR0_AVX512_STATE) == XCR0_AVX512_STATE;
+    return features;
+  }
+
+  static auto get_cpu_features() -> Ref<CpuFeatures>
+  {
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+  }
+
+  static auto copy_sse2(u8 *dst, const u8 *src, u64 size) -> void
+  {
+    const u64 head = copy_head(dst, src, size);
+    dst += head;
+    src += head;
+    size -= head;
+
+    for (; size >= CACHE_LINE_SIZE; size -= CACHE_LINE_SIZE, dst += CACHE_LINE_SIZE, src += CACHE_LINE_SIZE)
+    {
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+      const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 32));
+      const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 48));
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst), a);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 16), b);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 32), c);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 48), d);
+    }
+
+    memcpy(dst, src, size);
+    _mm_sfence();
+  }
+
+  IAGPU_TARGET("avx2") static auto copy_avx2(u8 *dst, const u8 *src, u64 size) -> void
+  {
+    const u64 head = copy_head(dst, src, size);
+    dst += head;
+    src += head;
+    size -= head;
+
+    for (; size >= CACHE_LINE_SIZE; size -= CACHE_LINE_SIZE, dst += CACHE_LINE_SIZE, src += CACHE_LINE_SIZE)
+    {
+      const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+      const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + 32));
+      _mm256_stream_si256(reinterpret_cast<__m256i *>(dst), a);
+      _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + 32), b);
+    }
+
+    memcpy(dst, src, size);
+    _mm_sfence();
+  }
+
+  IAGPU_TARGET("avx512f") static auto copy_avx512(u8 *dst, const u8 *src, u64 size) -> void
+  {
+    const u64 head = copy_head(dst, src, size);
+    dst += head;
+    src += head;
+    size -= head;
+
+    for (; size >= CACHE_LINE_SIZE; size -= CACHE_LINE_SIZE, dst += CACHE_LINE_SIZE, src += CACHE_LINE_SIZE)
+      _mm512_stream_si512(reinterpret_cast<__m512i *>(dst), _mm512_loadu_si512(src));
+
+    memcpy(dst, src, size);
+    _mm_sfence();
+  }
+#endif
+
+#if IAGPU_STREAM_COPY_ARM64
+  // STNP where the compiler exposes it, plain full-line stores otherwise, which Normal-NC memory merges just as well.
+  static auto copy_neon(u8 *dst, const u8 *src, u64 size) -> void
+  {
+    const u64 head = copy_head(dst, src, size);
+    dst += head;
+    src += head;
+    size -= head;
+
+    for (; size >= CACHE_LINE_SIZE; size -= CACHE_LINE_SIZE, dst += CACHE_LINE_SIZE, src += CACHE_LINE_SIZE)
+    {
+      const uint8x16x4_t line = vld1q_u8_x4(src);
+#if IAGPU_HAS_NONTEMPORAL_STORE
+      __builtin_nontemporal_store(line.val[0], reinterpret_cast<uint8x16_t *>(dst));
+      __builtin_nontemporal_store(line.val[1], reinterpret_cast<uint8x16_t *>(dst + 16));
+      __builtin_nontemporal_store(line.val[2], reinterpret_cast<uint8x16_t *>(dst + 32));
+      __builtin_nontemporal_store(line.val[3], reinterpret_cast<uint8x16_t *>(dst + 48));
+#else
+      vst1q_u8_x4(dst, line);
+#endif
+    }
+
+    memcpy(dst, src, size);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+#endif
+
+  auto is_stream_copy_path_supported(EStreamCopyPath path) -> bool
+  {
+    switch (path)
+    {
+    case EStreamCopyPath::Memcpy:
+      return true;
+#if IAGPU_STREAM_COPY_X64
+    case EStreamCopyPath::Sse2:
+      return true;
+    case EStreamCopyPath::Avx2:
+      return get_cpu_features().avx2;
+    case EStreamCopyPath::Avx512:
+      return get_cpu_features().avx512;
+#endif
+#if IAGPU_STREAM_COPY_ARM64
+    case EStreamCopyPath::Neon:
+      return true;
+#endif
+    default:
+      return false;
+    }
+  }
+
+  auto get_stream_copy_path() -> EStreamCopyPath
+  {
+    static const EStreamCopyPath path = [] {
+      for (const auto candidate : {EStreamCopyPath::Avx512, EStreamCopyPath::Avx2, EStreamCopyPath::Sse2,
+                                   EStreamCopyPath::Neon})
+      {
+        if (is_stream_copy_path_supported(candidate))
+          return candidate;
+      }
+      return EStreamCopyPath::Memcpy;
+    }();
+    return path;
+  }
+
+  auto get_stream_copy_path_name(EStreamCopyPath path) -> const char *
+  {
+    switch (path)
+    {
+    case EStreamCopyPath::Memcpy:
+      return "memcpy";
+    case EStreamCopyPath::Sse2:
+      return "sse2";
+    case EStreamCopyPath::Avx2:
+      return "avx2";
+    case EStreamCopyPath::Avx512:
+      return "avx512";
+    case EStreamCopyPath::Neon:
+      return "neon";
+    }
+    return "unknown";
+  }
+
+  auto stream_copy(void *dst, const void *src, u64 size) -> void
+  {
+    stream_copy(get_stream_copy_path(), dst, src, size);
+  }
+
+  auto stream_copy(EStreamCopyPath path, void *dst, const void *src, u64 size) -> void
+  {
+    assert(is_stream_copy_path_supported(path));
+
+    u8 *const dst_bytes = static_cast<u8 *>(dst);
+    const u8 *const src_bytes = static_cast<const u8 *>(src);
+    if (size < MIN_STREAM_COPY_SIZE)
+    {
+      memcpy(dst_bytes, src_bytes, size);
+      return;
+    }
+
+    switch (path)
+    {
+#if IAGPU_STREAM_COPY_X64
+    case EStreamCopyPath::Sse2:
+      copy_sse2(dst_bytes, src_bytes, size);
+      return;
+    case EStreamCopyPath::Avx2:
+      copy_avx2(dst_bytes, src_bytes, size);
+      return;
+    case EStreamCopyPath::Avx512:
+      copy_avx512(dst_bytes, src_bytes, size);
+      return;
+#endif
+#if IAGPU_STREAM_COPY_ARM64
+    case EStreamCopyPath::Neon:
+      copy_neon(dst_bytes, src_bytes, size);
+      return;
+#endif
+    default:
+      memcpy(dst_bytes, src_bytes, size);
+      return;
+    }
+  }
+} // namespace ia::gpu
@@ -0,0 +1,238 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/bindless_heap.hpp>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  auto BindlessHeap::IndexAllocator::allocate() -> u32
+  {
+    if (!free_indices.empty())
+    {
+      const u32 index = free_indices.back();
+      free_indices.pop_back();
+      return index;
+    }
+    return next_index < capacity ? next_index++ : BINDLESS_INVALID_INDEX;
+  }
+
+  auto BindlessHeap::IndexAllocator::release(u32 index) -> void
+  {
+    if (index != BINDLESS_INVALID_INDEX)
+      free_indices.push_back(index);
+  }
+
+  auto BindlessHeap::initialize(VkDevice device, VkPhysicalDevice physical_device, u32 resource_capacity,
+                                u32 sampler_capacity) -> Result<void>
+  {
+    m_device = device;
+
+    Mut<VkPhysicalDeviceVulkan12Properties> vulkan12_properties{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES,
+    };
+    Mut<VkPhysicalDeviceProperties2> properties{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+        .pNext = &vulkan12_properties,
+    };
+    vkGetPhysicalDeviceProperties2(physical_device, &properties);
+
+    const auto &limits = vulkan12_properties;
+    m_textures.capacity = std::min({resource_capacity, limits.maxDescriptorSetUpdateAfterBindSampledImages,
+                                    limits.maxDescriptorSetUpdateAfterBindStorageImages,
+                                    limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                    limits.maxPerStageDescriptorUpdateAfterBindStorageImages});
+    m_buffers.capacity = std::min({resource_capacity, limits.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                   limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers});
+    m_samplers.capacity = std::min({sampler_capacity, limits.maxDescriptorSetUpdateAfterBindSamplers,
+                                    limits.maxPerStageDescriptorUpdateAfterBindSamplers});
+
+    const VkDescriptorSetLayoutBinding bindings[] = {
+        {SAMPLED_IMAGE_BINDING, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, m_textures.capacity, VK_SHADER_STAGE_ALL, nullptr},
+        {STORAGE_IMAGE_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, m_textures.capacity, VK_SHADER_STAGE_ALL, nullptr},
+        {STORAGE_BUFFER_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_buffers.capacity, VK_SHADER_STAGE_ALL, nullptr},
+        {SAMPLER_BINDING, VK_DESCRIPTOR_TYPE_SAMPLER, m_samplers.capacity, VK_SHADER_STAGE_ALL, nullptr},
+    };
+
+    // Slots are written while the set is bound by frames in flight and most of them stay empty.
+    const VkDescriptorBindingFlags binding_flags[] = {
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
+    };
+    const VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_create_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .bindingCount = 4,
+        .pBindingFlags = binding_flags,
+    };
+    const VkDescriptorSetLayoutCreateInfo layout_create_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = &binding_flags_create_info,
+        .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+        .bindingCount = 4,
+        .pBindings = bindings,
+    };
+    VK_CALL(vkCreateDescriptorSetLayout(m_device, &layout_create_info, nullptr, &m_layout),
+            "Creating bindless descriptor set layout");
+
+    const VkDescriptorPoolSize pool_sizes[] = {
+        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, m_textures.capacity},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, m_textures.capacity},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_buffers.capacity},
+        {VK_DESCRIPTOR_TYPE_SAMPLER, m_samplers.capacity},
+    };
+    const VkDescriptorPoolCreateInfo pool_create_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        .maxSets = 1,
+        .poolSizeCount = 4,
+        .pPoolSizes = pool_sizes,
+    };
+    VK_CALL(vkCreateDescriptorPool(m_device, &pool_create_info, nullptr, &m_pool), "Creating bindless descriptor pool");
+
+    const VkDescriptorSetAllocateInfo allocate_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool = m_pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &m_layout,
+    };
+    VK_CALL(vkAllocateDescriptorSets(m_device, &allocate_info, &m_set), "Allocating bindless descriptor set");
+
+    return {};
+  }
+
+  auto BindlessHeap::destroy() -> void
+  {
+    if (m_device == VK_NULL_HANDLE)
+      return;
+
+    vkDestroyDescriptorPool(m_device, m_pool, nullptr);
+    vkDestroyDescriptorSetLayout(m_device, m_layout, nullptr);
+    m_pool = VK_NULL_HANDLE;
+    m_layout = VK_NULL_HANDLE;
+    m_set = VK_NULL_HANDLE;
+  }
+
+  auto BindlessHeap::add_texture(VkImageView view, bool is_sampled, bool is_storage) -> u32
+  {
+    const u32 index = m_textures.allocate();
+    if IA_B_UNLIKELY (index == BINDLESS_INVALID_INDEX)
+      return index;
+
+    const VkDescriptorImageInfo sampled_info{
+        .imageView = view,
+        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    };
+    const VkDescriptorImageInfo storage_info{
+        .imageView = view,
+        .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
+    };
+
+    Mut<VkWriteDescriptorSet> writes[2];
+    Mut<u32> write_count = 0;
+    if (is_sampled)
+    {
+      writes[write_count++] = {
+          .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+          .dstSet = m_set,
+          .dstBinding = SAMPLED_IMAGE_BINDING,
+          .dstArrayElement = index,
+          .descriptorCount = 1,
+          .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+          .pImageInfo = &sampled_info,
+      };
+    }
+    if (is_storage)
+    {
+      writes[write_count++] = {
+          .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+          .dstSet = m_set,
+          .dstBinding = STORAGE_IMAGE_BINDING,
+          .dstArrayElement = index,
+          .descriptorCount = 1,
+          .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+          .pImageInfo = &storage_info,
+      };
+    }
+    vkUpdateDescriptorSets(m_device, write_count, writes, 0, nullptr);
+
+    return index;
+  }
+
+  auto BindlessHeap::add_buffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) -> u32
+  {
+    const u32 index = m_buffers.allocate();
+    if IA_B_UNLIKELY (index == BINDLESS_INVALID_INDEX)
+      return index;
+
+    const VkDescriptorBufferInfo buffer_info{
+        .buffer = buffer,
+        .offset = offset,
+        .range = range,
+    };
+    const VkWriteDescriptorSet write{
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = m_set,
+        .dstBinding = STORAGE_BUFFER_BINDING,
+        .dstArrayElement = index,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .pBufferInfo = &buffer_info,
+    };
+    vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+
+    return index;
+  }
+
+  auto BindlessHeap::add_sampler(VkSampler sampler) -> u32
+  {
+    const u32 index = m_samplers.allocate();
+    if IA_B_UNLIKELY (index == BINDLESS_INVALID_INDEX)
+      return index;
+
+    const VkDescriptorImageInfo sampler_info{
+        .sampler = sampler,
+    };
+    const VkWriteDescriptorSet write{
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = m_set,
+        .dstBinding = SAMPLER_BINDING,
+        .dstArrayElement = index,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+        .pImageInfo = &sampler_info,
+    };
+    vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+
+    return index;
+  }
+
+  auto BindlessHeap::remove_texture(u32 index) -> void
+  {
+    m_textures.release(index);
+  }
+
+  auto BindlessHeap::remove_buffer(u32 index) -> void
+  {
+    m_buffers.release(index);
+  }
+
+  auto BindlessHeap::remove_sampler(u32 index) -> void
+  {
+    m_samplers.release(index);
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,165 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/buffer_pool.hpp>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  auto BufferPool::initialize(VmaAllocator allocator, VkPhysicalDevice physical_device, u64 page_size) -> void
+  {
+    m_allocator = allocator;
+    m_page_size = page_size;
+
+    Mut<VkPhysicalDeviceProperties> properties{};
+    vkGetPhysicalDeviceProperties(physical_device, &properties);
+    m_limits = properties.limits;
+  }
+
+  auto BufferPool::destroy() -> void
+  {
+    for (Mut<u32> i = 0; i < m_pages.size(); i++)
+    {
+      if (m_pages[i].buffer)
+        destroy_page(i);
+    }
+    m_pages.clear();
+    m_free_pages.clear();
+    m_classes.clear();
+  }
+
+  auto BufferPool::get_alignment(Ref<VkBufferCreateInfo> buffer_create_info, bool host_visible) const -> u64
+  {
+    // 16 covers index, indirect and predicate offsets, flushes of non-coherent memory work in whole atoms.
+    Mut<u64> alignment = 16;
+    if (buffer_create_info.usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+      alignment = std::max<u64>(alignment, m_limits.minUniformBufferOffsetAlignment);
+    if (buffer_create_info.usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+      alignment = std::max<u64>(alignment, m_limits.minStorageBufferOffsetAlignment);
+    if (host_visible)
+      alignment = std::max<u64>(alignment, m_limits.nonCoherentAtomSize);
+    return alignment;
+  }
+
+  auto BufferPool::allocate(u64 size, Ref<VkBufferCreateInfo> buffer_create_info,
+                            Ref<VmaAllocationCreateInfo> allocation_create_info) -> Result<Suballocation>
+  {
+    const bool host_visible = (allocation_create_info.flags & VMA_ALLOCATION_CREATE_MAPPED_BIT) != 0;
+    const bool host_write_only =
+        (allocation_create_info.flags & VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT) != 0;
+    const u64 class_key =
+        ((u64) buffer_create_info.usage << 2) | (host_write_only ? 2 : 0) | (host_visible ? 1 : 0);
+    const VmaVirtualAllocationCreateInfo virtual_create_info{
+        .size = size,
+        .alignment = get_alignment(buffer_create_info, host_visible),
+    };
+
+    Mut<u32> page_index = INVALID_PAGE;
+    Mut<VmaVirtualAllocation> virtual_allocation{};
+    Mut<VkDeviceSize> offset{};
+
+    MutRef<Vec<u32>> pages = m_classes[class_key];
+    for (const u32 candidate : pages)
+    {
+      if (vmaVirtualAllocate(m_pages[candidate].block, &virtual_create_info, &virtual_allocation, &offset) ==
+          VK_SUCCESS)
+      {
+        page_index = candidate;
+        break;
+      }
+    }
+
+    if (page_index == INVALID_PAGE)
+    {
+      page_index = AU_TRY(create_page(class_key, buffer_create_info, allocation_create_info));
+      pages.push_back(page_index);
+      VK_CALL(vmaVirtualAllocate(m_pages[page_index].block, &virtual_create_info, &virtual_allocation, &offset),
+              "Suballocating pooled buffer");
+    }
+
+    Ref<Page> page = m_pages[page_index];
+    return Suballocation{
+        .buffer = page.buffer,
+        .allocation = page.allocation,
+        .mapped = page.mapped ? page.mapped + offset : nullptr,
+        .offset = offset,
+        .page = page_index,
+        .virtual_allocation = virtual_allocation,
+    };
+  }
+
+  auto BufferPool::free(u32 page, VmaVirtualAllocation virtual_allocation) -> void
+  {
+    MutRef<Page> impl = m_pages[page];
+    vmaVirtualFree(impl.block, virtual_allocation);
+    if (!vmaIsVirtualBlockEmpty(impl.block))
+      return;
+
+    MutRef<Vec<u32>> pages = m_classes[impl.class_key];
+    if (pages.size() <= 1)
+      return;
+
+    std::erase(pages, page);
+    destroy_page(page);
+    m_free_pages.push_back(page);
+  }
+
+  auto BufferPool::create_page(u64 class_key, Ref<VkBufferCreateInfo> buffer_create_info,
+                               Ref<VmaAllocationCreateInfo> allocation_create_info) -> Result<u32>
+  {
+    Mut<VkBufferCreateInfo> page_create_info = buffer_create_info;
+    page_create_info.size = m_page_size;
+
+    Mut<Page> page{};
+    page.class_key = class_key;
+
+    Mut<VmaAllocationInfo> allocation_info{};
+    VK_CALL(vmaCreateBuffer(m_allocator, &page_create_info, &allocation_create_info, &page.buffer, &page.allocation,
+                            &allocation_info),
+            "Creating buffer pool page");
+    page.mapped = static_cast<u8 *>(allocation_info.pMappedData);
+
+    const VmaVirtualBlockCreateInfo block_create_info{
+        .size = m_page_size,
+    };
+    const VkResult block_result = vmaCreateVirtualBlock(&block_create_info, &page.block);
+    if IA_B_UNLIKELY (block_result != VK_SUCCESS)
+    {
+      vmaDestroyBuffer(m_allocator, page.buffer, page.allocation);
+      return fail("'Creating buffer pool block' failed with code {}", (i64) block_result);
+    }
+
+    if (!m_free_pages.empty())
+    {
+      const u32 index = m_free_pages.back();
+      m_free_pages.pop_back();
+      m_pages[index] = page;
+      return index;
+    }
+
+    m_pages.push_back(page);
+    return (u32) (m_pages.size() - 1);
+  }
+
+  auto BufferPool::destroy_page(u32 page) -> void
+  {
+    MutRef<Page> impl = m_pages[page];
+    vmaClearVirtualBlock(impl.block);
+    vmaDestroyVirtualBlock(impl.block);
+    vmaDestroyBuffer(m_allocator, impl.buffer, impl.allocation);
+    impl = {};
+  }
+} // namespace ia::gpu::vulkan
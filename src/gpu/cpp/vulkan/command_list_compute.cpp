@@ -13,8 +13,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <vulkan/device.hpp>
+#include <vulkan/command_list.hpp>
 
 namespace ia::gpu::vulkan
 {
-}
\ No newline at end of file
+  void CommandList::begin_compute()
+  {
+    flush_transitions();
+  }
+
+  void CommandList::end_compute()
+  {
+  }
+
+  void CommandList::dispatch(u32 x, u32 y, u32 z)
+  {
+    vkCmdDispatch(m_handle, x, y, z);
+    IAGPU_COUNT(m_counters.dispatches, 1);
+  }
+} // namespace ia::gpu::vulkan
@@ -13,8 +13,648 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <vulkan/device.hpp>
+#include <vulkan/command_list.hpp>
+#include <vulkan/gpu_profiler.hpp>
+
+#include <algorithm>
+#include <functional>
 
 namespace ia::gpu::vulkan
 {
-}
\ No newline at end of file
+  struct StateSync
+  {
+    VkPipelineStageFlags2 stages;
+    VkAccessFlags2 access;
+  };
+
+  // Graphics stages are not valid on a compute-only queue: headless builds only ever record on one, graphics builds
+  // do for the async compute lists when their family has no graphics support.
+  static constexpr VkPipelineStageFlags2 COMPUTE_SHADER_STAGES = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  static constexpr VkPipelineStageFlags2 COMPUTE_READ_STAGES =
+      COMPUTE_SHADER_STAGES | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+  static constexpr VkAccessFlags2 COMPUTE_READ_ACCESS =
+      VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_UNIFORM_READ_BIT | VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+
+#if IAGPU_DISABLE_GRAPHICS
+  static constexpr VkPipelineStageFlags2 SHADER_STAGES = COMPUTE_SHADER_STAGES;
+  static constexpr VkPipelineStageFlags2 READ_STAGES = COMPUTE_READ_STAGES;
+  static constexpr VkAccessFlags2 READ_ACCESS = COMPUTE_READ_ACCESS;
+  static constexpr VkPipelineStageFlags2 UNDEFINED_STAGES = VK_PIPELINE_STAGE_2_NONE;
+#else
+  static constexpr VkPipelineStageFlags2 SHADER_STAGES = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+                                                         VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                                                         VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  static constexpr VkPipelineStageFlags2 READ_STAGES =
+      SHADER_STAGES | VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+  static constexpr VkAccessFlags2 READ_ACCESS = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_UNIFORM_READ_BIT |
+                                                VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+                                                VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT;
+  // An undefined image may be a freshly acquired swapchain image, whose acquire semaphore is waited on at color
+  // attachment output. The layout transition has to chain after that wait.
+  static constexpr VkPipelineStageFlags2 UNDEFINED_STAGES = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+#endif
+
+  // Stages and accesses a resource in `state` is used with. `is_source` selects the side of the barrier, which only
+  // matters for Present: as a source it chains with the acquire wait, as a destination the submit's semaphore signal
+  // already covers the presentation engine. On a compute-only queue the graphics states can only have been reached on
+  // another queue, whose work the submission's semaphore wait already orders.
+  static auto get_state_sync(EResourceState state, bool is_source, bool is_compute_only) -> StateSync
+  {
+    if (is_compute_only)
+    {
+      switch (state)
+      {
+      case EResourceState::Undefined:
+        return {VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE};
+      case EResourceState::GeneralRead:
+        return {COMPUTE_READ_STAGES, COMPUTE_READ_ACCESS};
+      case EResourceState::GeneralWrite:
+        return {COMPUTE_SHADER_STAGES, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT};
+      case EResourceState::ColorTarget:
+      case EResourceState::DepthTarget:
+      case EResourceState::Present:
+        return {is_source ? VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE};
+      default:
+        break;
+      }
+    }
+
+    switch (state)
+    {
+    case EResourceState::Undefined:
+      return {UNDEFINED_STAGES, VK_ACCESS_2_NONE};
+
+    case EResourceState::TransferSrc:
+      return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT};
+
+    case EResourceState::TransferDst:
+      return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT};
+
+    case EResourceState::GeneralRead:
+      return {READ_STAGES, READ_ACCESS};
+
+    case EResourceState::GeneralWrite:
+      return {SHADER_STAGES, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT};
+
+    case EResourceState::ColorTarget:
+      return {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+              VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT};
+
+    case EResourceState::DepthTarget:
+      return {VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+              VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT};
+
+    case EResourceState::Present:
+      return {is_source ? VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT : VK_PIPELINE_STAGE_2_NONE,
+              VK_ACCESS_2_NONE};
+
+    case EResourceState::Predicate:
+      return {VK_PIPELINE_STAGE_2_CONDITIONAL_RENDERING_BIT_EXT, VK_ACCESS_2_CONDITIONAL_RENDERING_READ_BIT_EXT};
+    }
+
+    return {VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT};
+  }
+
+  // First use of aliased memory: whatever the previous resource in that memory did has to finish, and its writes must
+  // not land after ours. Compute-only queues name their own stages, the graphics ones are not theirs to wait on.
+  static auto get_alias_sync(bool is_compute_only) -> StateSync
+  {
+    if (is_compute_only)
+      return {COMPUTE_SHADER_STAGES | VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_MEMORY_WRITE_BIT};
+    return {VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_WRITE_BIT};
+  }
+
+  // A transition into the state the resource is already in only needs a barrier when that state writes, successive
+  // writes (e.g. two dispatches on the same storage buffer) still have to be ordered.
+  static auto is_redundant_transition(EResourceState old_state, EResourceState new_state, bool discard) -> bool
+  {
+    if (old_state != new_state || discard)
+      return false;
+
+    switch (new_state)
+    {
+    case EResourceState::TransferDst:
+    case EResourceState::GeneralWrite:
+    case EResourceState::ColorTarget:
+    case EResourceState::DepthTarget:
+      return false;
+    default:
+      return true;
+    }
+  }
+
+  void CommandList::bind_pipeline(Pipeline pipeline)
+  {
+    m_bound_pipeline = m_resources->pipelines.get(pipeline);
+    vkCmdBindPipeline(m_handle, m_bound_pipeline->bind_point, m_bound_pipeline->handle);
+    IAGPU_COUNT(m_counters.pipeline_binds, 1);
+  }
+
+  void CommandList::bind_descriptor_table(u32 index, DescriptorTable table)
+  {
+    assert(m_bound_pipeline && "bind_pipeline must be called before bind_descriptor_table");
+
+    const auto set = m_resources->descriptor_tables.get(table)->handle;
+    vkCmdBindDescriptorSets(m_handle, m_bound_pipeline->bind_point, m_bound_pipeline->layout, index, 1, &set, 0,
+                            nullptr);
+    IAGPU_COUNT(m_counters.descriptor_binds, 1);
+  }
+
+  void CommandList::bind_bindless_heap(u32 index)
+  {
+    assert(m_bound_pipeline && "bind_pipeline must be called before bind_bindless_heap");
+    assert(m_resources->bindless_set && "bind_bindless_heap requires ContextConfig::bindless_enabled");
+
+    vkCmdBindDescriptorSets(m_handle, m_bound_pipeline->bind_point, m_bound_pipeline->layout, index, 1,
+                            &m_resources->bindless_set, 0, nullptr);
+    IAGPU_COUNT(m_counters.descriptor_binds, 1);
+  }
+
+  void CommandList::push_constants(EShaderStage stage, u32 offset, u32 size, const void *data)
+  {
+    assert(m_bound_pipeline && "bind_pipeline must be called before push_constants");
+
+    vkCmdPushConstants(m_handle, m_bound_pipeline->layout, map_shader_stages(stage), offset, size, data);
+  }
+
+  void CommandList::transition_buffer(Buffer buffer, EResourceState state)
+  {
+    MutRef<BufferImpl> impl = *m_resources->buffers.get(buffer);
+
+    push_buffer_transition(impl, impl.current_state, state);
+    impl.current_state = state;
+  }
+
+  void CommandList::transition_texture(Texture texture, EResourceState state)
+  {
+    transition_texture(texture, state, 0, 0, 0, 0);
+  }
+
+  void CommandList::transition_texture(Texture texture, EResourceState state, u32 base_mip, u32 mip_count,
+                                       u32 base_layer, u32 layer_count)
+  {
+    record_texture_transition(*m_resources->textures.get(texture), state, base_mip, mip_count, base_layer,
+                              layer_count, false);
+  }
+
+  void CommandList::flush_transitions()
+  {
+    if (m_pending_buffer_transitions.empty() && m_pending_texture_transitions.empty())
+      return;
+
+    m_buffer_barriers.clear();
+    for (const auto &transition : m_pending_buffer_transitions)
+    {
+      if (!transition.alias && is_redundant_transition(transition.old_state, transition.new_state, false))
+        continue;
+
+      const auto src = transition.alias ? get_alias_sync(m_is_compute_only)
+                                        : get_state_sync(transition.old_state, true, m_is_compute_only);
+      const auto dst = get_state_sync(transition.new_state, false, m_is_compute_only);
+      m_buffer_barriers.push_back({
+          .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+          .srcStageMask = src.stages,
+          .srcAccessMask = src.access,
+          .dstStageMask = dst.stages,
+          .dstAccessMask = dst.access,
+          .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+          .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+          .buffer = transition.buffer,
+          .offset = transition.offset,
+          .size = transition.size,
+      });
+    }
+
+    build_texture_barriers();
+
+    m_pending_buffer_transitions.clear();
+    m_pending_texture_transitions.clear();
+
+    if (m_buffer_barriers.empty() && m_image_barriers.empty())
+      return;
+
+    const VkDependencyInfo dependency_info{
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .bufferMemoryBarrierCount = (u32) m_buffer_barriers.size(),
+        .pBufferMemoryBarriers = m_buffer_barriers.data(),
+        .imageMemoryBarrierCount = (u32) m_image_barriers.size(),
+        .pImageMemoryBarriers = m_image_barriers.data(),
+    };
+    vkCmdPipelineBarrier2(m_handle, &dependency_info);
+    IAGPU_COUNT(m_counters.barriers, m_buffer_barriers.size() + m_image_barriers.size());
+    IAGPU_COUNT(m_counters.barrier_batches, 1);
+  }
+
+  void CommandList::pipeline_barrier(std::span<const BufferBarrier> buf_barriers,
+                                     std::span<const TextureBarrier> tex_barriers)
+  {
+    for (const auto &barrier : buf_barriers)
+    {
+      MutRef<BufferImpl> impl = *m_resources->buffers.get(barrier.buffer);
+
+      push_buffer_transition(impl, barrier.old_state, barrier.new_state);
+      impl.current_state = barrier.new_state;
+    }
+
+    for (const auto &barrier : tex_barriers)
+    {
+      MutRef<TextureImpl> impl = *m_resources->textures.get(barrier.texture);
+
+      const u32 mip_count =
+          barrier.mip_level_count ? barrier.mip_level_count : impl.mip_levels - barrier.base_mip_level;
+      const u32 layer_count =
+          barrier.array_layer_count ? barrier.array_layer_count : impl.array_layer_count - barrier.base_array_layer;
+
+      for (Mut<u32> layer = barrier.base_array_layer; layer < barrier.base_array_layer + layer_count; layer++)
+      {
+        for (Mut<u32> mip = barrier.base_mip_level; mip < barrier.base_mip_level + mip_count; mip++)
+          push_texture_transition(impl, barrier.old_state, barrier.new_state, layer, mip, false);
+      }
+      impl.set_current_state(barrier.new_state, barrier.base_mip_level, mip_count, barrier.base_array_layer,
+                             layer_count);
+    }
+
+    flush_transitions();
+  }
+
+  void CommandList::copy_buffer(Buffer src, Buffer dst, std::span<const BufferCopyRegion> regions)
+  {
+    const auto src_impl = m_resources->buffers.get(src);
+    const auto dst_impl = m_resources->buffers.get(dst);
+
+    Mut<Vec<VkBufferCopy>> copies;
+    copies.reserve(regions.size());
+    for (const auto &region : regions)
+      copies.push_back({
+          .srcOffset = src_impl->offset + region.src_offset,
+          .dstOffset = dst_impl->offset + region.dst_offset,
+          .size = region.size,
+      });
+
+    flush_transitions();
+    vkCmdCopyBuffer(m_handle, src_impl->handle, dst_impl->handle, (u32) copies.size(), copies.data());
+  }
+
+  void CommandList::copy_texture(std::span<const TextureCopyRegion> regions)
+  {
+    for (const auto &region : regions)
+    {
+      transition_texture(region.src_texture, EResourceState::TransferSrc, region.src_mip_level, 1,
+                         region.src_base_array_layer, region.src_layer_count);
+      transition_texture(region.dst_texture, EResourceState::TransferDst, region.dst_mip_level, 1,
+                         region.dst_base_array_layer, region.dst_layer_count);
+    }
+    flush_transitions();
+
+    for (const auto &region : regions)
+    {
+      const auto src = m_resources->textures.get(region.src_texture);
+      const auto dst = m_resources->textures.get(region.dst_texture);
+
+      const VkImageCopy copy{
+          .srcSubresource =
+              {
+                  .aspectMask = get_image_aspect(src->format),
+                  .mipLevel = region.src_mip_level,
+                  .baseArrayLayer = region.src_base_array_layer,
+                  .layerCount = region.src_layer_count,
+              },
+          .srcOffset = {region.src_x, region.src_y, region.src_z},
+          .dstSubresource =
+              {
+                  .aspectMask = get_image_aspect(dst->format),
+                  .mipLevel = region.dst_mip_level,
+                  .baseArrayLayer = region.dst_base_array_layer,
+                  .layerCount = region.dst_layer_count,
+              },
+          .dstOffset = {region.dst_x, region.dst_y, region.dst_z},
+          .extent = {region.width, region.height, region.depth},
+      };
+      vkCmdCopyImage(m_handle, src->handle, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst->handle,
+                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+    }
+  }
+
+  void CommandList::copy_buffer_to_texture(Buffer src, std::span<const BufferTextureCopyRegion> regions)
+  {
+    for (const auto &region : regions)
+      transition_texture(region.texture, EResourceState::TransferDst, region.mip_level, 1, region.base_array_layer,
+                         region.layer_count);
+    flush_transitions();
+
+    const auto src_impl = m_resources->buffers.get(src);
+    for (const auto &region : regions)
+    {
+      const auto dst = m_resources->textures.get(region.texture);
+
+      const VkBufferImageCopy copy{
+          .bufferOffset = src_impl->offset + region.buffer_offset,
+          .bufferRowLength = region.buffer_row_length,
+          .bufferImageHeight = region.buffer_image_height,
+          .imageSubresource =
+              {
+                  .aspectMask = get_image_aspect(dst->format),
+                  .mipLevel = region.mip_level,
+                  .baseArrayLayer = region.base_array_layer,
+                  .layerCount = region.layer_count,
+              },
+          .imageOffset = {region.texture_x, region.texture_y, region.texture_z},
+          .imageExtent = {region.width, region.height, region.depth},
+      };
+      vkCmdCopyBufferToImage(m_handle, src_impl->handle, dst->handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+                             &copy);
+    }
+  }
+
+  void CommandList::copy_texture_to_buffer(Buffer src, std::span<const BufferTextureCopyRegion> regions)
+  {
+    for (const auto &region : regions)
+      transition_texture(region.texture, EResourceState::TransferSrc, region.mip_level, 1, region.base_array_layer,
+                         region.layer_count);
+    flush_transitions();
+
+    const auto dst_impl = m_resources->buffers.get(src);
+    for (const auto &region : regions)
+    {
+      const auto texture = m_resources->textures.get(region.texture);
+
+      const VkBufferImageCopy copy{
+          .bufferOffset = dst_impl->offset + region.buffer_offset,
+          .bufferRowLength = region.buffer_row_length,
+          .bufferImageHeight = region.buffer_image_height,
+          .imageSubresource =
+              {
+                  .aspectMask = get_image_aspect(texture->format),
+                  .mipLevel = region.mip_level,
+                  .baseArrayLayer = region.base_array_layer,
+                  .layerCount = region.layer_count,
+              },
+          .imageOffset = {region.texture_x, region.texture_y, region.texture_z},
+          .imageExtent = {region.width, region.height, region.depth},
+      };
+      vkCmdCopyImageToBuffer(m_handle, texture->handle, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_impl->handle, 1,
+                             &copy);
+    }
+  }
+
+  void CommandList::blit_texture(Texture src, EResourceState src_state, Texture dst, EResourceState dst_state,
+                                 std::span<const TextureBlitRegion> regions, bool filter)
+  {
+    const auto src_impl = m_resources->textures.get(src);
+    const auto dst_impl = m_resources->textures.get(dst);
+
+    Mut<Vec<VkImageBlit>> blits;
+    blits.reserve(regions.size());
+    for (const auto &region : regions)
+    {
+      blits.push_back({
+          .srcSubresource =
+              {
+                  .aspectMask = get_image_aspect(src_impl->format),
+                  .mipLevel = region.src_mip_level,
+                  .baseArrayLayer = region.src_base_array_layer,
+                  .layerCount = region.src_layer_count,
+              },
+          .srcOffsets = {{region.src_x, region.src_y, region.src_z},
+                         {region.src_x + (i32) region.src_width, region.src_y + (i32) region.src_height,
+                          region.src_z + (i32) region.src_depth}},
+          .dstSubresource =
+              {
+                  .aspectMask = get_image_aspect(dst_impl->format),
+                  .mipLevel = region.dst_mip_level,
+                  .baseArrayLayer = region.dst_base_array_layer,
+                  .layerCount = region.dst_layer_count,
+              },
+          .dstOffsets = {{region.dst_x, region.dst_y, region.dst_z},
+                         {region.dst_x + (i32) region.dst_width, region.dst_y + (i32) region.dst_height,
+                          region.dst_z + (i32) region.dst_depth}},
+      });
+    }
+
+    flush_transitions();
+    vkCmdBlitImage(m_handle, src_impl->handle, map_image_layout(src_state), dst_impl->handle,
+                   map_image_layout(dst_state), (u32) blits.size(), blits.data(),
+                   filter ? VK_FILTER_LINEAR : VK_FILTER_NEAREST);
+  }
+
+  void CommandList::reset_queries(QueryPool pool, u32 first, u32 count)
+  {
+    vkCmdResetQueryPool(m_handle, m_resources->query_pools.get(pool)->handle, first, count);
+  }
+
+  void CommandList::begin_query(QueryPool pool, u32 index)
+  {
+    vkCmdBeginQuery(m_handle, m_resources->query_pools.get(pool)->handle, index, 0);
+  }
+
+  void CommandList::end_query(QueryPool pool, u32 index)
+  {
+    vkCmdEndQuery(m_handle, m_resources->query_pools.get(pool)->handle, index);
+  }
+
+  void CommandList::copy_query_results(QueryPool pool, u32 first, u32 count, Buffer dst, u64 offset)
+  {
+    const auto impl = m_resources->query_pools.get(pool);
+    const u32 value_count = impl->type == EQueryType::PipelineStatistics ? PIPELINE_STATISTICS_VALUE_COUNT : 1;
+
+    transition_buffer(dst, EResourceState::TransferDst);
+    flush_transitions();
+
+    // 32-bit values are the layout conditional rendering reads. WAIT makes the copy wait for the queries on the GPU.
+    const auto dst_impl = m_resources->buffers.get(dst);
+    vkCmdCopyQueryPoolResults(m_handle, impl->handle, first, count, dst_impl->handle, dst_impl->offset + offset,
+                              value_count * sizeof(u32), VK_QUERY_RESULT_WAIT_BIT);
+  }
+
+  void CommandList::begin_conditional_rendering(Buffer buffer, u64 offset, bool inverted)
+  {
+    if (!m_resources->conditional_rendering_enabled)
+      return;
+
+    transition_buffer(buffer, EResourceState::Predicate);
+    flush_transitions();
+
+    const auto impl = m_resources->buffers.get(buffer);
+    const VkConditionalRenderingBeginInfoEXT begin_info{
+        .sType = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT,
+        .buffer = impl->handle,
+        .offset = impl->offset + offset,
+        .flags = inverted ? (VkConditionalRenderingFlagsEXT) VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT : 0u,
+    };
+    vkCmdBeginConditionalRenderingEXT(m_handle, &begin_info);
+  }
+
+  void CommandList::end_conditional_rendering()
+  {
+    if (m_resources->conditional_rendering_enabled)
+      vkCmdEndConditionalRenderingEXT(m_handle);
+  }
+
+  void CommandList::begin_gpu_scope(const char *name)
+  {
+    if (!m_profiler)
+      return;
+
+    const u32 parent = m_gpu_scope_stack.empty() ? GpuProfiler::INVALID_SCOPE : m_gpu_scope_stack.back();
+    m_gpu_scope_stack.push_back(m_profiler->begin_scope(m_gpu_track, m_handle, parent, name));
+  }
+
+  void CommandList::end_gpu_scope()
+  {
+    if (!m_profiler || m_gpu_scope_stack.empty())
+      return;
+
+    m_profiler->end_scope(m_handle, m_gpu_scope_stack.back());
+    m_gpu_scope_stack.pop_back();
+  }
+
+  auto CommandList::record_texture_transition(MutRef<TextureImpl> texture, EResourceState state, u32 base_mip,
+                                              u32 mip_count, u32 base_layer, u32 layer_count, bool discard) -> void
+  {
+    const u32 actual_mip_count = mip_count ? mip_count : texture.mip_levels - base_mip;
+    const u32 actual_layer_count = layer_count ? layer_count : texture.array_layer_count - base_layer;
+
+    // Subresources may be in different states, they are tracked one by one and merged back into ranges on flush.
+    for (Mut<u32> layer = base_layer; layer < base_layer + actual_layer_count; layer++)
+    {
+      for (Mut<u32> mip = base_mip; mip < base_mip + actual_mip_count; mip++)
+        push_texture_transition(texture, texture.get_current_state(layer, mip), state, layer, mip, discard);
+    }
+
+    texture.set_current_state(state, base_mip, actual_mip_count, base_layer, actual_layer_count);
+  }
+
+  auto CommandList::push_buffer_transition(Ref<BufferImpl> buffer, EResourceState old_state,
+                                           EResourceState new_state) -> void
+  {
+#ifndef NDEBUG
+    m_transitioned_resources.push_back({(u64) buffer.handle, buffer.offset});
+#endif
+
+    // Nothing is recorded between two transitions of the same flush, so A -> B -> C collapses into A -> C.
+    for (auto it = m_pending_buffer_transitions.rbegin(); it != m_pending_buffer_transitions.rend(); ++it)
+    {
+      if (it->buffer != buffer.handle || it->offset != buffer.offset)
+        continue;
+      it->new_state = new_state;
+      return;
+    }
+
+    const bool alias = buffer.is_aliased && old_state == EResourceState::Undefined;
+    m_pending_buffer_transitions.push_back(
+        {buffer.handle, buffer.offset, buffer.get_range(), old_state, new_state, alias});
+  }
+
+  auto CommandList::push_texture_transition(Ref<TextureImpl> texture, EResourceState old_state,
+                                            EResourceState new_state, u32 layer, u32 mip, bool discard) -> void
+  {
+#ifndef NDEBUG
+    m_transitioned_resources.push_back({(u64) texture.handle, UINT64_MAX});
+#endif
+
+    for (auto it = m_pending_texture_transitions.rbegin(); it != m_pending_texture_transitions.rend(); ++it)
+    {
+      if (it->image != texture.handle || it->layer != layer || it->mip != mip)
+        continue;
+      it->new_state = new_state;
+      it->discard |= discard;
+      return;
+    }
+
+    m_pending_texture_transitions.push_back({
+        .image = texture.handle,
+        .aspect = get_image_aspect(texture.format),
+        .layer = layer,
+        .mip = mip,
+        .old_state = old_state,
+        .new_state = new_state,
+        .discard = discard,
+        .alias = texture.is_aliased && old_state == EResourceState::Undefined,
+    });
+  }
+
+  auto CommandList::build_texture_barriers() -> void
+  {
+    m_image_barriers.clear();
+
+    MutRef<Vec<PendingTextureTransition>> pending = m_pending_texture_transitions;
+    std::sort(pending.begin(), pending.end(), [](Ref<PendingTextureTransition> a, Ref<PendingTextureTransition> b) {
+      if (a.image != b.image)
+        return std::less<VkImage>{}(a.image, b.image);
+      if (a.layer != b.layer)
+        return a.layer < b.layer;
+      return a.mip < b.mip;
+    });
+
+    // Barriers of the image currently being merged start at this index, earlier ones belong to other images.
+    Mut<size_t> image_first_barrier = 0;
+
+    Mut<size_t> i = 0;
+    while (i < pending.size())
+    {
+      Ref<PendingTextureTransition> first = pending[i];
+      if (i == 0 || pending[i - 1].image != first.image)
+        image_first_barrier = m_image_barriers.size();
+
+      // Run of consecutive mips in one layer sharing the same transition.
+      Mut<size_t> end = i + 1;
+      while (end < pending.size() && pending[end].image == first.image && pending[end].layer == first.layer &&
+             pending[end].mip == pending[end - 1].mip + 1 && pending[end].old_state == first.old_state &&
+             pending[end].new_state == first.new_state && pending[end].discard == first.discard &&
+             pending[end].alias == first.alias)
+        end++;
+
+      const u32 mip_count = (u32) (end - i);
+      i = end;
+
+      if (!first.alias && is_redundant_transition(first.old_state, first.new_state, first.discard))
+        continue;
+
+      const auto src =
+          first.alias ? get_alias_sync(m_is_compute_only) : get_state_sync(first.old_state, true, m_is_compute_only);
+      const auto dst = get_state_sync(first.new_state, false, m_is_compute_only);
+      const VkImageLayout old_layout = first.discard ? VK_IMAGE_LAYOUT_UNDEFINED : map_image_layout(first.old_state);
+      const VkImageLayout new_layout = map_image_layout(first.new_state);
+
+      // Extend a barrier of the previous layer covering the same mips with the same transition.
+      Mut<bool> merged = false;
+      for (Mut<size_t> b = image_first_barrier; b < m_image_barriers.size(); b++)
+      {
+        MutRef<VkImageMemoryBarrier2> barrier = m_image_barriers[b];
+        MutRef<VkImageSubresourceRange> range = barrier.subresourceRange;
+        if (range.baseArrayLayer + range.layerCount != first.layer || range.baseMipLevel != first.mip ||
+            range.levelCount != mip_count || barrier.oldLayout != old_layout || barrier.newLayout != new_layout ||
+            barrier.srcAccessMask != src.access || barrier.dstAccessMask != dst.access ||
+            barrier.srcStageMask != src.stages || barrier.dstStageMask != dst.stages)
+          continue;
+
+        range.layerCount++;
+        merged = true;
+        break;
+      }
+      if (merged)
+        continue;
+
+      m_image_barriers.push_back({
+          .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+          .srcStageMask = src.stages,
+          .srcAccessMask = src.access,
+          .dstStageMask = dst.stages,
+          .dstAccessMask = dst.access,
+          .oldLayout = old_layout,
+          .newLayout = new_layout,
+          .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+          .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+          .image = first.image,
+          .subresourceRange =
+              {
+                  .aspectMask = first.aspect,
+                  .baseMipLevel = first.mip,
+                  .levelCount = mip_count,
+                  .baseArrayLayer = first.layer,
+                  .layerCount = 1,
+              },
+      });
+    }
+  }
+} // namespace ia::gpu::vulkan
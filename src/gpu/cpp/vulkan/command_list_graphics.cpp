@@ -13,8 +13,143 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <vulkan/device.hpp>
+#include <vulkan/command_list.hpp>
 
 namespace ia::gpu::vulkan
 {
-}
\ No newline at end of file
+  void CommandList::begin_rendering(u32 count, const ColorAttachment *colors, const DepthAttachment *depth)
+  {
+    assert(count <= 8);
+
+    Mut<VkRenderingAttachmentInfo> color_infos[8]{};
+    Mut<VkRenderingAttachmentInfo> depth_info{};
+    Mut<VkExtent3D> extent{};
+
+    for (Mut<u32> i = 0; i < count; i++)
+    {
+      Ref<ColorAttachment> color = colors[i];
+      const auto texture = m_resources->textures.get(color.texture);
+      extent = texture->extent;
+
+      // Nothing to preserve, skip the layout transition's read of the old contents.
+      record_texture_transition(*texture, EResourceState::ColorTarget, 0, 0, 0, 0, color.load_op != ELoadOp::Load);
+
+      color_infos[i] = {
+          .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+          .imageView = texture->view_handle,
+          .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+          .loadOp = map_load_op(color.load_op),
+          .storeOp = map_store_op(color.store_op),
+          .clearValue = {.color = {.float32 = {color.clear_color[0], color.clear_color[1], color.clear_color[2],
+                                               color.clear_color[3]}}},
+      };
+
+      if (color.resolve_target)
+      {
+        transition_texture(color.resolve_target, EResourceState::ColorTarget);
+        color_infos[i].resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
+        color_infos[i].resolveImageView = m_resources->textures.get(color.resolve_target)->view_handle;
+        color_infos[i].resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+      }
+    }
+
+    if (depth)
+    {
+      const auto texture = m_resources->textures.get(depth->texture);
+      extent = texture->extent;
+
+      record_texture_transition(*texture, EResourceState::DepthTarget, 0, 0, 0, 0, depth->load_op != ELoadOp::Load);
+
+      depth_info = {
+          .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+          .imageView = texture->view_handle,
+          .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+          .loadOp = map_load_op(depth->load_op),
+          .storeOp = map_store_op(depth->store_op),
+          .clearValue = {.depthStencil = {.depth = depth->clear_depth, .stencil = 0}},
+      };
+    }
+
+    flush_transitions();
+
+    const VkRenderingInfo rendering_info{
+        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        .renderArea = {.offset = {0, 0}, .extent = {extent.width, extent.height}},
+        .layerCount = 1,
+        .colorAttachmentCount = count,
+        .pColorAttachments = color_infos,
+        .pDepthAttachment = depth ? &depth_info : nullptr,
+    };
+    vkCmdBeginRendering(m_handle, &rendering_info);
+  }
+
+  void CommandList::end_rendering()
+  {
+    vkCmdEndRendering(m_handle);
+  }
+
+  void CommandList::bind_vertex_buffers(u32 first, std::span<const Buffer> buffers, std::span<const u64> offsets)
+  {
+    assert(buffers.size() <= 16 && offsets.size() >= buffers.size());
+
+    Mut<VkBuffer> handles[16];
+    Mut<VkDeviceSize> handle_offsets[16];
+    for (Mut<u32> i = 0; i < buffers.size(); i++)
+    {
+      const auto impl = m_resources->buffers.get(buffers[i]);
+      handles[i] = impl->handle;
+      handle_offsets[i] = impl->offset + offsets[i];
+    }
+
+    vkCmdBindVertexBuffers(m_handle, first, (u32) buffers.size(), handles, handle_offsets);
+  }
+
+  void CommandList::bind_index_buffer(Buffer buffer, u64 offset, bool use_32_bit)
+  {
+    const auto impl = m_resources->buffers.get(buffer);
+    vkCmdBindIndexBuffer(m_handle, impl->handle, impl->offset + offset,
+                         use_32_bit ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16);
+  }
+
+  void CommandList::set_viewport(const Viewport &vp)
+  {
+    const VkViewport viewport{
+        .x = vp.x,
+        .y = vp.y,
+        .width = vp.w,
+        .height = vp.h,
+        .minDepth = vp.min_depth,
+        .maxDepth = vp.max_depth,
+    };
+    vkCmdSetViewport(m_handle, 0, 1, &viewport);
+  }
+
+  void CommandList::set_scissor(const Rect2D &rect)
+  {
+    const VkRect2D scissor{
+        .offset = {rect.x, rect.y},
+        .extent = {rect.w, rect.h},
+    };
+    vkCmdSetScissor(m_handle, 0, 1, &scissor);
+  }
+
+  void CommandList::draw(u32 vertex_count, u32 instance_count, u32 first_vertex, u32 first_instance)
+  {
+    vkCmdDraw(m_handle, vertex_count, instance_count, first_vertex, first_instance);
+    IAGPU_COUNT(m_counters.draws, 1);
+  }
+
+  void CommandList::draw_indexed(u32 index_count, u32 instance_count, u32 first_index, u32 vertex_offset,
+                                 u32 first_instance)
+  {
+    vkCmdDrawIndexed(m_handle, index_count, instance_count, first_index, (i32) vertex_offset, first_instance);
+    IAGPU_COUNT(m_counters.draws, 1);
+  }
+
+  void CommandList::draw_indexed_indirect(Buffer buffer, u64 offset, u32 draw_count, u32 stride)
+  {
+    const auto impl = m_resources->buffers.get(buffer);
+    vkCmdDrawIndexedIndirect(m_handle, impl->handle, impl->offset + offset, draw_count, stride);
+    IAGPU_COUNT(m_counters.draws, draw_count);
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,210 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/context.hpp>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  auto Context::initialize_async_compute(bool enabled) -> Result<void>
+  {
+    AU_TRY_PURE(m_async_compute_timeline.initialize(m_device.get_handle(), "Creating async compute timeline"));
+
+    m_async_compute_queue = get_main_queue();
+    m_async_compute_queue_family = get_main_queue_family();
+    if (enabled && m_device.get_async_compute_queue() == VK_NULL_HANDLE)
+      GPU_LOG_WARN("Async compute was requested, but the device has no spare compute queue");
+    else if (enabled)
+    {
+      m_async_compute_queue = m_device.get_async_compute_queue();
+      m_async_compute_queue_family = m_device.get_async_compute_queue_family();
+      GPU_LOG_INFO("Async compute runs on queue family {}", m_async_compute_queue_family);
+    }
+
+    // A second queue of the main family needs no sharing. Across families, ownership transfers for every resource
+    // used on both queues would have to be tracked, so resources are created concurrent over the families that use
+    // them instead. The transfer family counts too, uploads write subresources whose contents the main queue has to
+    // keep and that would otherwise need a release/acquire pair in each direction.
+    const auto add_shared_family = [&](u32 family) {
+      for (Mut<u32> i = 0; i < m_shared_queue_family_count; i++)
+      {
+        if (m_shared_queue_families[i] == family)
+          return;
+      }
+      m_shared_queue_families[m_shared_queue_family_count++] = family;
+    };
+    const u32 transfer_family = m_device.get_transfer_queue_family();
+    const bool shares_async_compute = m_async_compute_queue_family != get_main_queue_family();
+    const bool shares_transfer =
+        m_device.get_transfer_queue() != VK_NULL_HANDLE && transfer_family != get_main_queue_family();
+    if (shares_async_compute || shares_transfer)
+    {
+      add_shared_family(get_main_queue_family());
+      if (shares_async_compute)
+        add_shared_family(m_async_compute_queue_family);
+      if (shares_transfer)
+        add_shared_family(transfer_family);
+    }
+
+    if (!shares_async_compute)
+      return {};
+
+    // Scopes are only recorded on async lists when their family can write timestamps, and their barriers keep to
+    // compute stages when it has no graphics support.
+    Mut<Vec<VkQueueFamilyProperties>> queue_family_props;
+    VK_ENUM_CALL(vkGetPhysicalDeviceQueueFamilyProperties, queue_family_props, m_device.get_physical_hande());
+    m_async_compute_profiled = queue_family_props[m_async_compute_queue_family].timestampValidBits != 0;
+    m_async_compute_only = (queue_family_props[m_async_compute_queue_family].queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0;
+
+    return {};
+  }
+
+  Context::CmdListType *Context::begin_async_compute_commands()
+  {
+    MutRef<FrameContext> frame = open_frame();
+
+    if IA_B_UNLIKELY (frame.async_compute_command_pool == VK_NULL_HANDLE)
+    {
+      const VkCommandPoolCreateInfo command_pool_create_info{
+          .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+          .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+          .queueFamilyIndex = m_async_compute_queue_family,
+      };
+      if IA_B_UNLIKELY (vkCreateCommandPool(m_device.get_handle(), &command_pool_create_info, nullptr,
+                                            &frame.async_compute_command_pool) != VK_SUCCESS)
+      {
+        GPU_LOG_ERROR("Failed to create the async compute command pool");
+        return nullptr;
+      }
+    }
+
+    if (frame.used_async_compute_cmd_list_count == frame.async_compute_cmd_list_cache.size())
+    {
+      const VkCommandBufferAllocateInfo allocate_info{
+          .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+          .commandPool = frame.async_compute_command_pool,
+          .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+          .commandBufferCount = 1,
+      };
+      Mut<VkCommandBuffer> handle{};
+      if IA_B_UNLIKELY (vkAllocateCommandBuffers(m_device.get_handle(), &allocate_info, &handle) != VK_SUCCESS)
+      {
+        GPU_LOG_ERROR("Failed to allocate an async compute command list");
+        return nullptr;
+      }
+      frame.async_compute_cmd_list_cache.emplace_back(
+          handle, m_resources.get(), m_async_compute_profiled ? m_profiler.get() : nullptr, m_async_compute_only);
+    }
+
+    MutRef<CmdListType> cmd = frame.async_compute_cmd_list_cache[frame.used_async_compute_cmd_list_count++];
+
+    const VkCommandBufferBeginInfo begin_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    vkBeginCommandBuffer(cmd.get_handle(), &begin_info);
+
+    return &cmd;
+  }
+
+  u64 Context::submit_async_compute_commands(CmdListType *cmd, u64 wait_value)
+  {
+    assert(wait_value <= m_main_timeline.get_last_submitted_value() &&
+           "Async compute may only wait for main queue submissions that were already made");
+
+    cmd->flush_transitions();
+    vkEndCommandBuffer(cmd->get_handle());
+    cmd->collect_counters(m_frame_counters);
+    IAGPU_COUNT(m_frame_counters.async_compute_submissions, 1);
+
+    const VkCommandBufferSubmitInfo command_buffer_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+        .commandBuffer = cmd->get_handle(),
+    };
+
+    const VkSemaphoreSubmitInfo wait_info =
+        m_main_timeline.get_wait_info(wait_value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    const u64 value = m_async_compute_timeline.advance();
+    const VkSemaphoreSubmitInfo signal_info =
+        m_async_compute_timeline.get_signal_info(value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    const VkSubmitInfo2 submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+        .waitSemaphoreInfoCount = wait_value ? 1u : 0u,
+        .pWaitSemaphoreInfos = &wait_info,
+        .commandBufferInfoCount = 1,
+        .pCommandBufferInfos = &command_buffer_info,
+        .signalSemaphoreInfoCount = 1,
+        .pSignalSemaphoreInfos = &signal_info,
+    };
+
+    const auto result = vkQueueSubmit2(m_async_compute_queue, 1, &submit_info, VK_NULL_HANDLE);
+    if IA_B_UNLIKELY (result != VK_SUCCESS)
+    {
+      GPU_LOG_ERROR("Async compute submission failed with code {}", (i64) result);
+      return 0;
+    }
+
+    m_readback_ring->submit(cmd->get_handle(), ReadbackRing::EQueue::AsyncCompute, value);
+
+    // The pool of the slot the list was begun in is reset on reuse, which has to wait for this submission as well as
+    // for the frame. The list may be submitted after that frame ended.
+    for (auto &frame : m_frames)
+    {
+      for (Mut<u32> i = 0; i < frame.used_async_compute_cmd_list_count; i++)
+      {
+        if (&frame.async_compute_cmd_list_cache[i] == cmd)
+          frame.async_compute_value = value;
+      }
+    }
+    return value;
+  }
+
+  void Context::add_async_compute_dependency(u64 value)
+  {
+    m_async_compute_dependency = std::max(m_async_compute_dependency, value);
+  }
+
+  u64 Context::get_completed_async_compute_value()
+  {
+    return m_async_compute_timeline.get_completed_value();
+  }
+
+  bool Context::wait_for_async_compute(u64 value, u64 timeout)
+  {
+    return m_async_compute_timeline.wait(value, timeout);
+  }
+
+  bool Context::has_async_compute_family()
+  {
+    return m_async_compute_queue_family != get_main_queue_family();
+  }
+
+  auto Context::get_collectable_release_value() const -> u64
+  {
+    // Async compute submitted during a frame can outlive the frame's own submission, and objects it uses carry that
+    // frame's release value.
+    Mut<u64> value = m_main_timeline.get_completed_value();
+    const u64 async_compute_completed = m_async_compute_timeline.get_completed_value();
+    for (const auto &frame : m_frames)
+    {
+      if (frame.async_compute_value > async_compute_completed && frame.submitted_value)
+        value = std::min(value, frame.submitted_value - 1);
+    }
+    return value;
+  }
+} // namespace ia::gpu::vulkan
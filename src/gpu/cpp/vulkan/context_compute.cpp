@@ -13,8 +13,40 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <vulkan/device.hpp>
+#include <vulkan/context.hpp>
 
 namespace ia::gpu::vulkan
 {
-}
\ No newline at end of file
+  Result<Pipeline> Context::create_compute_pipeline(const ComputePipelineDesc &desc)
+  {
+    return m_resources->pipelines.create(AU_TRY(build_compute_pipeline(desc)));
+  }
+
+  auto Context::build_compute_pipeline(Ref<ComputePipelineDesc> desc) -> Result<PipelineImpl>
+  {
+    const auto shader = m_resources->shaders.get(desc.compute_shader);
+    if (shader->stage_create_info.stage != VK_SHADER_STAGE_COMPUTE_BIT)
+      return fail("create_compute_pipeline requires a compute shader");
+
+    Mut<PipelineImpl> pipeline{
+        .bind_point = VK_PIPELINE_BIND_POINT_COMPUTE,
+    };
+    const std::span<const BindingLayout> layouts(desc.layouts, desc.layout_count);
+    AU_TRY_PURE(resolve_pipeline_layout(std::span(&desc.compute_shader, 1), layouts, desc.push_constant_size,
+                                        EShaderStage::Compute, pipeline));
+
+    const VkComputePipelineCreateInfo pipeline_create_info{
+        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        .stage = shader->stage_create_info,
+        .layout = pipeline.layout,
+    };
+    if IA_B_UNLIKELY (vkCreateComputePipelines(m_device.get_handle(), m_pipeline_cache.get_handle(), 1,
+                                               &pipeline_create_info, nullptr, &pipeline.handle) != VK_SUCCESS)
+    {
+      discard_pipeline_layout(pipeline);
+      return fail("Failed to create compute pipeline");
+    }
+
+    return pipeline;
+  }
+} // namespace ia::gpu::vulkan
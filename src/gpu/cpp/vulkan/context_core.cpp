@@ -14,6 +14,9 @@
 // limitations under the License.
 
 #include <vulkan/context.hpp>
+#include <vulkan/layout_cache.hpp>
+
+#include <algorithm>
 
 namespace ia::gpu::vulkan
 {
@@ -55,7 +58,76 @@ namespace ia::gpu::vulkan
     result.m_surface = surface;
 #endif
 
-    AU_TRY_PURE(result.m_device.boot(result.m_instance, surface, result.m_device_extensions));
+    const DeviceSelection device_selection{
+        .index = config.device_index,
+        .uuid = config.device_uuid,
+        .name = config.device_name,
+    };
+    AU_TRY_PURE(result.m_device.boot(result.m_instance, surface, result.m_device_extensions,
+                                     config.bindless_enabled != 0, config.gpu_profiling_enabled != 0,
+                                     device_selection, config.device_memory_limit));
+    result.m_residency.initialize(result.m_device, config.memory_pressure_threshold);
+    if (config.buffer_pooling_enabled)
+    {
+      result.m_buffer_pool = std::make_unique<BufferPool>();
+      result.m_buffer_pool->initialize(result.m_device.get_allocator(), result.m_device.get_physical_hande(),
+                                       std::max(config.buffer_pool_page_size, config.buffer_pool_max_size));
+    }
+    result.m_resources->conditional_rendering_enabled = result.m_device.is_conditional_rendering_supported();
+    AU_TRY_PURE(result.m_main_timeline.initialize(result.m_device.get_handle(), "Creating main queue timeline"));
+    AU_TRY_PURE(result.m_pipeline_cache.initialize(result.m_device.get_handle(), result.m_device.get_physical_hande(),
+                                                   config.pipeline_cache_path));
+    AU_TRY_PURE(result.m_staging_ring.initialize(result.m_device.get_allocator(), result.m_resources.get(),
+                                                 config.staging_ring_size));
+    AU_TRY_PURE(result.m_descriptor_allocator.initialize(result.m_device.get_handle(), false,
+                                                         config.descriptor_pool_set_count));
+    for (auto &frame : result.m_frames)
+      AU_TRY_PURE(frame.transient_descriptors.initialize(result.m_device.get_handle(), true,
+                                                         config.transient_descriptor_pool_set_count));
+
+    if (result.m_device.is_bindless_enabled())
+    {
+      result.m_bindless_heap = std::make_unique<BindlessHeap>();
+      AU_TRY_PURE(result.m_bindless_heap->initialize(result.m_device.get_handle(),
+                                                     result.m_device.get_physical_hande(),
+                                                     config.bindless_resource_capacity,
+                                                     config.bindless_sampler_capacity));
+      result.m_resources->bindless_set = result.m_bindless_heap->get_set();
+
+      Mut<BindingLayoutImpl> layout{};
+      layout.handle = result.m_bindless_heap->get_layout();
+      result.m_bindless_layout = result.m_resources->binding_layouts.create_internal(std::move(layout));
+    }
+
+    if (result.m_device.is_profiling_enabled())
+    {
+      result.m_profiler = std::make_unique<GpuProfiler>();
+      const auto profiler_init = result.m_profiler->initialize(result.m_device, result.get_main_queue_family(),
+                                                               config.gpu_profiler_max_scopes);
+      if IA_B_UNLIKELY (!profiler_init)
+      {
+        GPU_LOG_WARN("GPU profiling disabled: {}", profiler_init.error());
+        result.m_profiler->destroy();
+        result.m_profiler.reset();
+      }
+    }
+
+    AU_TRY_PURE(result.initialize_async_compute(config.async_compute_enabled != 0));
+
+    result.m_readback_ring = std::make_unique<ReadbackRing>();
+    AU_TRY_PURE(result.m_readback_ring->initialize(
+        result.m_device.get_allocator(), config.readback_ring_size,
+        {result.m_shared_queue_families, result.m_shared_queue_family_count}));
+
+    // Without a dedicated transfer family the uploads go through the main queue, with one resources are shared
+    // concurrently with it, so uploads never transfer ownership either way.
+    const bool has_transfer_queue = result.m_device.get_transfer_queue() != VK_NULL_HANDLE;
+    AU_TRY_PURE(result.m_upload_queue.initialize(
+        result.m_device.get_handle(), result.m_device.get_allocator(), result.m_resources.get(),
+        has_transfer_queue ? result.m_device.get_transfer_queue() : result.get_main_queue(),
+        has_transfer_queue ? result.m_device.get_transfer_queue_family() : result.get_main_queue_family(),
+        result.m_shared_queue_family_count ? VK_QUEUE_FAMILY_IGNORED : result.get_main_queue_family(),
+        result.m_main_timeline.get_semaphore(), config.async_upload_ring_size));
 
 #if !IAGPU_DISABLE_GRAPHICS
     const auto intial_width = 800;
@@ -63,24 +135,15 @@ namespace ia::gpu::vulkan
     AU_TRY_PURE(result.initialize_swapchain(intial_width, intial_height));
 #else
     result.m_swapchain_buffer_count = MAX_PENDING_FRAME_COUNT;
-    const VkFenceCreateInfo fence_create_info{
-        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-        .flags = VK_FENCE_CREATE_SIGNALED_BIT,
-    };
     const VkCommandPoolCreateInfo command_pool_create_info{
         .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
         .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
         .queueFamilyIndex = result.m_device.get_compute_queue_family(),
     };
     for (u32 i = 0; i < MAX_PENDING_FRAME_COUNT; i++)
-    {
-      VK_CALL(
-          vkCreateFence(result.m_device.get_handle(), &fence_create_info, nullptr, &result.m_frames[i].in_flight_fence),
-          "Creating inflight fence");
       VK_CALL(vkCreateCommandPool(result.m_device.get_handle(), &command_pool_create_info, nullptr,
                                   &result.m_frames[i].command_pool),
               "Creating command pool");
-    }
 #endif
 
     {
@@ -99,50 +162,130 @@ namespace ia::gpu::vulkan
               "Creating immediate command pool");
     }
 
-    // [IATODO]
-    //{
-    //  const SamplerDesc desc{
-    //      .linear_filter = true,
-    //      .repeat_uv = true,
-    //      .debug_name = "Default Sampler",
-    //  };
-    //  Mut<Vec<Sampler>> out_samplers = {result.m_default_sampler};
-    //  if (!result.create_samplers(std::initializer_list<const SamplerDesc>{desc}, out_samplers))
-    //    return fail("Failed to create default sampler");
-    //}
+    for (auto &frame : result.m_frames)
+      frame.thread_commands.resize(config.max_recording_threads);
+
+    {
+      const SamplerDesc desc{
+          .linear_filter = true,
+          .repeat_uv = true,
+          .debug_name = "Default Sampler",
+      };
+      if (!result.create_samplers({&desc, 1}, {&result.m_default_sampler, 1}))
+        return fail("Failed to create default sampler");
+    }
 
     return std::move(result);
   }
 
-  Context::Context(Ref<ContextConfig> config) : m_config(config)
-  {
-  }
-
-  // Context::~Context()
-  //{
-  //  [IATODO]
-  //  #if !IAGPU_DISABLE_GRAPHICS
-  //      destroy_swapchain();
-  //      vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
-  //  #else
-  //      for (UINT32 i = 0; i < MAX_PENDING_FRAME_COUNT; i++)
-  //      {
-  //        for (auto &t : m_frames[i].cmdListCache)
-  //          delete t;
-  //        m_frames[i].cmdListCache.clear();
-  //        m_frames[i].usedCmdListCount = 0;
-  //        vkDestroyFence(m_device.GetHandle(), m_frames[i].inFlightFence, nullptr);
-  //        vkDestroyCommandPool(m_device.GetHandle(), m_frames[i].commandPool, nullptr);
-  //      }
-  //  #endif
-  //
-  //      destroy_buffers(1, &m_staging_buffer_handle);
-  //
-  //      vkDestroyCommandPool(m_device.get_handle(), m_transient_command_pool, nullptr);
-  //
-  //      destroy_samplers(1, &m_default_sampler);
-
-  //}
+  Context::Context(Ref<ContextConfig> config) : m_config(config), m_resources(std::make_unique<ResourceTables>())
+  {
+  }
+
+  template<typename T, typename HandleT> static auto collect_handles(MutRef<SlotMap<T, HandleT>> map) -> Vec<HandleT>
+  {
+    Mut<Vec<HandleT>> handles;
+    handles.reserve(map.size());
+    map.for_each([&](HandleT handle, Ref<T>) { handles.push_back(handle); });
+    return handles;
+  }
+
+  Context::~Context()
+  {
+    // A moved-from context owns nothing, its resource tables went with the move. A context whose create() failed
+    // owns whatever was made up to the failure, every step below checks that its object exists.
+    if (!m_resources)
+      return;
+
+    if (m_device.get_handle() != VK_NULL_HANDLE)
+      release_device_objects();
+
+#if !IAGPU_DISABLE_GRAPHICS
+    if (m_surface != VK_NULL_HANDLE)
+      vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+#endif
+
+    destroy_instance();
+  }
+
+  auto Context::release_device_objects() -> void
+  {
+    m_device.wait_idle();
+    const VkDevice device = m_device.get_handle();
+
+    // Internal rings first, their buffers live in the same table as the application's.
+    m_upload_queue.destroy();
+    if (m_readback_ring)
+      m_readback_ring->destroy();
+    m_staging_ring.destroy();
+
+#if !IAGPU_DISABLE_GRAPHICS
+    destroy_swapchain();
+#endif
+
+    for (auto &frame : m_frames)
+    {
+      for (const auto table : frame.transient_tables)
+        m_resources->descriptor_tables.destroy(table);
+      frame.transient_tables.clear();
+      release_transient_resources(frame);
+      for (const auto &heap : frame.transient_heaps)
+        vmaFreeMemory(m_device.get_allocator(), heap.allocation);
+      frame.transient_heaps.clear();
+    }
+
+    // Whatever the application did not destroy, so that no allocation outlives the allocator.
+    for (const auto pipeline : collect_handles(m_resources->pipelines))
+      destroy_pipeline(pipeline);
+    for (const auto shader : collect_handles(m_resources->shaders))
+      destroy_shader(shader);
+    Mut<Vec<Sampler>> samplers = collect_handles(m_resources->samplers);
+    destroy_samplers(samplers);
+    destroy_fences(collect_handles(m_resources->fences));
+    destroy_query_pools(collect_handles(m_resources->query_pools));
+    destroy_textures(collect_handles(m_resources->textures));
+    destroy_buffers(collect_handles(m_resources->buffers));
+    m_deferred_releases.drain();
+
+    // Layouts the pipelines did not release are the application's, released as often as they were acquired. The
+    // bindless layout's handle belongs to the bindless heap.
+    for (const auto layout : collect_handles(m_resources->binding_layouts))
+    {
+      if (layout == m_bindless_layout)
+      {
+        m_resources->binding_layouts.destroy_internal(layout);
+        continue;
+      }
+      while (m_resources->binding_layouts.is_valid(layout))
+        release_binding_layout(device, *m_resources, layout);
+    }
+
+    if (m_buffer_pool)
+      m_buffer_pool->destroy();
+
+    for (auto &frame : m_frames)
+    {
+      frame.transient_descriptors.destroy();
+      for (auto &thread : frame.thread_commands)
+        vkDestroyCommandPool(device, thread.command_pool, nullptr);
+      vkDestroyCommandPool(device, frame.async_compute_command_pool, nullptr);
+#if IAGPU_DISABLE_GRAPHICS
+      vkDestroyCommandPool(device, frame.command_pool, nullptr);
+#endif
+    }
+    vkDestroyCommandPool(device, m_transient_command_pool, nullptr);
+
+    m_async_compute_timeline.destroy();
+    if (m_profiler)
+      m_profiler->destroy();
+    if (m_bindless_heap)
+      m_bindless_heap->destroy();
+    m_descriptor_allocator.destroy();
+    m_main_timeline.destroy();
+    m_pipeline_cache.destroy();
+
+    m_device.destroy();
+  }
 
   auto Context::initialize_instance(bool enable_validation) -> Result<void>
   {
@@ -247,33 +390,635 @@ namespace ia::gpu::vulkan
 
   auto Context::destroy_instance() -> void
   {
+    if (m_instance == VK_NULL_HANDLE)
+      return;
+
     if (m_debug_messenger != VK_NULL_HANDLE)
       vkDestroyDebugUtilsMessengerEXT(m_instance, m_debug_messenger, nullptr);
+    m_debug_messenger = VK_NULL_HANDLE;
 
     vkDestroyInstance(m_instance, nullptr);
+    m_instance = VK_NULL_HANDLE;
+  }
+
+  void Context::wait_idle()
+  {
+    m_device.wait_idle();
+    m_deferred_releases.drain();
+  }
+
+  std::pair<Context::CmdListType *, u32> Context::begin_frame()
+  {
+#if IAGPU_ENABLE_COUNTERS
+    publish_frame_counters();
+#endif
+    IAGPU_TIME_SCOPE(m_frame_counters.begin_frame_ns);
+
+#if !IAGPU_DISABLE_GRAPHICS
+    begin_graphics_frame();
+#else
+    begin_compute_only_frame();
+#endif
+
+    return {&advance_current_frame(), m_active_frame_index};
+  }
+
+  bool Context::end_frame(CmdListType *cmd)
+  {
+    IAGPU_TIME_SCOPE(m_frame_counters.end_frame_ns);
+
+#if !IAGPU_DISABLE_GRAPHICS
+    const bool result = end_graphics_frame(*cmd);
+#else
+    const bool result = end_compute_only_frame(*cmd);
+#endif
+
+    m_active_sync_frame_index = (m_active_sync_frame_index + 1) % MAX_PENDING_FRAME_COUNT;
+    return result;
+  }
+
+  Context::CmdListType *Context::begin_thread_commands(u32 thread_index)
+  {
+    MutRef<FrameContext> frame = m_frames[m_active_sync_frame_index];
+    assert(frame.is_open && "Thread command lists must be begun between begin_frame and end_frame");
+    assert(thread_index < frame.thread_commands.size());
+
+    MutRef<FrameContext::ThreadCommands> thread = frame.thread_commands[thread_index];
+
+    // Pools are created the first time a thread records into this frame slot, command pool creation needs no
+    // external synchronization on the device.
+    if IA_B_UNLIKELY (thread.command_pool == VK_NULL_HANDLE)
+    {
+      const VkCommandPoolCreateInfo command_pool_create_info{
+          .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+          .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+          .queueFamilyIndex = get_main_queue_family(),
+      };
+      if IA_B_UNLIKELY (vkCreateCommandPool(m_device.get_handle(), &command_pool_create_info, nullptr,
+                                            &thread.command_pool) != VK_SUCCESS)
+      {
+        GPU_LOG_ERROR("Failed to create the command pool of recording thread {}", thread_index);
+        return nullptr;
+      }
+    }
+
+    if (thread.used_cmd_list_count == thread.cmd_list_cache.size())
+    {
+      const VkCommandBufferAllocateInfo allocate_info{
+          .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+          .commandPool = thread.command_pool,
+          .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+          .commandBufferCount = 1,
+      };
+      Mut<VkCommandBuffer> handle{};
+      if IA_B_UNLIKELY (vkAllocateCommandBuffers(m_device.get_handle(), &allocate_info, &handle) != VK_SUCCESS)
+      {
+        GPU_LOG_ERROR("Failed to allocate a command list for recording thread {}", thread_index);
+        return nullptr;
+      }
+      thread.cmd_list_cache.emplace_back(handle, m_resources.get(), m_profiler.get());
+    }
+
+    MutRef<CmdListType> cmd = thread.cmd_list_cache[thread.used_cmd_list_count++];
+#ifndef NDEBUG
+    cmd.clear_transitioned_resources();
+#endif
+
+    const VkCommandBufferBeginInfo begin_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    vkBeginCommandBuffer(cmd.get_handle(), &begin_info);
+
+    return &cmd;
+  }
+
+  void Context::end_thread_commands(CmdListType *cmd)
+  {
+    cmd->flush_transitions();
+    vkEndCommandBuffer(cmd->get_handle());
+  }
+
+  StagingStats Context::get_staging_stats()
+  {
+    return m_staging_ring.get_stats();
+  }
+
+  MemoryBudget Context::get_memory_budget()
+  {
+    return m_residency.get_budget();
+  }
+
+  ApiCounters Context::get_frame_counters()
+  {
+    return m_last_frame_counters;
+  }
+
+#if IAGPU_ENABLE_COUNTERS
+  auto Context::publish_frame_counters() -> void
+  {
+    // Handle creation is counted by the slot maps over their whole lifetime, the frame gets the difference.
+    Mut<u64> created = 0;
+    Mut<u64> destroyed = 0;
+    const auto add_table = [&](const auto &table) {
+      created += table.get_created_count();
+      destroyed += table.get_destroyed_count();
+    };
+    add_table(m_resources->buffers);
+    add_table(m_resources->textures);
+    add_table(m_resources->samplers);
+    add_table(m_resources->shaders);
+    add_table(m_resources->pipelines);
+    add_table(m_resources->binding_layouts);
+    add_table(m_resources->descriptor_tables);
+    add_table(m_resources->fences);
+    add_table(m_resources->query_pools);
+
+    m_frame_counters.resources_created = created - m_resources_created_total;
+    m_frame_counters.resources_destroyed = destroyed - m_resources_destroyed_total;
+    m_resources_created_total = created;
+    m_resources_destroyed_total = destroyed;
+
+    m_last_frame_counters = m_frame_counters;
+    m_frame_counters = {};
+  }
+#endif
+
+  GpuFrameTimings Context::get_gpu_frame_timings()
+  {
+    if (!m_profiler)
+      return {};
+    return m_profiler->get_last_frame();
+  }
+
+  u64 Context::get_last_submission_value()
+  {
+    return m_main_timeline.get_last_submitted_value();
+  }
+
+  u64 Context::get_completed_submission_value()
+  {
+    return m_main_timeline.get_completed_value();
+  }
+
+  bool Context::wait_for_submission(u64 value, u64 timeout)
+  {
+    return m_main_timeline.wait(value, timeout);
+  }
+
+  u64 Context::upload_buffer_async(Buffer buffer, u64 offset, std::span<const u8> data)
+  {
+    const auto result = m_upload_queue.upload_buffer(buffer, offset, data, m_main_timeline.get_last_submitted_value());
+    if IA_B_UNLIKELY (!result)
+    {
+      GPU_LOG_ERROR("Async buffer upload failed: {}", result.error());
+      return 0;
+    }
+    IAGPU_COUNT(m_frame_counters.async_upload_bytes, data.size());
+    return *result;
+  }
+
+  u64 Context::upload_texture_async(Texture texture, std::span<const u8> data,
+                                    std::span<const BufferTextureCopyRegion> regions)
+  {
+    const auto result =
+        m_upload_queue.upload_texture(texture, data, regions, m_main_timeline.get_last_submitted_value());
+    if IA_B_UNLIKELY (!result)
+    {
+      GPU_LOG_ERROR("Async texture upload failed: {}", result.error());
+      return 0;
+    }
+    IAGPU_COUNT(m_frame_counters.async_upload_bytes, data.size());
+    return *result;
+  }
+
+  u64 Context::flush_async_uploads()
+  {
+    const auto result = m_upload_queue.flush();
+    if IA_B_UNLIKELY (!result)
+    {
+      GPU_LOG_ERROR("Async upload submission failed: {}", result.error());
+      return 0;
+    }
+    return *result;
+  }
+
+  u64 Context::get_completed_upload_value()
+  {
+    return m_upload_queue.get_completed_value();
+  }
+
+  bool Context::wait_for_upload(u64 value, u64 timeout)
+  {
+    return m_upload_queue.wait(value, timeout);
   }
 
   auto Context::begin_compute_only_frame() -> void
   {
+    open_frame();
+    m_active_frame_index = m_active_sync_frame_index;
   }
 
   auto Context::end_compute_only_frame(MutRef<CmdListType> cmd) -> bool
   {
+    cmd.flush_transitions();
+    vkEndCommandBuffer(cmd.get_handle());
+
+    return submit_frame(cmd, nullptr, m_device.get_compute_queue(), VK_NULL_HANDLE, VK_NULL_HANDLE);
   }
 
-  auto Context::begin_graphics_frame() -> void
+  auto Context::advance_current_frame() -> MutRef<CmdListType>
   {
+    MutRef<FrameContext> frame = open_frame();
+
+    if (frame.used_cmd_list_count == frame.cmd_list_cache.size())
+    {
+      const VkCommandBufferAllocateInfo allocate_info{
+          .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+          .commandPool = frame.command_pool,
+          .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+          .commandBufferCount = 1,
+      };
+      Mut<VkCommandBuffer> handle{};
+      vkAllocateCommandBuffers(m_device.get_handle(), &allocate_info, &handle);
+      frame.cmd_list_cache.emplace_back(handle, m_resources.get(), m_profiler.get());
+    }
+
+    MutRef<CmdListType> cmd = frame.cmd_list_cache[frame.used_cmd_list_count++];
+
+    const VkCommandBufferBeginInfo begin_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    vkBeginCommandBuffer(cmd.get_handle(), &begin_info);
+
+    return cmd;
   }
 
-  auto Context::end_graphics_frame(MutRef<CmdListType> cmd) -> bool
+  auto Context::open_frame() -> MutRef<FrameContext>
   {
+    MutRef<FrameContext> frame = m_frames[m_active_sync_frame_index];
+    if (frame.is_open)
+      return frame;
+
+    m_main_timeline.wait(frame.submitted_value, UINT64_MAX);
+    m_async_compute_timeline.wait(frame.async_compute_value, UINT64_MAX);
+    m_deferred_releases.collect(get_collectable_release_value());
+
+    vkResetCommandPool(m_device.get_handle(), frame.command_pool, 0);
+    frame.used_cmd_list_count = 0;
+    frame.has_pending_uploads = false;
+
+    for (auto &thread : frame.thread_commands)
+    {
+      if (thread.used_cmd_list_count == 0)
+        continue;
+      vkResetCommandPool(m_device.get_handle(), thread.command_pool, 0);
+      thread.used_cmd_list_count = 0;
+    }
+    if (frame.used_async_compute_cmd_list_count)
+    {
+      vkResetCommandPool(m_device.get_handle(), frame.async_compute_command_pool, 0);
+      frame.used_async_compute_cmd_list_count = 0;
+    }
+
+    m_staging_ring.retire_frame(m_active_sync_frame_index);
+    collect_readbacks();
+
+    if (m_profiler)
+      m_profiler->open_slot(m_active_sync_frame_index, frame.submitted_value);
+
+    // The frame's transient tables die with it, their sets all at once with the pool reset.
+    for (const auto table : frame.transient_tables)
+      m_resources->descriptor_tables.destroy(table);
+    frame.transient_tables.clear();
+    const auto descriptor_reset = frame.transient_descriptors.reset();
+    if IA_B_UNLIKELY (!descriptor_reset)
+      GPU_LOG_ERROR("Failed to reset transient descriptor pools: {}", descriptor_reset.error());
+
+    release_transient_resources(frame);
+
+    frame.is_open = true;
+
+    // After opening, so that the callback may record uploads or create and destroy resources into this frame.
+    if (m_residency.update() && m_config.memory_pressure_callback)
+    {
+      const MemoryBudget budget = m_residency.get_budget();
+      m_config.memory_pressure_callback(&budget, m_config.memory_pressure_callback_user_data);
+    }
+
+    return frame;
   }
 
-  auto Context::advance_current_frame() -> MutRef<CmdListType>
+  auto Context::has_thread_commands() -> bool
+  {
+    for (const auto &thread : m_frames[m_active_sync_frame_index].thread_commands)
+    {
+      if (thread.used_cmd_list_count)
+        return true;
+    }
+    return false;
+  }
+
+#ifndef NDEBUG
+  auto Context::are_thread_resources_disjoint(Ref<FrameContext> frame) -> bool
+  {
+    struct Use
+    {
+      CmdListType::TransitionedResource resource;
+      u32 thread_index;
+
+      auto operator<=>(const Use &) const = default;
+    };
+
+    Mut<Vec<Use>> uses;
+    for (Mut<u32> t = 0; t < frame.thread_commands.size(); t++)
+    {
+      Ref<FrameContext::ThreadCommands> thread = frame.thread_commands[t];
+      for (Mut<u32> i = 0; i < thread.used_cmd_list_count; i++)
+      {
+        for (const auto &resource : thread.cmd_list_cache[i].get_transitioned_resources())
+          uses.push_back({resource, t});
+      }
+    }
+    std::sort(uses.begin(), uses.end());
+
+    // Lists of one thread index are recorded one after the other, only uses from two indices can race.
+    for (Mut<size_t> i = 1; i < uses.size(); i++)
+    {
+      if (uses[i].resource != uses[i - 1].resource || uses[i].thread_index == uses[i - 1].thread_index)
+        continue;
+      GPU_LOG_ERROR("Thread lists {} and {} both transitioned the {} {:#x}", uses[i - 1].thread_index,
+                    uses[i].thread_index, uses[i].resource.offset == UINT64_MAX ? "image" : "buffer",
+                    uses[i].resource.handle);
+      return false;
+    }
+    return true;
+  }
+#endif
+
+  auto Context::submit_frame(MutRef<CmdListType> cmd, CmdListType *epilogue, VkQueue queue,
+                             VkSemaphore wait_semaphore, VkSemaphore signal_semaphore) -> bool
+  {
+    MutRef<FrameContext> frame = m_frames[m_active_sync_frame_index];
+
+    assert(are_thread_resources_disjoint(frame) && "Thread lists of different thread indices share a resource");
+
+    // Uploads recorded during the frame are submitted now so the frame can consume them. The acquire half of the
+    // ownership transfer goes into the upload command buffer, which runs ahead of the frame's own commands.
+    if IA_B_UNLIKELY (!m_upload_queue.flush())
+      GPU_LOG_ERROR("Failed to submit the pending async uploads");
+
+    Mut<u64> upload_wait_value = 0;
+    if (m_upload_queue.has_unacquired_uploads())
+    {
+      auto upload_cmd = begin_upload_commands();
+      if (upload_cmd)
+      {
+        upload_wait_value = m_upload_queue.acquire_submitted(*upload_cmd);
+        upload_cmd->collect_counters(m_frame_counters);
+      }
+    }
+
+    // Submission order: staged uploads, the main list, worker lists by thread index and begin order, the epilogue.
+    Mut<Vec<VkCommandBufferSubmitInfo>> command_buffer_infos;
+    command_buffer_infos.reserve(3);
+
+    const auto push_command_buffer = [&](VkCommandBuffer handle) {
+      command_buffer_infos.push_back({
+          .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+          .commandBuffer = handle,
+      });
+    };
+
+    if (frame.has_pending_uploads)
+    {
+      vkEndCommandBuffer(frame.upload_command_buffer);
+      push_command_buffer(frame.upload_command_buffer);
+      frame.has_pending_uploads = false;
+    }
+
+    push_command_buffer(cmd.get_handle());
+    cmd.collect_counters(m_frame_counters);
+
+    for (auto &thread : frame.thread_commands)
+    {
+      for (Mut<u32> i = 0; i < thread.used_cmd_list_count; i++)
+      {
+        push_command_buffer(thread.cmd_list_cache[i].get_handle());
+        thread.cmd_list_cache[i].collect_counters(m_frame_counters);
+      }
+    }
+
+    if (epilogue)
+    {
+      push_command_buffer(epilogue->get_handle());
+      epilogue->collect_counters(m_frame_counters);
+    }
+
+    Mut<VkSemaphoreSubmitInfo> wait_infos[3]{};
+    Mut<u32> wait_count = 0;
+
+    if (wait_semaphore)
+    {
+      wait_infos[wait_count++] = {
+          .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+          .semaphore = wait_semaphore,
+          .stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+      };
+    }
+    if (upload_wait_value)
+    {
+      wait_infos[wait_count++] =
+          m_upload_queue.get_timeline().get_wait_info(upload_wait_value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    }
+    if (m_async_compute_dependency)
+    {
+      wait_infos[wait_count++] =
+          m_async_compute_timeline.get_wait_info(m_async_compute_dependency, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+      m_async_compute_dependency = 0;
+    }
+
+    const u64 submitted_value = m_main_timeline.advance();
+    for (const auto &info : command_buffer_infos)
+      m_readback_ring->submit(info.commandBuffer, ReadbackRing::EQueue::Main, submitted_value);
+
+    Mut<VkSemaphoreSubmitInfo> signal_infos[2]{};
+    Mut<u32> signal_count = 0;
+
+    signal_infos[signal_count++] =
+        m_main_timeline.get_signal_info(submitted_value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    if (signal_semaphore)
+    {
+      signal_infos[signal_count++] = {
+          .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+          .semaphore = signal_semaphore,
+          .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+      };
+    }
+
+    const VkSubmitInfo2 submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+        .waitSemaphoreInfoCount = wait_count,
+        .pWaitSemaphoreInfos = wait_infos,
+        .commandBufferInfoCount = (u32) command_buffer_infos.size(),
+        .pCommandBufferInfos = command_buffer_infos.data(),
+        .signalSemaphoreInfoCount = signal_count,
+        .pSignalSemaphoreInfos = signal_infos,
+    };
+
+    const auto result = vkQueueSubmit2(queue, 1, &submit_info, VK_NULL_HANDLE);
+
+    m_staging_ring.close_frame(m_active_sync_frame_index);
+    frame.submitted_value = submitted_value;
+    frame.is_open = false;
+
+    if IA_B_UNLIKELY (result != VK_SUCCESS)
+    {
+      GPU_LOG_ERROR("Frame submission failed with code {}", (i64) result);
+      return false;
+    }
+
+    return true;
+  }
+
+  auto Context::prepare_staging_memory(u64 size, u64 alignment) -> Result<StagingRing::Allocation>
   {
+    // Make sure the frame the allocation gets charged to has retired its previous region first.
+    open_frame();
+    IAGPU_COUNT(m_frame_counters.staging_bytes, size);
+    return m_staging_ring.allocate(size, alignment);
+  }
+
+  auto Context::begin_upload_commands() -> Result<CmdListType>
+  {
+    MutRef<FrameContext> frame = open_frame();
+
+    if (frame.upload_command_buffer == VK_NULL_HANDLE)
+    {
+      const VkCommandBufferAllocateInfo allocate_info{
+          .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+          .commandPool = frame.command_pool,
+          .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+          .commandBufferCount = 1,
+      };
+      VK_CALL(vkAllocateCommandBuffers(m_device.get_handle(), &allocate_info, &frame.upload_command_buffer),
+              "Allocating upload command buffer");
+    }
+
+    if (!frame.has_pending_uploads)
+    {
+      const VkCommandBufferBeginInfo begin_info{
+          .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+          .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+      };
+      VK_CALL(vkBeginCommandBuffer(frame.upload_command_buffer, &begin_info), "Beginning upload command buffer");
+      frame.has_pending_uploads = true;
+    }
+
+    return CmdListType(frame.upload_command_buffer, m_resources.get());
   }
 
-  auto Context::prepare_staging_memory(u64 size) -> Result<void *>
+  auto Context::begin_immediate_commands() -> VkCommandBuffer
   {
+    const VkCommandBufferAllocateInfo allocate_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .commandPool = m_transient_command_pool,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1,
+    };
+    Mut<VkCommandBuffer> handle{};
+    if IA_B_UNLIKELY (vkAllocateCommandBuffers(m_device.get_handle(), &allocate_info, &handle) != VK_SUCCESS)
+    {
+      GPU_LOG_ERROR("Failed to allocate immediate command buffer");
+      return VK_NULL_HANDLE;
+    }
+
+    const VkCommandBufferBeginInfo begin_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    vkBeginCommandBuffer(handle, &begin_info);
+
+    return handle;
+  }
+
+  auto Context::end_immediate_commands(MutRef<CmdListType> cmd) -> bool
+  {
+    const VkCommandBuffer handle = cmd.get_handle();
+    cmd.flush_transitions();
+    cmd.collect_counters(m_frame_counters);
+    vkEndCommandBuffer(handle);
+
+    const VkCommandBufferSubmitInfo command_buffer_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+        .commandBuffer = handle,
+    };
+    const VkSubmitInfo2 submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+        .commandBufferInfoCount = 1,
+        .pCommandBufferInfos = &command_buffer_info,
+    };
+
+    // Immediate submissions stay off the main timeline so that its values map one to one onto frames, which is what
+    // get_release_value relies on.
+    const VkFence fence = m_device.get_command_submit_fence();
+    vkResetFences(m_device.get_handle(), 1, &fence);
+
+    Mut<bool> result = vkQueueSubmit2(get_main_queue(), 1, &submit_info, fence) == VK_SUCCESS;
+    if (result)
+      result = vkWaitForFences(m_device.get_handle(), 1, &fence, VK_TRUE, UINT64_MAX) == VK_SUCCESS;
+    else
+      GPU_LOG_ERROR("Immediate command submission failed");
+
+    // Already waited for, readbacks recorded into the list are complete.
+    m_readback_ring->submit(handle, ReadbackRing::EQueue::Main, 0);
+
+    vkFreeCommandBuffers(m_device.get_handle(), m_transient_command_pool, 1, &handle);
+    return result;
+  }
+
+  auto Context::get_release_value() const -> u64
+  {
+    // An open frame may already have recorded commands that use the object, so it has to retire as well.
+    const bool frame_open = m_frames[m_active_sync_frame_index].is_open;
+    return m_main_timeline.get_last_submitted_value() + (frame_open ? 1 : 0);
+  }
+
+  auto Context::collect_readbacks() -> void
+  {
+    m_readback_ring->collect(m_main_timeline.get_completed_value(), m_async_compute_timeline.get_completed_value());
+  }
+
+  auto Context::get_main_queue() const -> VkQueue
+  {
+#if !IAGPU_DISABLE_GRAPHICS
+    return m_device.get_graphics_queue();
+#else
+    return m_device.get_compute_queue();
+#endif
+  }
+
+  auto Context::get_main_queue_family() const -> u32
+  {
+#if !IAGPU_DISABLE_GRAPHICS
+    return m_device.get_graphics_queue_family();
+#else
+    return m_device.get_compute_queue_family();
+#endif
+  }
+
+  auto Context::set_object_name(VkObjectType type, u64 handle, const char *name) -> void
+  {
+    if (!name || m_debug_messenger == VK_NULL_HANDLE)
+      return;
+
+    const VkDebugUtilsObjectNameInfoEXT name_info{
+        .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
+        .objectType = type,
+        .objectHandle = handle,
+        .pObjectName = name,
+    };
+    vkSetDebugUtilsObjectNameEXT(m_device.get_handle(), &name_info);
   }
 } // namespace ia::gpu::vulkan
\ No newline at end of file
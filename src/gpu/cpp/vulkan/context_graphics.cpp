@@ -17,6 +17,114 @@
 
 namespace ia::gpu::vulkan
 {
+#if !IAGPU_DISABLE_GRAPHICS
+  static auto get_blend_attachment_state(EBlendMode mode) -> VkPipelineColorBlendAttachmentState
+  {
+    Mut<VkPipelineColorBlendAttachmentState> state{
+        .blendEnable = VK_TRUE,
+        .colorBlendOp = VK_BLEND_OP_ADD,
+        .alphaBlendOp = VK_BLEND_OP_ADD,
+        .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
+                          VK_COLOR_COMPONENT_A_BIT,
+    };
+
+    switch (mode)
+    {
+    case EBlendMode::Opaque:
+      state.blendEnable = VK_FALSE;
+      break;
+
+    case EBlendMode::Alpha:
+      state.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+      state.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+      state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+      state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+      break;
+
+    case EBlendMode::Premultiplied:
+      state.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+      state.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+      state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+      state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+      break;
+
+    case EBlendMode::Additive:
+      state.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+      state.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+      state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+      state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+      break;
+
+    case EBlendMode::Multiply:
+      state.srcColorBlendFactor = VK_BLEND_FACTOR_DST_COLOR;
+      state.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+      state.srcAlphaBlendFactor = VK_BLEND_FACTOR_DST_ALPHA;
+      state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+      break;
+
+    case EBlendMode::Modulate:
+      state.srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+      state.dstColorBlendFactor = VK_BLEND_FACTOR_SRC_COLOR;
+      state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+      state.dstAlphaBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+      break;
+    }
+
+    return state;
+  }
+
+  static auto map_primitive_topology(EPrimitiveType type) -> VkPrimitiveTopology
+  {
+    switch (type)
+    {
+    case EPrimitiveType::PointList:
+      return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+    case EPrimitiveType::LineList:
+      return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+    case EPrimitiveType::LineStrip:
+      return VK_PRIMITIVE_TOPOLOGY_LINE_STRIP;
+    case EPrimitiveType::TriangleStrip:
+      return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+    default:
+      return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    }
+  }
+
+  static auto map_polygon_mode(EPolygonMode mode) -> VkPolygonMode
+  {
+    switch (mode)
+    {
+    case EPolygonMode::Line:
+      return VK_POLYGON_MODE_LINE;
+    case EPolygonMode::Point:
+      return VK_POLYGON_MODE_POINT;
+    default:
+      return VK_POLYGON_MODE_FILL;
+    }
+  }
+
+  static auto map_cull_mode(ECullMode mode) -> VkCullModeFlags
+  {
+    switch (mode)
+    {
+    case ECullMode::Back:
+      return VK_CULL_MODE_BACK_BIT;
+    case ECullMode::Front:
+      return VK_CULL_MODE_FRONT_BIT;
+    default:
+      return VK_CULL_MODE_NONE;
+    }
+  }
+
+  static auto get_attachment_hash(const GraphicsPipelineDesc &desc) -> u64
+  {
+    Mut<u64> hash = HASH_SEED;
+    for (Mut<u32> i = 0; i < desc.color_attachment_count; i++)
+      hash = hash_combine(hash, (u64) desc.color_formats[i]);
+    return hash_combine(hash, (u64) desc.depth_format);
+  }
+#endif
+
 #if !IAGPU_DISABLE_GRAPHICS
   auto Context::initialize_swapchain(u32 width, u32 height) -> Result<void>
   {
@@ -41,11 +149,6 @@ namespace ia::gpu::vulkan
     m_swapchain_min_possible_extent = surface_capabilities.minImageExtent;
     m_swapchain_max_possible_extent = surface_capabilities.maxImageExtent;
 
-    const VkFenceCreateInfo fence_create_info{
-        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-        .flags = VK_FENCE_CREATE_SIGNALED_BIT,
-    };
-
     const VkCommandPoolCreateInfo command_pool_create_info{
         .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
         .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
@@ -54,11 +157,9 @@ namespace ia::gpu::vulkan
 
     for (Mut<i32> i = 0; i < m_swapchain_buffer_count; i++)
     {
-      VK_CALL(vkCreateFence(m_device.get_handle(), &fence_create_info, nullptr, &m_frames[i].in_flight_fence),
-              "Creating swapchain inflight fence");
       VK_CALL(vkCreateCommandPool(m_device.get_handle(), &command_pool_create_info, nullptr, &m_frames[i].command_pool),
               "Creating swapchain command pool");
-      m_frames[i].render_target_texture = new TextureImpl();
+      m_frames[i].render_target_texture = m_resources->textures.create_internal();
     }
 
     m_swapchain = VK_NULL_HANDLE;
@@ -74,8 +175,7 @@ namespace ia::gpu::vulkan
     {
       m_frames[i].cmd_list_cache.clear();
       m_frames[i].used_cmd_list_count = 0;
-      delete m_frames[i].render_target_texture;
-      vkDestroyFence(m_device.get_handle(), m_frames[i].in_flight_fence, nullptr);
+      m_resources->textures.destroy_internal(m_frames[i].render_target_texture);
       vkDestroyImageView(m_device.get_handle(), m_frames[i].swapchain_image_view, nullptr);
       vkDestroyCommandPool(m_device.get_handle(), m_frames[i].command_pool, nullptr);
       vkDestroySemaphore(m_device.get_handle(), m_frames[i].image_available_semaphore, nullptr);
@@ -84,6 +184,54 @@ namespace ia::gpu::vulkan
 
     vkDestroySwapchainKHR(m_device.get_handle(), m_swapchain, nullptr);
   }
+
+  auto Context::begin_graphics_frame() -> void
+  {
+    MutRef<FrameContext> frame = open_frame();
+
+    Mut<u32> image_index{};
+    const auto result = vkAcquireNextImageKHR(m_device.get_handle(), m_swapchain, UINT64_MAX,
+                                              frame.image_available_semaphore, VK_NULL_HANDLE, &image_index);
+    if IA_B_UNLIKELY (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+      GPU_LOG_ERROR("Failed to acquire swapchain image (code {})", (i64) result);
+
+    m_active_frame_index = image_index;
+    m_back_buffer = m_frames[image_index].render_target_texture;
+  }
+
+  auto Context::end_graphics_frame(MutRef<CmdListType> cmd) -> bool
+  {
+    // Worker lists execute after the main list, so the present transition moves into an epilogue list behind them.
+    Mut<CmdListType *> epilogue = nullptr;
+    if (has_thread_commands())
+    {
+      cmd.flush_transitions();
+      vkEndCommandBuffer(cmd.get_handle());
+      epilogue = &advance_current_frame();
+    }
+
+    MutRef<CmdListType> last = epilogue ? *epilogue : cmd;
+    last.transition_texture(m_back_buffer, EResourceState::Present);
+    last.flush_transitions();
+    vkEndCommandBuffer(last.get_handle());
+
+    const VkSemaphore render_finished_semaphore = m_frames[m_active_frame_index].render_finished_semaphore;
+    if (!submit_frame(cmd, epilogue, m_device.get_graphics_queue(),
+                      m_frames[m_active_sync_frame_index].image_available_semaphore, render_finished_semaphore))
+      return false;
+
+    const VkPresentInfoKHR present_info{
+        .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+        .waitSemaphoreCount = 1,
+        .pWaitSemaphores = &render_finished_semaphore,
+        .swapchainCount = 1,
+        .pSwapchains = &m_swapchain,
+        .pImageIndices = &m_active_frame_index,
+    };
+
+    // Out of date and suboptimal swapchains are reported to the caller, who owns the window size.
+    return vkQueuePresentKHR(m_device.get_graphics_queue(), &present_info) == VK_SUCCESS;
+  }
 #endif
 
   Result<void> Context::resize_swapchain(u32 width, u32 height)
@@ -145,7 +293,8 @@ namespace ia::gpu::vulkan
 
       m_frames[frame_index].swapchain_image = img;
       m_frames[frame_index].swapchain_image_view = view;
-      *m_frames[frame_index++].render_target_texture = TextureImpl(img, view, m_swapchain_extent);
+      *m_resources->textures.get(m_frames[frame_index++].render_target_texture) =
+          TextureImpl(img, view, m_swapchain_extent);
     }
 
     const VkSemaphoreCreateInfo semaphore_create_info{
@@ -172,4 +321,151 @@ namespace ia::gpu::vulkan
     return fail("ResizeSwapchain must not be called when IAGPU_DISABLE_GRAPHICS is TRUE");
 #endif
   }
-} // namespace ia::gpu::vulkan
\ No newline at end of file
+
+  Result<Pipeline> Context::create_graphics_pipeline(const GraphicsPipelineDesc &desc)
+  {
+    return m_resources->pipelines.create(AU_TRY(build_graphics_pipeline(desc)));
+  }
+
+  auto Context::build_graphics_pipeline(Ref<GraphicsPipelineDesc> desc) -> Result<PipelineImpl>
+  {
+#if !IAGPU_DISABLE_GRAPHICS
+    const auto vertex_shader = m_resources->shaders.get(desc.vertex_shader);
+    const auto fragment_shader = m_resources->shaders.get(desc.fragment_shader);
+    const VkPipelineShaderStageCreateInfo stages[] = {vertex_shader->stage_create_info,
+                                                      fragment_shader->stage_create_info};
+
+    Mut<PipelineImpl> pipeline{
+        .attachment_hash = get_attachment_hash(desc),
+        .bind_point = VK_PIPELINE_BIND_POINT_GRAPHICS,
+    };
+    const Shader shaders[] = {desc.vertex_shader, desc.fragment_shader};
+    const std::span<const BindingLayout> layouts(desc.layouts, desc.layout_count);
+    AU_TRY_PURE(
+        resolve_pipeline_layout(shaders, layouts, desc.push_constant_size, desc.push_constant_stages, pipeline));
+
+    Mut<Vec<VkVertexInputBindingDescription>> input_bindings;
+    input_bindings.reserve(desc.input_binding_count);
+    for (Mut<u32> i = 0; i < desc.input_binding_count; i++)
+    {
+      input_bindings.push_back({
+          .binding = desc.input_bindings[i].binding,
+          .stride = desc.input_bindings[i].stride,
+          .inputRate = desc.input_bindings[i].input_rate == EInputRate::Instance ? VK_VERTEX_INPUT_RATE_INSTANCE
+                                                                                 : VK_VERTEX_INPUT_RATE_VERTEX,
+      });
+    }
+
+    Mut<Vec<VkVertexInputAttributeDescription>> input_attributes;
+    input_attributes.reserve(desc.input_attribute_count);
+    for (Mut<u32> i = 0; i < desc.input_attribute_count; i++)
+    {
+      input_attributes.push_back({
+          .location = desc.input_attributes[i].location,
+          .binding = desc.input_attributes[i].binding,
+          .format = map_format(desc.input_attributes[i].format),
+          .offset = desc.input_attributes[i].offset,
+      });
+    }
+
+    const VkPipelineVertexInputStateCreateInfo vertex_input_state{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = (u32) input_bindings.size(),
+        .pVertexBindingDescriptions = input_bindings.data(),
+        .vertexAttributeDescriptionCount = (u32) input_attributes.size(),
+        .pVertexAttributeDescriptions = input_attributes.data(),
+    };
+
+    const VkPipelineInputAssemblyStateCreateInfo input_assembly_state{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+        .topology = map_primitive_topology(desc.primitive_type),
+    };
+
+    const VkPipelineViewportStateCreateInfo viewport_state{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+        .viewportCount = 1,
+        .scissorCount = 1,
+    };
+
+    const VkPipelineRasterizationStateCreateInfo rasterization_state{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+        .polygonMode = map_polygon_mode(desc.polygon_mode),
+        .cullMode = map_cull_mode(desc.cull_mode),
+        .frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE,
+        .lineWidth = 1.0f,
+    };
+
+    const VkPipelineMultisampleStateCreateInfo multisample_state{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+    };
+
+    const bool has_depth = desc.depth_format != EFormat::Undefined;
+    const VkPipelineDepthStencilStateCreateInfo depth_stencil_state{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+        .depthTestEnable = has_depth,
+        .depthWriteEnable = has_depth,
+        .depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL,
+    };
+
+    Mut<VkPipelineColorBlendAttachmentState> blend_attachments[7];
+    Mut<VkFormat> color_formats[7];
+    for (Mut<u32> i = 0; i < desc.color_attachment_count; i++)
+    {
+      blend_attachments[i] = get_blend_attachment_state(desc.blend_mode);
+      color_formats[i] = map_format(desc.color_formats[i]);
+    }
+
+    const VkPipelineColorBlendStateCreateInfo color_blend_state{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+        .attachmentCount = desc.color_attachment_count,
+        .pAttachments = blend_attachments,
+    };
+
+    const VkDynamicState dynamic_states[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    const VkPipelineDynamicStateCreateInfo dynamic_state{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+        .dynamicStateCount = 2,
+        .pDynamicStates = dynamic_states,
+    };
+
+    const VkFormat depth_format = map_format(desc.depth_format);
+    const VkPipelineRenderingCreateInfo rendering_create_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+        .colorAttachmentCount = desc.color_attachment_count,
+        .pColorAttachmentFormats = color_formats,
+        .depthAttachmentFormat = depth_format,
+        .stencilAttachmentFormat = (get_image_aspect(desc.depth_format) & VK_IMAGE_ASPECT_STENCIL_BIT)
+                                       ? depth_format
+                                       : VK_FORMAT_UNDEFINED,
+    };
+
+    const VkGraphicsPipelineCreateInfo pipeline_create_info{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = &rendering_create_info,
+        .stageCount = 2,
+        .pStages = stages,
+        .pVertexInputState = &vertex_input_state,
+        .pInputAssemblyState = &input_assembly_state,
+        .pViewportState = &viewport_state,
+        .pRasterizationState = &rasterization_state,
+        .pMultisampleState = &multisample_state,
+        .pDepthStencilState = &depth_stencil_state,
+        .pColorBlendState = &color_blend_state,
+        .pDynamicState = &dynamic_state,
+        .layout = pipeline.layout,
+    };
+    if IA_B_UNLIKELY (vkCreateGraphicsPipelines(m_device.get_handle(), m_pipeline_cache.get_handle(), 1,
+                                                &pipeline_create_info, nullptr, &pipeline.handle) != VK_SUCCESS)
+    {
+      discard_pipeline_layout(pipeline);
+      return fail("Failed to create graphics pipeline");
+    }
+
+    return pipeline;
+#else
+    AU_UNUSED(desc);
+    return fail("create_graphics_pipeline must not be called when IAGPU_DISABLE_GRAPHICS is TRUE");
+#endif
+  }
+} // namespace ia::gpu::vulkan
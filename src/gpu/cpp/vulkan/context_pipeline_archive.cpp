@@ -0,0 +1,286 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/context.hpp>
+
+#include <gpu/pipeline_archive.hpp>
+#include <mapped_file.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace ia::gpu::vulkan
+{
+  // Bounds checked views into a mapped archive.
+  class ArchiveReader
+  {
+public:
+    explicit ArchiveReader(std::span<const u8> data) : m_data(data)
+    {
+    }
+
+    template<typename T> auto get_table(u64 offset, u64 count) const -> Result<std::span<const T>>
+    {
+      if (offset % alignof(T) != 0 || offset > m_data.size() || count > (m_data.size() - offset) / sizeof(T))
+        return fail("Pipeline archive table at {} with {} entries is out of bounds", offset, count);
+      return std::span<const T>{reinterpret_cast<const T *>(m_data.data() + offset), count};
+    }
+
+    auto get_bytes(u64 offset, u64 size) const -> Result<std::span<const u8>>
+    {
+      return get_table<u8>(offset, size);
+    }
+
+    auto get_string(Ref<PipelineArchiveHeader> header, PipelineArchiveString string) const -> Result<std::string>
+    {
+      if ((u64) string.offset + string.length > header.string_table_size)
+        return fail("Pipeline archive string is out of bounds");
+      const auto bytes = AU_TRY(get_bytes(header.string_table_offset + string.offset, string.length));
+      return std::string(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    }
+
+private:
+    std::span<const u8> m_data;
+  };
+
+  struct PipelineJob
+  {
+    std::string name;
+    Vec<BindingLayout> layouts;
+
+    bool is_graphics{};
+    ComputePipelineDesc compute_desc{};
+    GraphicsPipelineDesc graphics_desc{};
+    Vec<VertexInputBinding> vertex_bindings;
+    Vec<VertexInputAttribute> vertex_attributes;
+
+    Result<PipelineImpl> result{fail("Pipeline was not built")};
+  };
+
+  Result<LoadedPipelineArchive> Context::load_pipeline_archive(const char *path, u32 thread_count)
+  {
+    const MappedFile file = AU_TRY(MappedFile::open(path));
+    const ArchiveReader reader(file.get_data());
+
+    const auto header_span = AU_TRY(reader.get_table<PipelineArchiveHeader>(0, 1));
+    Ref<PipelineArchiveHeader> header = header_span[0];
+    if (header.magic != PIPELINE_ARCHIVE_MAGIC || header.version != PIPELINE_ARCHIVE_VERSION)
+      return fail("'{}' is not a version {} pipeline archive", path, PIPELINE_ARCHIVE_VERSION);
+
+    const auto shader_table = AU_TRY(reader.get_table<PipelineArchiveShader>(header.shader_table_offset,
+                                                                            header.shader_count));
+    const auto pipeline_table = AU_TRY(reader.get_table<PipelineArchivePipeline>(header.pipeline_table_offset,
+                                                                                header.pipeline_count));
+    const auto binding_table = AU_TRY(reader.get_table<PipelineArchiveBinding>(header.binding_table_offset,
+                                                                              header.binding_count));
+    const auto vertex_binding_table = AU_TRY(reader.get_table<PipelineArchiveVertexBinding>(
+        header.vertex_binding_table_offset, header.vertex_binding_count));
+    const auto vertex_attribute_table = AU_TRY(reader.get_table<PipelineArchiveVertexAttribute>(
+        header.vertex_attribute_table_offset, header.vertex_attribute_count));
+
+    Mut<LoadedPipelineArchive> archive;
+    Mut<Vec<PipelineJob>> jobs;
+
+    // Everything created so far is released when loading fails part way.
+    const auto load = [&]() -> Result<void> {
+      archive.shaders.reserve(shader_table.size());
+      for (const auto &shader : shader_table)
+      {
+        if (shader.first_binding + (u64) shader.binding_count > binding_table.size())
+          return fail("Shader bindings are out of bounds");
+
+        // Vulkan copies the module on creation, so the words are handed over straight from the mapping.
+        const auto code = AU_TRY(reader.get_bytes(shader.code_offset, shader.code_size));
+        archive.shaders.push_back(AU_TRY(create_shader(code)));
+      }
+
+      // Per-set binding layouts from the reflected bindings of the pipeline's shaders. Identical sets share one layout
+      // through create_binding_layout, the archive holds one reference per set.
+      const auto get_layout = [&](std::span<const BindingLayoutEntry> entries) -> Result<BindingLayout> {
+        archive.binding_layouts.push_back(AU_TRY(create_binding_layout(entries)));
+        return archive.binding_layouts.back();
+      };
+
+      jobs.resize(pipeline_table.size());
+      for (Mut<u64> i = 0; i < pipeline_table.size(); i++)
+      {
+        Ref<PipelineArchivePipeline> entry = pipeline_table[i];
+        MutRef<PipelineJob> job = jobs[i];
+        job.name = AU_TRY(reader.get_string(header, entry.name));
+        job.is_graphics = entry.compute_shader == PIPELINE_ARCHIVE_INVALID_INDEX;
+
+        const u32 shader_indices[] = {job.is_graphics ? entry.vertex_shader : entry.compute_shader,
+                                      job.is_graphics ? entry.fragment_shader : PIPELINE_ARCHIVE_INVALID_INDEX};
+
+        Mut<Vec<Vec<BindingLayoutEntry>>> sets;
+        for (const u32 shader_index : shader_indices)
+        {
+          if (shader_index == PIPELINE_ARCHIVE_INVALID_INDEX)
+            continue;
+          if (shader_index >= shader_table.size())
+            return fail("Pipeline '{}' references shader {} out of bounds", job.name, shader_index);
+
+          Ref<PipelineArchiveShader> shader = shader_table[shader_index];
+          for (const auto &binding : binding_table.subspan(shader.first_binding, shader.binding_count))
+          {
+            if (binding.set >= 8)
+              return fail("Pipeline '{}' uses descriptor set {}, at most 8 are supported", job.name, binding.set);
+            if (binding.set >= sets.size())
+              sets.resize(binding.set + 1);
+
+            // A binding seen by both stages is merged into one entry visible to both.
+            MutRef<Vec<BindingLayoutEntry>> set = sets[binding.set];
+            const auto it = std::find_if(set.begin(), set.end(), [&](Ref<BindingLayoutEntry> e) {
+              return e.binding == binding.binding;
+            });
+            if (it != set.end())
+              it->visibility = (EShaderStage) ((u32) it->visibility | binding.visibility);
+            else
+            {
+              set.push_back({
+                  .binding = binding.binding,
+                  .count = binding.count,
+                  .visibility = (EShaderStage) binding.visibility,
+                  .type = (EDescriptorType) binding.type,
+              });
+            }
+          }
+        }
+        for (auto &set : sets)
+        {
+          std::sort(set.begin(), set.end(),
+                    [](Ref<BindingLayoutEntry> a, Ref<BindingLayoutEntry> b) { return a.binding < b.binding; });
+          job.layouts.push_back(AU_TRY(get_layout(set)));
+        }
+
+        if (!job.is_graphics)
+        {
+          job.compute_desc.set_shader(archive.shaders[entry.compute_shader])
+              .set_layouts(job.layouts.data(), (u32) job.layouts.size())
+              .set_push_constants((u8) entry.push_constant_size);
+          continue;
+        }
+
+        if (entry.first_vertex_binding + (u64) entry.vertex_binding_count > vertex_binding_table.size() ||
+            entry.first_vertex_attribute + (u64) entry.vertex_attribute_count > vertex_attribute_table.size() ||
+            entry.color_attachment_count > 7)
+          return fail("Pipeline '{}' has out of bounds graphics state", job.name);
+
+        for (const auto &binding : vertex_binding_table.subspan(entry.first_vertex_binding, entry.vertex_binding_count))
+        {
+          job.vertex_bindings.push_back({
+              .binding = binding.binding,
+              .stride = binding.stride,
+              .input_rate = (EInputRate) binding.input_rate,
+          });
+        }
+        for (const auto &attribute :
+             vertex_attribute_table.subspan(entry.first_vertex_attribute, entry.vertex_attribute_count))
+        {
+          job.vertex_attributes.push_back({
+              .location = attribute.location,
+              .binding = attribute.binding,
+              .format = (EFormat) attribute.format,
+              .offset = attribute.offset,
+          });
+        }
+
+        MutRef<GraphicsPipelineDesc> desc = job.graphics_desc;
+        desc.set_shaders(archive.shaders[entry.vertex_shader], archive.shaders[entry.fragment_shader])
+            .set_layouts(job.layouts.data(), (u32) job.layouts.size())
+            .set_vertex_input(job.vertex_bindings.data(), (u32) job.vertex_bindings.size(),
+                              job.vertex_attributes.data(), (u32) job.vertex_attributes.size())
+            .set_depth_stencil((EFormat) entry.depth_format)
+            .set_push_constants((u8) entry.push_constant_size, (EShaderStage) entry.push_constant_stages)
+            .set_rasterization((ECullMode) entry.cull_mode, (EBlendMode) entry.blend_mode,
+                               (EPolygonMode) entry.polygon_mode, (EPrimitiveType) entry.primitive_type);
+        for (Mut<u32> c = 0; c < entry.color_attachment_count; c++)
+          desc.add_color_attachment((EFormat) entry.color_formats[c]);
+      }
+
+      // Pipeline compilation dominates, and vkCreate*Pipelines as well as the pipeline cache are safe to use from
+      // several threads. Only the slot map insertion below needs to happen on this thread.
+      const u32 worker_count =
+          std::min<u32>(thread_count ? thread_count : std::max(1u, std::thread::hardware_concurrency()),
+                        (u32) jobs.size());
+
+      Mut<std::atomic<u32>> next_job{0};
+      const auto work = [&] {
+        for (Mut<u32> i = next_job++; i < jobs.size(); i = next_job++)
+        {
+          MutRef<PipelineJob> job = jobs[i];
+#if IAGPU_DISABLE_GRAPHICS
+          if (job.is_graphics)
+            continue;
+#endif
+          job.result = job.is_graphics ? build_graphics_pipeline(job.graphics_desc)
+                                       : build_compute_pipeline(job.compute_desc);
+        }
+      };
+
+      Mut<Vec<std::thread>> workers;
+      for (Mut<u32> i = 1; i < worker_count; i++)
+        workers.emplace_back(work);
+      work();
+      for (auto &worker : workers)
+        worker.join();
+
+      Mut<Result<void>> result{};
+      for (auto &job : jobs)
+      {
+#if IAGPU_DISABLE_GRAPHICS
+        if (job.is_graphics)
+        {
+          GPU_LOG_WARN("Skipping graphics pipeline '{}' from '{}' in a headless build", job.name, path);
+          continue;
+        }
+#endif
+        if (!job.result)
+        {
+          if (result)
+            result = fail("Pipeline '{}': {}", job.name, job.result.error());
+          continue;
+        }
+
+        const Pipeline pipeline = m_resources->pipelines.create(std::move(*job.result));
+        job.result = fail("Pipeline was moved into the archive");
+        archive.pipelines.insert_or_assign(job.name, LoadedPipeline{pipeline, std::move(job.layouts)});
+      }
+      return result;
+    };
+
+    const auto result = load();
+    if (!result)
+    {
+      unload_pipeline_archive(archive);
+      return fail("Failed to load '{}': {}", path, result.error());
+    }
+
+    return archive;
+  }
+
+  void Context::unload_pipeline_archive(LoadedPipelineArchive &archive)
+  {
+    for (const auto &[name, entry] : archive.pipelines)
+      destroy_pipeline(entry.pipeline);
+    for (const auto layout : archive.binding_layouts)
+      destroy_binding_layout(layout);
+    for (const auto shader : archive.shaders)
+      destroy_shader(shader);
+
+    archive = {};
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,127 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/context.hpp>
+
+namespace ia::gpu::vulkan
+{
+  struct PipelineStatisticField
+  {
+    VkQueryPipelineStatisticFlagBits bit;
+    u64 PipelineStatistics::*field;
+  };
+
+  // In the bit order Vulkan writes the counters in.
+  static constexpr PipelineStatisticField PIPELINE_STATISTIC_FIELDS[] = {
+      {VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT, &PipelineStatistics::input_assembly_vertices},
+      {VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT, &PipelineStatistics::input_assembly_primitives},
+      {VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT, &PipelineStatistics::vertex_shader_invocations},
+      {VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT, &PipelineStatistics::clipping_invocations},
+      {VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT, &PipelineStatistics::clipping_primitives},
+      {VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT, &PipelineStatistics::fragment_shader_invocations},
+      {VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT, &PipelineStatistics::compute_shader_invocations},
+  };
+
+  bool Context::create_query_pools(std::span<const QueryPoolDesc> descs, std::span<QueryPool> out)
+  {
+    for (Mut<size_t> i = 0; i < descs.size(); i++)
+    {
+      Ref<QueryPoolDesc> desc = descs[i];
+
+      Mut<VkQueryPoolCreateInfo> create_info{
+          .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+          .queryCount = desc.query_count,
+      };
+      if (desc.type == EQueryType::PipelineStatistics)
+      {
+        if IA_B_UNLIKELY (!m_device.is_pipeline_statistics_supported())
+        {
+          GPU_LOG_ERROR("Query pool \"{}\": the device does not support pipeline statistics queries",
+                        desc.debug_name ? desc.debug_name : "");
+          destroy_query_pools(out.subspan(0, i));
+          return false;
+        }
+        create_info.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        create_info.pipelineStatistics = PIPELINE_STATISTICS_FLAGS;
+      }
+      else
+        create_info.queryType = VK_QUERY_TYPE_OCCLUSION;
+
+      Mut<VkQueryPool> pool{};
+      if IA_B_UNLIKELY (vkCreateQueryPool(m_device.get_handle(), &create_info, nullptr, &pool) != VK_SUCCESS)
+      {
+        GPU_LOG_ERROR("Failed to create query pool \"{}\"", desc.debug_name ? desc.debug_name : "");
+        destroy_query_pools(out.subspan(0, i));
+        return false;
+      }
+
+      set_object_name(VK_OBJECT_TYPE_QUERY_POOL, (u64) pool, desc.debug_name);
+
+      out[i] = m_resources->query_pools.create(QueryPoolImpl{
+          .handle = pool,
+          .type = desc.type,
+          .query_count = desc.query_count,
+      });
+    }
+
+    return true;
+  }
+
+  void Context::destroy_query_pools(std::span<const QueryPool> pools)
+  {
+    for (const auto pool : pools)
+    {
+      const auto impl = m_resources->query_pools.try_get(pool);
+      if (!impl)
+        continue;
+
+      m_deferred_releases.push(get_release_value(), [device = m_device.get_handle(), handle = impl->handle] {
+        vkDestroyQueryPool(device, handle, nullptr);
+      });
+      m_resources->query_pools.destroy(pool);
+    }
+  }
+
+  bool Context::get_occlusion_results(QueryPool pool, u32 first, std::span<u64> out)
+  {
+    const auto impl = m_resources->query_pools.get(pool);
+    return vkGetQueryPoolResults(m_device.get_handle(), impl->handle, first, (u32) out.size(), out.size_bytes(),
+                                 out.data(), sizeof(u64), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS;
+  }
+
+  bool Context::get_pipeline_statistics(QueryPool pool, u32 first, std::span<PipelineStatistics> out)
+  {
+    const auto impl = m_resources->query_pools.get(pool);
+
+    Mut<Vec<u64>> values(out.size() * PIPELINE_STATISTICS_VALUE_COUNT);
+    if (vkGetQueryPoolResults(m_device.get_handle(), impl->handle, first, (u32) out.size(), values.size() * sizeof(u64),
+                              values.data(), PIPELINE_STATISTICS_VALUE_COUNT * sizeof(u64),
+                              VK_QUERY_RESULT_64_BIT) != VK_SUCCESS)
+      return false;
+
+    Mut<const u64 *> value = values.data();
+    for (auto &stats : out)
+    {
+      stats = {};
+      for (const auto &field : PIPELINE_STATISTIC_FIELDS)
+      {
+        if (PIPELINE_STATISTICS_FLAGS & field.bit)
+          stats.*field.field = *value++;
+      }
+    }
+
+    return true;
+  }
+} // namespace ia::gpu::vulkan
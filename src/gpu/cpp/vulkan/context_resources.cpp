@@ -0,0 +1,1162 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stream_copy.hpp>
+#include <vulkan/context.hpp>
+#include <vulkan/layout_cache.hpp>
+#include <vulkan/shader_reflection.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace ia::gpu::vulkan
+{
+  // Copies into host-cached memory stay plain below this, they are likely to be read back by the host while still
+  // in its caches.
+  static constexpr u64 STREAM_COPY_CACHED_THRESHOLD = 1024 * 1024;
+
+  static auto is_storage_capable_format(EFormat format) -> bool
+  {
+    switch (format)
+    {
+    case EFormat::R8G8B8A8Unorm:
+    case EFormat::R32Uint:
+    case EFormat::R32Float:
+    case EFormat::R32G32Float:
+    case EFormat::R32G32B32A32Float:
+      return true;
+
+    default:
+      return false;
+    }
+  }
+
+  // Pulls the stage and the entry point name out of the first OpEntryPoint instruction of a SPIR-V module.
+  static auto parse_spirv_entry_point(std::span<const u32> words, MutRef<VkShaderStageFlagBits> out_stage,
+                                      MutRef<std::string> out_name) -> bool
+  {
+    static constexpr u32 SPIRV_MAGIC = 0x07230203;
+    static constexpr u32 SPIRV_HEADER_WORD_COUNT = 5;
+    static constexpr u32 SPIRV_OP_ENTRY_POINT = 15;
+
+    if (words.size() < SPIRV_HEADER_WORD_COUNT || words[0] != SPIRV_MAGIC)
+      return false;
+
+    for (Mut<u64> i = SPIRV_HEADER_WORD_COUNT; i < words.size();)
+    {
+      const u32 word_count = words[i] >> 16;
+      const u32 opcode = words[i] & 0xFFFF;
+      if (word_count == 0 || i + word_count > words.size())
+        return false;
+
+      if (opcode == SPIRV_OP_ENTRY_POINT && word_count >= 4)
+      {
+        switch (words[i + 1])
+        {
+        case 0:
+          out_stage = VK_SHADER_STAGE_VERTEX_BIT;
+          break;
+        case 4:
+          out_stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+          break;
+        case 5:
+          out_stage = VK_SHADER_STAGE_COMPUTE_BIT;
+          break;
+        default:
+          return false;
+        }
+
+        const char *name = reinterpret_cast<const char *>(&words[i + 3]);
+        out_name.assign(name, strnlen(name, (word_count - 3) * sizeof(u32)));
+        return true;
+      }
+
+      i += word_count;
+    }
+
+    return false;
+  }
+
+  bool Context::create_buffers(std::span<const BufferDesc> descs, std::span<Buffer> out)
+  {
+    assert(out.size() >= descs.size());
+
+    for (Mut<u32> i = 0; i < descs.size(); i++)
+    {
+      Ref<BufferDesc> desc = descs[i];
+
+      const VkBufferCreateInfo buffer_create_info = build_buffer_create_info(desc);
+
+      Mut<VmaAllocationCreateInfo> allocation_create_info =
+          m_residency.build_allocation_create_info(desc.memory_priority, VMA_MEMORY_USAGE_AUTO);
+      if (desc.host_visible)
+        allocation_create_info.flags |= (desc.host_write_only ? VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT
+                                                              : VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT) |
+                                        VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+      if (is_pooled_buffer(desc))
+      {
+        const auto suballocation = m_buffer_pool->allocate(desc.size_bytes, buffer_create_info, allocation_create_info);
+        if IA_B_UNLIKELY (!suballocation)
+        {
+          GPU_LOG_ERROR("Failed to create pooled buffer \"{}\" ({} bytes): {}", desc.debug_name ? desc.debug_name : "",
+                        desc.size_bytes, suballocation.error());
+          destroy_buffers(out.subspan(0, i));
+          return false;
+        }
+
+        out[i] = register_pooled_buffer(desc, *suballocation);
+        continue;
+      }
+
+      Mut<VkBuffer> buffer{};
+      Mut<VmaAllocation> allocation{};
+      Mut<VmaAllocationInfo> allocation_info{};
+      if IA_B_UNLIKELY (vmaCreateBuffer(m_device.get_allocator(), &buffer_create_info, &allocation_create_info,
+                                        &buffer, &allocation, &allocation_info) != VK_SUCCESS)
+      {
+        const auto [usage, budget] = m_residency.get_device_local_usage();
+        GPU_LOG_ERROR("Failed to create buffer \"{}\" ({} bytes, {} of {} device-local bytes in use)",
+                      desc.debug_name ? desc.debug_name : "", desc.size_bytes, usage, budget);
+        destroy_buffers(out.subspan(0, i));
+        return false;
+      }
+
+      m_residency.track(desc.memory_priority, allocation, allocation_info);
+      out[i] = register_buffer(desc, buffer, allocation, allocation_info);
+    }
+
+    return true;
+  }
+
+  auto Context::is_pooled_buffer(Ref<BufferDesc> desc) const -> bool
+  {
+    // Priorities other than normal need an allocation of their own, see ResidencyManager.
+    return m_buffer_pool && desc.size_bytes <= m_config.buffer_pool_max_size &&
+           desc.memory_priority == EMemoryPriority::Normal;
+  }
+
+  auto Context::build_buffer_create_info(Ref<BufferDesc> desc) const -> VkBufferCreateInfo
+  {
+    // Predicate buffers stay usable as query result destinations when the device lacks conditional rendering.
+    Mut<VkBufferUsageFlags> usage = map_buffer_usage(desc.usage);
+    if (!m_device.is_conditional_rendering_supported())
+      usage &= ~(VkBufferUsageFlags) VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+
+    return {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = desc.size_bytes,
+        .usage = usage,
+        .sharingMode = m_shared_queue_family_count ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = m_shared_queue_family_count,
+        .pQueueFamilyIndices = m_shared_queue_families,
+    };
+  }
+
+  auto Context::register_buffer(Ref<BufferDesc> desc, VkBuffer buffer, VmaAllocation allocation,
+                                Ref<VmaAllocationInfo> allocation_info) -> Buffer
+  {
+    set_object_name(VK_OBJECT_TYPE_BUFFER, (u64) buffer, desc.debug_name);
+
+    const Buffer handle =
+        m_resources->buffers.create(m_device.get_allocator(), buffer, allocation, allocation_info, desc.size_bytes);
+
+    MutRef<BufferImpl> impl = *m_resources->buffers.get(handle);
+    impl.is_host_cached = is_host_cached(allocation);
+
+    if (m_bindless_heap && ((u32) desc.usage & (u32) EBufferUsage::Storage))
+      impl.bindless_index = m_bindless_heap->add_buffer(buffer, 0, VK_WHOLE_SIZE);
+
+    return handle;
+  }
+
+  auto Context::register_pooled_buffer(Ref<BufferDesc> desc, Ref<BufferPool::Suballocation> suballocation) -> Buffer
+  {
+    // The page's VkBuffer is shared, so it keeps its own name.
+    Mut<VmaAllocationInfo> allocation_info{};
+    allocation_info.pMappedData = suballocation.mapped;
+
+    const Buffer handle = m_resources->buffers.create(m_device.get_allocator(), suballocation.buffer,
+                                                      suballocation.allocation, allocation_info, desc.size_bytes);
+
+    MutRef<BufferImpl> impl = *m_resources->buffers.get(handle);
+    impl.offset = suballocation.offset;
+    impl.pool_page = suballocation.page;
+    impl.pool_allocation = suballocation.virtual_allocation;
+    impl.is_host_cached = is_host_cached(suballocation.allocation);
+
+    if (m_bindless_heap && ((u32) desc.usage & (u32) EBufferUsage::Storage))
+      impl.bindless_index = m_bindless_heap->add_buffer(impl.handle, impl.offset, impl.size);
+
+    return handle;
+  }
+
+  auto Context::is_host_cached(VmaAllocation allocation) const -> bool
+  {
+    if (!allocation)
+      return false;
+
+    Mut<VkMemoryPropertyFlags> flags{};
+    vmaGetAllocationMemoryProperties(m_device.get_allocator(), allocation, &flags);
+    return (flags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) != 0;
+  }
+
+  void Context::destroy_buffers(std::span<const Buffer> buffers)
+  {
+    for (const auto buffer : buffers)
+    {
+      const auto impl = m_resources->buffers.try_get(buffer);
+      if (!impl)
+        continue;
+
+      if (impl->pool_allocation)
+      {
+        m_deferred_releases.push(get_release_value(), [pool = m_buffer_pool.get(), page = impl->pool_page,
+                                                       allocation = impl->pool_allocation, heap = m_bindless_heap.get(),
+                                                       bindless_index = impl->bindless_index] {
+          pool->free(page, allocation);
+          if (heap)
+            heap->remove_buffer(bindless_index);
+        });
+        m_resources->buffers.destroy(buffer);
+        continue;
+      }
+
+      m_residency.untrack(impl->allocation);
+      m_deferred_releases.push(get_release_value(), [allocator = impl->vma_allocator, handle = impl->handle,
+                                                     allocation = impl->allocation, heap = m_bindless_heap.get(),
+                                                     bindless_index = impl->bindless_index] {
+        vmaDestroyBuffer(allocator, handle, allocation);
+        if (heap)
+          heap->remove_buffer(bindless_index);
+      });
+      m_resources->buffers.destroy(buffer);
+    }
+  }
+
+  bool Context::create_textures(std::span<const TextureDesc> descs, std::span<Texture> out)
+  {
+    assert(out.size() >= descs.size());
+
+    for (Mut<u32> i = 0; i < descs.size(); i++)
+    {
+      Ref<TextureDesc> desc = descs[i];
+
+      const VkImageCreateInfo image_create_info = build_texture_create_info(desc);
+
+      const VmaAllocationCreateInfo allocation_create_info =
+          m_residency.build_allocation_create_info(desc.memory_priority, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE);
+
+      Mut<TextureImpl> texture{};
+      texture.vma_allocator = m_device.get_allocator();
+      if IA_B_UNLIKELY (vmaCreateImage(m_device.get_allocator(), &image_create_info, &allocation_create_info,
+                                       &texture.handle, &texture.allocation, &texture.alloc_info) != VK_SUCCESS)
+      {
+        const auto [usage, budget] = m_residency.get_device_local_usage();
+        GPU_LOG_ERROR("Failed to create texture \"{}\" ({}x{}x{}, {} of {} device-local bytes in use)",
+                      desc.debug_name ? desc.debug_name : "", desc.width, desc.height, desc.depth, usage, budget);
+        destroy_textures(out.subspan(0, i));
+        return false;
+      }
+
+      const VmaAllocation allocation = texture.allocation;
+      const VmaAllocationInfo allocation_info = texture.alloc_info;
+      out[i] = register_texture(desc, image_create_info, std::move(texture));
+      if IA_B_UNLIKELY (!out[i])
+      {
+        destroy_textures(out.subspan(0, i));
+        return false;
+      }
+      m_residency.track(desc.memory_priority, allocation, allocation_info);
+    }
+
+    return true;
+  }
+
+  auto Context::build_texture_create_info(Ref<TextureDesc> desc) const -> VkImageCreateInfo
+  {
+    const bool is_depth = is_depth_format(desc.format);
+    const bool is_cube = desc.type == ETextureType::TextureCube;
+
+    Mut<VkImageUsageFlags> usage =
+        VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if (is_depth)
+      usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    else if (!is_compressed_format(desc.format))
+      usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    if (is_storage_capable_format(desc.format))
+      usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+
+    return {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .flags = is_cube ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : (VkImageCreateFlags) 0,
+        .imageType = desc.type == ETextureType::Texture3D ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D,
+        .format = map_format(desc.format),
+        .extent = {desc.width, desc.height, desc.depth},
+        .mipLevels = desc.mip_levels,
+        .arrayLayers = is_cube ? desc.array_layers * 6 : desc.array_layers,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = usage,
+        .sharingMode = m_shared_queue_family_count ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = m_shared_queue_family_count,
+        .pQueueFamilyIndices = m_shared_queue_families,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+  }
+
+  auto Context::register_texture(Ref<TextureDesc> desc, Ref<VkImageCreateInfo> image_create_info,
+                                 Mut<TextureImpl> texture) -> Texture
+  {
+    const bool is_depth = is_depth_format(desc.format);
+
+    Mut<VkImageViewType> view_type = VK_IMAGE_VIEW_TYPE_2D;
+    switch (desc.type)
+    {
+    case ETextureType::Texture3D:
+      view_type = VK_IMAGE_VIEW_TYPE_3D;
+      break;
+    case ETextureType::TextureCube:
+      view_type = desc.array_layers > 1 ? VK_IMAGE_VIEW_TYPE_CUBE_ARRAY : VK_IMAGE_VIEW_TYPE_CUBE;
+      break;
+    case ETextureType::Texture2DArray:
+      view_type = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+      break;
+    default:
+      break;
+    }
+
+    const VkImageViewCreateInfo view_create_info{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .image = texture.handle,
+        .viewType = view_type,
+        .format = image_create_info.format,
+        .subresourceRange =
+            {
+                .aspectMask = is_depth ? (VkImageAspectFlags) VK_IMAGE_ASPECT_DEPTH_BIT
+                                       : (VkImageAspectFlags) VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel = 0,
+                .levelCount = image_create_info.mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount = image_create_info.arrayLayers,
+            },
+    };
+    if IA_B_UNLIKELY (vkCreateImageView(m_device.get_handle(), &view_create_info, nullptr, &texture.view_handle) !=
+                      VK_SUCCESS)
+    {
+      GPU_LOG_ERROR("Failed to create view for texture \"{}\"", desc.debug_name ? desc.debug_name : "");
+      vmaDestroyImage(texture.vma_allocator, texture.handle, texture.allocation);
+      return nullptr;
+    }
+
+    set_object_name(VK_OBJECT_TYPE_IMAGE, (u64) texture.handle, desc.debug_name);
+
+    texture.is_compressed_data = is_compressed_format(desc.format);
+    texture.extent = image_create_info.extent;
+    texture.vk_format = image_create_info.format;
+    texture.format = desc.format;
+    texture.mip_levels = image_create_info.mipLevels;
+    texture.array_layer_count = image_create_info.arrayLayers;
+
+    if (m_bindless_heap)
+      texture.bindless_index = m_bindless_heap->add_texture(
+          texture.view_handle, true, (image_create_info.usage & VK_IMAGE_USAGE_STORAGE_BIT) != 0);
+
+    return m_resources->textures.create(std::move(texture));
+  }
+
+  void Context::destroy_textures(std::span<const Texture> textures)
+  {
+    for (const auto texture : textures)
+    {
+      const auto impl = m_resources->textures.try_get(texture);
+      if (!impl)
+        continue;
+
+      // Swapchain images are owned by the swapchain and carry no allocator.
+      if (impl->vma_allocator)
+      {
+        m_residency.untrack(impl->allocation);
+        m_deferred_releases.push(get_release_value(), [device = m_device.get_handle(), allocator = impl->vma_allocator,
+                                                       handle = impl->handle, view = impl->view_handle,
+                                                       allocation = impl->allocation, heap = m_bindless_heap.get(),
+                                                       bindless_index = impl->bindless_index] {
+          vkDestroyImageView(device, view, nullptr);
+          vmaDestroyImage(allocator, handle, allocation);
+          if (heap)
+            heap->remove_texture(bindless_index);
+        });
+      }
+      m_resources->textures.destroy(texture);
+    }
+  }
+
+  bool Context::create_samplers(std::span<const SamplerDesc> descs, std::span<Sampler> out)
+  {
+    assert(out.size() >= descs.size());
+
+    for (Mut<u32> i = 0; i < descs.size(); i++)
+    {
+      Ref<SamplerDesc> desc = descs[i];
+
+      const VkFilter filter = desc.linear_filter ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+      const VkSamplerAddressMode address_mode =
+          desc.repeat_uv ? VK_SAMPLER_ADDRESS_MODE_REPEAT : VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+      const VkSamplerCreateInfo sampler_create_info{
+          .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+          .magFilter = filter,
+          .minFilter = filter,
+          .mipmapMode = desc.linear_filter ? VK_SAMPLER_MIPMAP_MODE_LINEAR : VK_SAMPLER_MIPMAP_MODE_NEAREST,
+          .addressModeU = address_mode,
+          .addressModeV = address_mode,
+          .addressModeW = address_mode,
+          .maxLod = VK_LOD_CLAMP_NONE,
+      };
+
+      Mut<VkSampler> sampler{};
+      if IA_B_UNLIKELY (vkCreateSampler(m_device.get_handle(), &sampler_create_info, nullptr, &sampler) != VK_SUCCESS)
+      {
+        GPU_LOG_ERROR("Failed to create sampler \"{}\"", desc.debug_name ? desc.debug_name : "");
+        destroy_samplers(out.subspan(0, i));
+        return false;
+      }
+
+      set_object_name(VK_OBJECT_TYPE_SAMPLER, (u64) sampler, desc.debug_name);
+
+      out[i] = m_resources->samplers.create(SamplerImpl{
+          .handle = sampler,
+          .bindless_index = m_bindless_heap ? m_bindless_heap->add_sampler(sampler) : BINDLESS_INVALID_INDEX,
+      });
+    }
+
+    return true;
+  }
+
+  void Context::destroy_samplers(std::span<Sampler> samplers)
+  {
+    for (const auto sampler : samplers)
+    {
+      const auto impl = m_resources->samplers.try_get(sampler);
+      if (!impl)
+        continue;
+
+      m_deferred_releases.push(get_release_value(), [device = m_device.get_handle(), handle = impl->handle,
+                                                     heap = m_bindless_heap.get(),
+                                                     bindless_index = impl->bindless_index] {
+        vkDestroySampler(device, handle, nullptr);
+        if (heap)
+          heap->remove_sampler(bindless_index);
+      });
+      m_resources->samplers.destroy(sampler);
+    }
+  }
+
+  u32 Context::get_bindless_index(Texture texture)
+  {
+    return m_resources->textures.get(texture)->bindless_index;
+  }
+
+  u32 Context::get_bindless_index(Buffer buffer)
+  {
+    return m_resources->buffers.get(buffer)->bindless_index;
+  }
+
+  u32 Context::get_bindless_index(Sampler sampler)
+  {
+    return m_resources->samplers.get(sampler)->bindless_index;
+  }
+
+  Result<BindingLayout> Context::get_bindless_layout()
+  {
+    if (!m_bindless_heap)
+      return fail("The bindless heap requires ContextConfig::bindless_enabled");
+    return m_bindless_layout;
+  }
+
+  bool Context::create_fences(std::span<Fence> out, bool signaled)
+  {
+    const VkFenceCreateInfo fence_create_info{
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .flags = signaled ? (VkFenceCreateFlags) VK_FENCE_CREATE_SIGNALED_BIT : (VkFenceCreateFlags) 0,
+    };
+
+    for (Mut<u32> i = 0; i < out.size(); i++)
+    {
+      Mut<VkFence> fence{};
+      if IA_B_UNLIKELY (vkCreateFence(m_device.get_handle(), &fence_create_info, nullptr, &fence) != VK_SUCCESS)
+      {
+        GPU_LOG_ERROR("Failed to create fence");
+        destroy_fences(out.subspan(0, i));
+        return false;
+      }
+
+      out[i] = m_resources->fences.create(fence);
+    }
+
+    return true;
+  }
+
+  void Context::destroy_fences(std::span<const Fence> fences)
+  {
+    for (const auto fence : fences)
+    {
+      const auto impl = m_resources->fences.try_get(fence);
+      if (!impl)
+        continue;
+
+      vkDestroyFence(m_device.get_handle(), impl->handle, nullptr);
+      m_resources->fences.destroy(fence);
+    }
+  }
+
+  bool Context::wait_for_fences(std::span<const Fence> fences, bool wait_all, u64 timeout)
+  {
+    Mut<Vec<VkFence>> handles;
+    handles.reserve(fences.size());
+    for (const auto fence : fences)
+      handles.push_back(m_resources->fences.get(fence)->handle);
+
+    return vkWaitForFences(m_device.get_handle(), (u32) handles.size(), handles.data(), wait_all, timeout) ==
+           VK_SUCCESS;
+  }
+
+  bool Context::reset_fences(std::span<const Fence> fences)
+  {
+    Mut<Vec<VkFence>> handles;
+    handles.reserve(fences.size());
+    for (const auto fence : fences)
+      handles.push_back(m_resources->fences.get(fence)->handle);
+
+    return vkResetFences(m_device.get_handle(), (u32) handles.size(), handles.data()) == VK_SUCCESS;
+  }
+
+  static auto map_reflected_stage(VkShaderStageFlagBits stage) -> EShaderStage
+  {
+    switch (stage)
+    {
+    case VK_SHADER_STAGE_VERTEX_BIT:
+      return EShaderStage::Vertex;
+    case VK_SHADER_STAGE_FRAGMENT_BIT:
+      return EShaderStage::Fragment;
+    default:
+      return EShaderStage::Compute;
+    }
+  }
+
+  Result<Shader> Context::create_shader(std::span<const u8> data)
+  {
+    if (data.empty() || data.size() % sizeof(u32) != 0)
+      return fail("Shader bytecode size ({}) is not a multiple of 4", data.size());
+
+    const std::span<const u32> words{reinterpret_cast<const u32 *>(data.data()), data.size() / sizeof(u32)};
+
+    Mut<ShaderImpl> shader{};
+    Mut<VkShaderStageFlagBits> stage{};
+    if (!parse_spirv_entry_point(words, stage, shader.entry_point))
+      return fail("Shader bytecode is not a valid SPIR-V module with a vertex, fragment or compute entry point");
+
+    const VkShaderModuleCreateInfo shader_module_create_info{
+        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = data.size(),
+        .pCode = words.data(),
+    };
+    VK_CALL(vkCreateShaderModule(m_device.get_handle(), &shader_module_create_info, nullptr, &shader.handle),
+            "Creating shader module");
+
+    shader.stage_create_info = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+        .stage = stage,
+        .module = shader.handle,
+    };
+
+    // Only used by pipelines that leave their layouts empty. A shader that cannot be reflected behaves as if it used
+    // no descriptors and no push constants there, which is what such pipelines got before reflection existed.
+    auto reflection = reflect_shader(words, map_reflected_stage(stage));
+    if (reflection)
+      shader.reflection = std::move(*reflection);
+    else
+      GPU_LOG_WARN("Shader '{}' could not be reflected: {}", shader.entry_point, reflection.error());
+
+    const auto handle = m_resources->shaders.create(std::move(shader));
+
+    // The entry point string lives in the slot now, which never moves for the lifetime of the shader.
+    const auto impl = m_resources->shaders.get(handle);
+    impl->stage_create_info.pName = impl->entry_point.c_str();
+
+    return handle;
+  }
+
+  void Context::destroy_shader(Shader s)
+  {
+    const auto impl = m_resources->shaders.try_get(s);
+    if (!impl)
+      return;
+
+    vkDestroyShaderModule(m_device.get_handle(), impl->handle, nullptr);
+    m_resources->shaders.destroy(s);
+  }
+
+  Result<BindingLayout> Context::create_binding_layout(std::span<const BindingLayoutEntry> entries)
+  {
+    return acquire_binding_layout(m_device.get_handle(), *m_resources, entries);
+  }
+
+  void Context::destroy_binding_layout(BindingLayout l)
+  {
+    release_binding_layout(m_device.get_handle(), *m_resources, l);
+  }
+
+  bool Context::create_descriptor_tables(BindingLayout layout, std::span<DescriptorTable> out)
+  {
+    return allocate_descriptor_tables(m_descriptor_allocator, layout, out);
+  }
+
+  bool Context::create_transient_descriptor_tables(BindingLayout layout, std::span<DescriptorTable> out)
+  {
+    MutRef<FrameContext> frame = open_frame();
+    if (!allocate_descriptor_tables(frame.transient_descriptors, layout, out))
+      return false;
+
+    frame.transient_tables.insert(frame.transient_tables.end(), out.begin(), out.end());
+    return true;
+  }
+
+  auto Context::allocate_descriptor_tables(MutRef<DescriptorAllocator> allocator, BindingLayout layout,
+                                           std::span<DescriptorTable> out) -> bool
+  {
+    const auto layout_impl = m_resources->binding_layouts.get(layout);
+
+    for (Mut<u32> i = 0; i < out.size(); i++)
+    {
+      const auto allocation = allocator.allocate(*layout_impl);
+      if IA_B_UNLIKELY (!allocation)
+      {
+        GPU_LOG_ERROR("Failed to allocate descriptor table: {}", allocation.error());
+        if (!allocator.is_transient())
+          destroy_descriptor_tables(out.subspan(0, i));
+        return false;
+      }
+
+      out[i] = m_resources->descriptor_tables.create(DescriptorTableImpl{
+          .handle = allocation->set,
+          .layout = layout_impl,
+          .pool = allocator.is_transient() ? VK_NULL_HANDLE : allocation->pool,
+      });
+    }
+
+    return true;
+  }
+
+  void Context::destroy_descriptor_tables(std::span<DescriptorTable> tables)
+  {
+    for (const auto table : tables)
+    {
+      const auto impl = m_resources->descriptor_tables.try_get(table);
+      if (!impl)
+        continue;
+
+      // Transient tables go back with their frame's pools.
+      if (impl->pool != VK_NULL_HANDLE)
+      {
+        m_deferred_releases.push(get_release_value(),
+                                 [device = m_device.get_handle(), pool = impl->pool, handle = impl->handle] {
+                                   vkFreeDescriptorSets(device, pool, 1, &handle);
+                                 });
+      }
+      m_resources->descriptor_tables.destroy(table);
+    }
+  }
+
+  void Context::update_descriptor_tables(std::span<const DescriptorUpdate> updates)
+  {
+    MutRef<DescriptorUpdateScratch> scratch = m_descriptor_update_scratch;
+    scratch.order.clear();
+    scratch.writes.clear();
+    scratch.descriptors.clear();
+
+    for (Mut<u32> i = 0; i < updates.size(); i++)
+    {
+      if (!updates[i].skip_update)
+        scratch.order.push_back(i);
+    }
+
+    // Grouped by table and binding, so that updates of consecutive array elements collapse into one write. Updates of
+    // the same descriptor keep their span order and only the last one is written, as if they were applied in turn.
+    std::stable_sort(scratch.order.begin(), scratch.order.end(), [&](u32 a, u32 b) {
+      Ref<DescriptorUpdate> x = updates[a];
+      Ref<DescriptorUpdate> y = updates[b];
+      if (x.table != y.table)
+        return reinterpret_cast<u64>(x.table) < reinterpret_cast<u64>(y.table);
+      return x.binding != y.binding ? x.binding < y.binding : x.array_element < y.array_element;
+    });
+    const auto same_descriptor = [&](u32 a, u32 b) {
+      Ref<DescriptorUpdate> x = updates[a];
+      Ref<DescriptorUpdate> y = updates[b];
+      return x.table == y.table && x.binding == y.binding && x.array_element == y.array_element;
+    };
+    Mut<u64> kept = 0;
+    for (Mut<u64> i = 0; i < scratch.order.size(); i++)
+    {
+      if (i + 1 == scratch.order.size() || !same_descriptor(scratch.order[i], scratch.order[i + 1]))
+        scratch.order[kept++] = scratch.order[i];
+    }
+    scratch.order.resize(kept);
+
+    // Reserved up front, the writes below keep pointers into the descriptors.
+    scratch.writes.reserve(scratch.order.size());
+    scratch.descriptors.reserve(scratch.order.size());
+
+    for (const u32 index : scratch.order)
+    {
+      Ref<DescriptorUpdate> update = updates[index];
+
+      const auto table = m_resources->descriptor_tables.get(update.table);
+      const auto it = table->layout->binding_types.find(update.binding);
+      if IA_B_UNLIKELY (it == table->layout->binding_types.end())
+      {
+        GPU_LOG_ERROR("Descriptor update targets binding {} which is not part of the table's layout", update.binding);
+        continue;
+      }
+
+      const VkDescriptorType type = it->second;
+      scratch.descriptors.push_back(pack_descriptor(type, update.buffer, update.buffer_offset, update.buffer_range,
+                                                    update.texture, update.sampler));
+
+      if (!scratch.writes.empty())
+      {
+        MutRef<VkWriteDescriptorSet> previous = scratch.writes.back();
+        if (previous.dstSet == table->handle && previous.dstBinding == update.binding &&
+            previous.descriptorType == type &&
+            previous.dstArrayElement + previous.descriptorCount == update.array_element)
+        {
+          previous.descriptorCount++;
+          continue;
+        }
+      }
+
+      MutRef<PackedDescriptor> descriptor = scratch.descriptors.back();
+      const bool is_buffer = type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+      scratch.writes.push_back({
+          .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+          .dstSet = table->handle,
+          .dstBinding = update.binding,
+          .dstArrayElement = update.array_element,
+          .descriptorCount = 1,
+          .descriptorType = type,
+          .pImageInfo = is_buffer ? nullptr : &descriptor.image,
+          .pBufferInfo = is_buffer ? &descriptor.buffer : nullptr,
+      });
+    }
+
+    if (!scratch.writes.empty())
+      vkUpdateDescriptorSets(m_device.get_handle(), (u32) scratch.writes.size(), scratch.writes.data(), 0, nullptr);
+    IAGPU_COUNT(m_frame_counters.descriptor_writes, scratch.descriptors.size());
+  }
+
+  void Context::write_descriptor_table(DescriptorTable table, std::span<const DescriptorSlot> slots)
+  {
+    const auto impl = m_resources->descriptor_tables.get(table);
+    const auto layout = impl->layout;
+    if IA_B_UNLIKELY (slots.size() != layout->descriptor_count)
+    {
+      GPU_LOG_ERROR("write_descriptor_table got {} slots for a layout with {} descriptors", slots.size(),
+                    layout->descriptor_count);
+      return;
+    }
+    if (layout->update_template == VK_NULL_HANDLE)
+      return;
+
+    MutRef<Vec<PackedDescriptor>> descriptors = m_descriptor_update_scratch.descriptors;
+    descriptors.clear();
+    descriptors.reserve(slots.size());
+
+    Mut<u64> slot_index = 0;
+    for (const auto &entry : layout->entries)
+    {
+      const VkDescriptorType type = map_descriptor_type(entry.type);
+      for (Mut<u32> i = 0; i < entry.count; i++, slot_index++)
+      {
+        Ref<DescriptorSlot> slot = slots[slot_index];
+        descriptors.push_back(
+            pack_descriptor(type, slot.buffer, slot.buffer_offset, slot.buffer_range, slot.texture, slot.sampler));
+      }
+    }
+
+    vkUpdateDescriptorSetWithTemplate(m_device.get_handle(), impl->handle, layout->update_template,
+                                      descriptors.data());
+    IAGPU_COUNT(m_frame_counters.descriptor_writes, descriptors.size());
+  }
+
+  auto Context::pack_descriptor(VkDescriptorType type, Buffer buffer, u64 buffer_offset, u64 buffer_range,
+                                Texture texture, Sampler sampler) -> PackedDescriptor
+  {
+    Mut<PackedDescriptor> descriptor{};
+    switch (type)
+    {
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+    {
+      // A pooled buffer's whole range ends at its own size, not at the end of the page it shares.
+      const auto impl = m_resources->buffers.get(buffer);
+      descriptor.buffer = {
+          .buffer = impl->handle,
+          .offset = impl->offset + buffer_offset,
+          .range = buffer_range ? buffer_range : (impl->pool_allocation ? impl->size - buffer_offset : VK_WHOLE_SIZE),
+      };
+      break;
+    }
+
+    case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+      descriptor.image = {
+          .sampler = m_resources->samplers.get(sampler ? sampler : m_default_sampler)->handle,
+          .imageView = m_resources->textures.get(texture)->view_handle,
+          .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+      };
+      break;
+
+    case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+      descriptor.image = {
+          .imageView = m_resources->textures.get(texture)->view_handle,
+          .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
+      };
+      break;
+
+    default:
+      break;
+    }
+    return descriptor;
+  }
+
+  void Context::destroy_pipeline(Pipeline p)
+  {
+    const auto impl = m_resources->pipelines.try_get(p);
+    if (!impl)
+      return;
+
+    Mut<Vec<BindingLayout>> owned_set_layouts;
+    if (impl->owns_set_layouts)
+      owned_set_layouts = std::move(impl->set_layouts);
+
+    m_deferred_releases.push(get_release_value(), [device = m_device.get_handle(), resources = m_resources.get(),
+                                                   handle = impl->handle, layout_key = impl->layout_key,
+                                                   set_layouts = std::move(owned_set_layouts)] {
+      vkDestroyPipeline(device, handle, nullptr);
+      release_pipeline_layout(device, *resources, layout_key);
+      for (const auto layout : set_layouts)
+        release_binding_layout(device, *resources, layout);
+    });
+    m_resources->pipelines.destroy(p);
+  }
+
+  Result<BindingLayout> Context::get_pipeline_binding_layout(Pipeline pipeline, u32 set)
+  {
+    const auto impl = m_resources->pipelines.get(pipeline);
+    if IA_B_UNLIKELY (set >= impl->set_layouts.size())
+      return fail("Pipeline uses {} descriptor sets, set {} was requested", impl->set_layouts.size(), set);
+    return impl->set_layouts[set];
+  }
+
+  auto Context::resolve_pipeline_layout(std::span<const Shader> shaders, std::span<const BindingLayout> layouts,
+                                        u32 push_constant_size, EShaderStage push_constant_stages,
+                                        MutRef<PipelineImpl> pipeline) -> Result<void>
+  {
+    Mut<Vec<const ShaderImpl *>> shader_impls;
+    Mut<Vec<const ShaderReflection *>> reflections;
+    for (const auto shader : shaders)
+    {
+      shader_impls.push_back(m_resources->shaders.get(shader));
+      reflections.push_back(&shader_impls.back()->reflection);
+    }
+
+    // Whatever was acquired so far is released again when resolving fails part way.
+    const auto resolve = [&]() -> Result<void> {
+      if (layouts.empty())
+      {
+        pipeline.owns_set_layouts = true;
+        const auto sets = AU_TRY(merge_shader_bindings(reflections));
+        for (const auto &entries : sets)
+          pipeline.set_layouts.push_back(AU_TRY(acquire_binding_layout(m_device.get_handle(), *m_resources, entries)));
+      }
+      else
+        pipeline.set_layouts.assign(layouts.begin(), layouts.end());
+
+      Mut<VkShaderStageFlags> push_constant_stage_flags = map_shader_stages(push_constant_stages);
+      if (push_constant_size == 0)
+      {
+        push_constant_stage_flags = 0;
+        for (const auto *shader : shader_impls)
+        {
+          if (shader->reflection.push_constant_size == 0)
+            continue;
+          push_constant_size = std::max(push_constant_size, shader->reflection.push_constant_size);
+          push_constant_stage_flags |= shader->stage_create_info.stage;
+        }
+      }
+
+      const VkPushConstantRange push_constant_range{
+          .stageFlags = push_constant_size ? push_constant_stage_flags : 0u,
+          .offset = 0,
+          .size = push_constant_size,
+      };
+      return acquire_pipeline_layout(m_device.get_handle(), *m_resources, pipeline.set_layouts, push_constant_range,
+                                     pipeline);
+    };
+
+    const auto result = resolve();
+    if IA_B_UNLIKELY (!result)
+      discard_pipeline_layout(pipeline);
+    return result;
+  }
+
+  auto Context::discard_pipeline_layout(MutRef<PipelineImpl> pipeline) -> void
+  {
+    if (pipeline.layout != VK_NULL_HANDLE)
+      release_pipeline_layout(m_device.get_handle(), *m_resources, pipeline.layout_key);
+    if (pipeline.owns_set_layouts)
+    {
+      for (const auto layout : pipeline.set_layouts)
+        release_binding_layout(m_device.get_handle(), *m_resources, layout);
+    }
+    pipeline.layout = VK_NULL_HANDLE;
+    pipeline.set_layouts.clear();
+    pipeline.owns_set_layouts = false;
+  }
+
+  bool Context::save_pipeline_cache()
+  {
+    const auto result = m_pipeline_cache.save();
+    if IA_B_UNLIKELY (!result)
+    {
+      GPU_LOG_ERROR("Failed to save the pipeline cache: {}", result.error());
+      return false;
+    }
+    return true;
+  }
+
+  void Context::update_host_visible_buffer(Buffer buffer, u64 offset, std::span<const u8> data)
+  {
+    MutRef<BufferImpl> impl = *m_resources->buffers.get(buffer);
+    assert(offset + data.size() <= impl.size);
+
+    // Uncached memory is written with full-line streaming stores, cached memory only once the copy is too large to stay
+    // in the caches anyway.
+    if (!impl.is_host_cached || data.size() >= STREAM_COPY_CACHED_THRESHOLD)
+      stream_copy(static_cast<u8 *>(impl.map()) + offset, data.data(), data.size());
+    else
+      memcpy(static_cast<u8 *>(impl.map()) + offset, data.data(), data.size());
+    vmaFlushAllocation(impl.vma_allocator, impl.allocation, impl.offset + offset, data.size());
+    impl.unmap();
+  }
+
+  void Context::read_host_visible_buffer(Buffer buffer, u64 offset, std::span<u8> data)
+  {
+    MutRef<BufferImpl> impl = *m_resources->buffers.get(buffer);
+    assert(offset + data.size() <= impl.size);
+
+    vmaInvalidateAllocation(impl.vma_allocator, impl.allocation, impl.offset + offset, data.size());
+    memcpy(data.data(), static_cast<const u8 *>(impl.map()) + offset, data.size());
+    impl.unmap();
+  }
+
+  void *Context::get_host_visible_pointer(Buffer buffer, u64 offset)
+  {
+    Ref<BufferImpl> impl = *m_resources->buffers.get(buffer);
+    assert(offset <= impl.size);
+
+    return impl.mapped_data ? static_cast<u8 *>(impl.mapped_data) + offset : nullptr;
+  }
+
+  void Context::flush_host_visible_buffer(Buffer buffer, u64 offset, u64 size)
+  {
+    Ref<BufferImpl> impl = *m_resources->buffers.get(buffer);
+    assert(offset + size <= impl.size);
+
+    vmaFlushAllocation(impl.vma_allocator, impl.allocation, impl.offset + offset, size);
+  }
+
+  Result<ReadbackTicket> Context::read_buffer_async(CmdListType *cmd, Buffer buffer, u64 offset, u64 size)
+  {
+    Ref<BufferImpl> impl = *m_resources->buffers.get(buffer);
+    assert(size > 0 && offset + size <= impl.size);
+
+    const auto allocation = AU_TRY(m_readback_ring->allocate(cmd->get_handle(), size));
+
+    cmd->transition_buffer(buffer, EResourceState::TransferSrc);
+    cmd->flush_transitions();
+
+    const VkBufferCopy copy{
+        .srcOffset = impl.offset + offset,
+        .dstOffset = allocation.offset,
+        .size = size,
+    };
+    vkCmdCopyBuffer(cmd->get_handle(), impl.handle, allocation.buffer, 1, &copy);
+
+    // Host reads only see the copy through a dependency into the host domain, waiting on the timeline is not enough.
+    const VkBufferMemoryBarrier2 barrier{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+        .srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+        .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        .dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT,
+        .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = allocation.buffer,
+        .offset = allocation.offset,
+        .size = size,
+    };
+    const VkDependencyInfo dependency_info{
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .bufferMemoryBarrierCount = 1,
+        .pBufferMemoryBarriers = &barrier,
+    };
+    vkCmdPipelineBarrier2(cmd->get_handle(), &dependency_info);
+
+    return allocation.ticket;
+  }
+
+  std::span<const u8> Context::get_readback_data(ReadbackTicket ticket)
+  {
+    return m_readback_ring->get_data(ticket, m_main_timeline.get_completed_value(),
+                                     m_async_compute_timeline.get_completed_value());
+  }
+
+  void Context::release_readback(ReadbackTicket ticket)
+  {
+    m_readback_ring->release(ticket, m_main_timeline.get_completed_value(),
+                             m_async_compute_timeline.get_completed_value());
+  }
+
+  bool Context::update_texture(Texture texture, std::span<const u8> data,
+                               std::span<const BufferTextureCopyRegion> regions)
+  {
+    const auto impl = m_resources->textures.get(texture);
+
+    // Copy offsets must be a multiple of both 4 and the texel block size (12 for the RGB32 formats).
+    const u32 texel_size = impl->is_compressed_data ? get_compressed_format_block_size(impl->format)
+                                                    : get_uncompressed_pixel_size(impl->format);
+    const u64 alignment = std::lcm<u64>(16, texel_size ? texel_size : 4);
+
+    const auto staging = prepare_staging_memory(data.size(), alignment);
+    if IA_B_UNLIKELY (!staging)
+    {
+      GPU_LOG_ERROR("Failed to allocate {} bytes of staging memory for a texture upload", data.size());
+      return false;
+    }
+
+    stream_copy(staging->mapped, data.data(), data.size());
+    m_staging_ring.flush(*staging, data.size());
+
+    Mut<Vec<BufferTextureCopyRegion>> staged_regions(regions.begin(), regions.end());
+    if (staged_regions.empty())
+    {
+      staged_regions.push_back({
+          .texture = texture,
+          .layer_count = impl->array_layer_count,
+          .width = impl->extent.width,
+          .height = impl->extent.height,
+          .depth = impl->extent.depth,
+      });
+    }
+    for (auto &region : staged_regions)
+    {
+      region.buffer_offset += staging->offset;
+      if (!region.texture)
+        region.texture = texture;
+    }
+
+    auto cmd = begin_upload_commands();
+    if IA_B_UNLIKELY (!cmd)
+    {
+      GPU_LOG_ERROR("Failed to record texture upload");
+      return false;
+    }
+
+    cmd->copy_buffer_to_texture(staging->buffer, staged_regions);
+    cmd->transition_texture(texture, EResourceState::GeneralRead);
+    cmd->flush_transitions();
+    cmd->collect_counters(m_frame_counters);
+
+    return true;
+  }
+
+  bool Context::generate_mipmaps(Texture texture)
+  {
+    const auto impl = m_resources->textures.get(texture);
+    if (impl->is_compressed_data)
+    {
+      GPU_LOG_ERROR("Mipmaps can not be generated for block compressed textures");
+      return false;
+    }
+
+    auto cmd = begin_upload_commands();
+    if IA_B_UNLIKELY (!cmd)
+    {
+      GPU_LOG_ERROR("Failed to record mipmap generation");
+      return false;
+    }
+
+    for (Mut<u32> mip = 1; mip < impl->mip_levels; mip++)
+    {
+      cmd->transition_texture(texture, EResourceState::TransferSrc, mip - 1, 1, 0, 0);
+      cmd->transition_texture(texture, EResourceState::TransferDst, mip, 1, 0, 0);
+
+      const TextureBlitRegion region{
+          .src_mip_level = mip - 1,
+          .src_layer_count = impl->array_layer_count,
+          .src_width = std::max(1u, impl->extent.width >> (mip - 1)),
+          .src_height = std::max(1u, impl->extent.height >> (mip - 1)),
+          .src_depth = std::max(1u, impl->extent.depth >> (mip - 1)),
+          .dst_mip_level = mip,
+          .dst_layer_count = impl->array_layer_count,
+          .dst_width = std::max(1u, impl->extent.width >> mip),
+          .dst_height = std::max(1u, impl->extent.height >> mip),
+          .dst_depth = std::max(1u, impl->extent.depth >> mip),
+      };
+      cmd->blit_texture(texture, EResourceState::TransferSrc, texture, EResourceState::TransferDst, {&region, 1},
+                        true);
+    }
+
+    cmd->transition_texture(texture, EResourceState::GeneralRead);
+    cmd->flush_transitions();
+    cmd->collect_counters(m_frame_counters);
+
+    return true;
+  }
+
+  Sampler Context::get_default_sampler()
+  {
+    return m_default_sampler;
+  }
+
+  u32 Context::get_buffer_size(Buffer b)
+  {
+    return (u32) m_resources->buffers.get(b)->size;
+  }
+
+  TextureInfo Context::get_texture_info(Texture t)
+  {
+    const auto impl = m_resources->textures.get(t);
+    return {
+        .width = impl->extent.width,
+        .height = impl->extent.height,
+        .depth = impl->extent.depth,
+        .layer_count = impl->array_layer_count,
+        .level_count = impl->mip_levels,
+        .format = impl->format,
+    };
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,348 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/context.hpp>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  struct TransientPlacement
+  {
+    VkMemoryRequirements requirements;
+    u32 first_use;
+    u32 last_use;
+    bool is_texture;
+    u32 index;
+    u32 group;
+    u64 offset;
+  };
+
+  // Resources that can share a heap: images and buffers are kept apart so that bufferImageGranularity never
+  // matters, and the memory types have to agree.
+  struct TransientGroup
+  {
+    bool is_texture;
+    u32 memory_type_bits;
+    u64 size;
+    u64 alignment;
+    VmaAllocation heap;
+  };
+
+  static auto align_up(u64 value, u64 alignment) -> u64
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  static auto lifetimes_overlap(Ref<TransientPlacement> a, Ref<TransientPlacement> b) -> bool
+  {
+    return a.first_use <= b.last_use && b.first_use <= a.last_use;
+  }
+
+  // Greedy first-fit packing, largest resources first: each resource takes the lowest offset that does not overlap
+  // the memory of an already placed resource alive at the same time. Returns the heap size.
+  static auto pack_group(MutRef<Vec<TransientPlacement>> placements, u32 group) -> u64
+  {
+    Mut<Vec<u32>> order;
+    for (Mut<u32> i = 0; i < (u32) placements.size(); i++)
+    {
+      if (placements[i].group == group)
+        order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+      return placements[a].requirements.size > placements[b].requirements.size;
+    });
+
+    Mut<Vec<std::pair<u64, u64>>> occupied;
+    Mut<u64> heap_size = 0;
+    for (Mut<size_t> i = 0; i < order.size(); i++)
+    {
+      MutRef<TransientPlacement> placement = placements[order[i]];
+
+      occupied.clear();
+      for (Mut<size_t> j = 0; j < i; j++)
+      {
+        Ref<TransientPlacement> placed = placements[order[j]];
+        if (lifetimes_overlap(placement, placed))
+          occupied.push_back({placed.offset, placed.offset + placed.requirements.size});
+      }
+      std::sort(occupied.begin(), occupied.end());
+
+      Mut<u64> offset = 0;
+      for (const auto &[begin, end] : occupied)
+      {
+        if (align_up(offset, placement.requirements.alignment) + placement.requirements.size <= begin)
+          break;
+        offset = std::max(offset, end);
+      }
+
+      placement.offset = align_up(offset, placement.requirements.alignment);
+      heap_size = std::max(heap_size, placement.offset + placement.requirements.size);
+    }
+
+    return heap_size;
+  }
+
+  bool Context::create_transient_resources(std::span<const TransientTextureDesc> texture_descs,
+                                           std::span<Texture> out_textures,
+                                           std::span<const TransientBufferDesc> buffer_descs,
+                                           std::span<Buffer> out_buffers)
+  {
+    assert(out_textures.size() >= texture_descs.size());
+    assert(out_buffers.size() >= buffer_descs.size());
+
+    MutRef<FrameContext> frame = open_frame();
+    const VkDevice device = m_device.get_handle();
+
+    Mut<Vec<VkImageCreateInfo>> image_create_infos;
+    image_create_infos.reserve(texture_descs.size());
+
+    Mut<Vec<TransientPlacement>> placements;
+    placements.reserve(texture_descs.size() + buffer_descs.size());
+
+    for (Mut<u32> i = 0; i < texture_descs.size(); i++)
+    {
+      Ref<TransientTextureDesc> desc = texture_descs[i];
+      if IA_B_UNLIKELY (desc.first_use > desc.last_use)
+      {
+        GPU_LOG_ERROR("Transient texture \"{}\" ends before it starts",
+                      desc.texture.debug_name ? desc.texture.debug_name : "");
+        return false;
+      }
+
+      image_create_infos.push_back(build_texture_create_info(desc.texture));
+
+      const VkDeviceImageMemoryRequirements requirements_info{
+          .sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS,
+          .pCreateInfo = &image_create_infos.back(),
+      };
+      Mut<VkMemoryRequirements2> requirements{.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2};
+      vkGetDeviceImageMemoryRequirements(device, &requirements_info, &requirements);
+
+      placements.push_back({
+          .requirements = requirements.memoryRequirements,
+          .first_use = desc.first_use,
+          .last_use = desc.last_use,
+          .is_texture = true,
+          .index = i,
+      });
+    }
+
+    for (Mut<u32> i = 0; i < buffer_descs.size(); i++)
+    {
+      Ref<TransientBufferDesc> desc = buffer_descs[i];
+      if IA_B_UNLIKELY (desc.first_use > desc.last_use || desc.buffer.host_visible)
+      {
+        GPU_LOG_ERROR("Transient buffer \"{}\" ends before it starts or is host visible",
+                      desc.buffer.debug_name ? desc.buffer.debug_name : "");
+        return false;
+      }
+
+      const VkBufferCreateInfo buffer_create_info = build_buffer_create_info(desc.buffer);
+      const VkDeviceBufferMemoryRequirements requirements_info{
+          .sType = VK_STRUCTURE_TYPE_DEVICE_BUFFER_MEMORY_REQUIREMENTS,
+          .pCreateInfo = &buffer_create_info,
+      };
+      Mut<VkMemoryRequirements2> requirements{.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2};
+      vkGetDeviceBufferMemoryRequirements(device, &requirements_info, &requirements);
+
+      placements.push_back({
+          .requirements = requirements.memoryRequirements,
+          .first_use = desc.first_use,
+          .last_use = desc.last_use,
+          .is_texture = false,
+          .index = i,
+      });
+    }
+
+    Mut<Vec<TransientGroup>> groups;
+    for (auto &placement : placements)
+    {
+      Mut<u32> group = 0;
+      while (group < groups.size() && (groups[group].is_texture != placement.is_texture ||
+                                       groups[group].memory_type_bits != placement.requirements.memoryTypeBits))
+        group++;
+
+      if (group == groups.size())
+        groups.push_back({
+            .is_texture = placement.is_texture,
+            .memory_type_bits = placement.requirements.memoryTypeBits,
+            .alignment = 1,
+        });
+
+      placement.group = group;
+      groups[group].alignment = std::max(groups[group].alignment, placement.requirements.alignment);
+    }
+
+    m_transient_stats.requested_bytes = 0;
+    m_transient_stats.packed_bytes = 0;
+    for (const auto &placement : placements)
+      m_transient_stats.requested_bytes += placement.requirements.size;
+
+    for (Mut<u32> i = 0; i < groups.size(); i++)
+    {
+      MutRef<TransientGroup> group = groups[i];
+      group.size = pack_group(placements, i);
+      m_transient_stats.packed_bytes += group.size;
+
+      auto heap = acquire_transient_heap(frame, group.memory_type_bits, group.size, group.alignment);
+      if IA_B_UNLIKELY (!heap)
+      {
+        GPU_LOG_ERROR("Failed to allocate a {} byte transient heap: {}", group.size, heap.error());
+        return false;
+      }
+      group.heap = *heap;
+    }
+
+    const VmaAllocator allocator = m_device.get_allocator();
+    for (const auto &placement : placements)
+    {
+      const VmaAllocation heap = groups[placement.group].heap;
+
+      if (placement.is_texture)
+      {
+        Ref<TextureDesc> desc = texture_descs[placement.index].texture;
+
+        Mut<TextureImpl> texture{};
+        texture.vma_allocator = allocator;
+        texture.is_aliased = true;
+        if IA_B_UNLIKELY (vmaCreateAliasingImage2(allocator, heap, placement.offset,
+                                                  &image_create_infos[placement.index], &texture.handle) != VK_SUCCESS)
+        {
+          GPU_LOG_ERROR("Failed to create transient texture \"{}\"", desc.debug_name ? desc.debug_name : "");
+          return false;
+        }
+
+        const Texture handle = register_texture(desc, image_create_infos[placement.index], std::move(texture));
+        if IA_B_UNLIKELY (!handle)
+          return false;
+
+        out_textures[placement.index] = handle;
+        frame.transient_textures.push_back(handle);
+      }
+      else
+      {
+        Ref<BufferDesc> desc = buffer_descs[placement.index].buffer;
+
+        const VkBufferCreateInfo buffer_create_info = build_buffer_create_info(desc);
+        Mut<VkBuffer> buffer{};
+        if IA_B_UNLIKELY (vmaCreateAliasingBuffer2(allocator, heap, placement.offset, &buffer_create_info, &buffer) !=
+                          VK_SUCCESS)
+        {
+          GPU_LOG_ERROR("Failed to create transient buffer \"{}\"", desc.debug_name ? desc.debug_name : "");
+          return false;
+        }
+
+        const Buffer handle = register_buffer(desc, buffer, VK_NULL_HANDLE, VmaAllocationInfo{});
+        m_resources->buffers.get(handle)->is_aliased = true;
+
+        out_buffers[placement.index] = handle;
+        frame.transient_buffers.push_back(handle);
+      }
+    }
+
+    return true;
+  }
+
+  TransientMemoryStats Context::get_transient_memory_stats()
+  {
+    Mut<TransientMemoryStats> stats = m_transient_stats;
+    stats.heap_bytes = 0;
+    for (const auto &frame : m_frames)
+    {
+      for (const auto &heap : frame.transient_heaps)
+        stats.heap_bytes += heap.size;
+    }
+    return stats;
+  }
+
+  auto Context::release_transient_resources(MutRef<FrameContext> frame) -> void
+  {
+    // Only called once the slot's submission has finished, nothing can still reference these.
+    const VkDevice device = m_device.get_handle();
+
+    for (const auto texture : frame.transient_textures)
+    {
+      const auto impl = m_resources->textures.get(texture);
+      vkDestroyImageView(device, impl->view_handle, nullptr);
+      vkDestroyImage(device, impl->handle, nullptr);
+      if (m_bindless_heap)
+        m_bindless_heap->remove_texture(impl->bindless_index);
+      m_resources->textures.destroy(texture);
+    }
+    frame.transient_textures.clear();
+
+    for (const auto buffer : frame.transient_buffers)
+    {
+      const auto impl = m_resources->buffers.get(buffer);
+      vkDestroyBuffer(device, impl->handle, nullptr);
+      if (m_bindless_heap)
+        m_bindless_heap->remove_buffer(impl->bindless_index);
+      m_resources->buffers.destroy(buffer);
+    }
+    frame.transient_buffers.clear();
+
+    std::erase_if(frame.transient_heaps, [&](Ref<FrameContext::TransientHeap> heap) {
+      if (heap.in_use)
+        return false;
+      vmaFreeMemory(m_device.get_allocator(), heap.allocation);
+      return true;
+    });
+    for (auto &heap : frame.transient_heaps)
+      heap.in_use = false;
+  }
+
+  auto Context::acquire_transient_heap(MutRef<FrameContext> frame, u32 memory_type_bits, u64 size, u64 alignment)
+      -> Result<VmaAllocation>
+  {
+    // Smallest idle heap that fits. Any heap allocated for the same memory type bits has a suitable memory type.
+    Mut<FrameContext::TransientHeap *> best = nullptr;
+    for (auto &heap : frame.transient_heaps)
+    {
+      if (heap.in_use || heap.memory_type_bits != memory_type_bits || heap.size < size || heap.alignment < alignment)
+        continue;
+      if (!best || heap.size < best->size)
+        best = &heap;
+    }
+
+    if (best)
+    {
+      best->in_use = true;
+      return best->allocation;
+    }
+
+    const VkMemoryRequirements requirements{
+        .size = size,
+        .alignment = alignment,
+        .memoryTypeBits = memory_type_bits,
+    };
+    const VmaAllocationCreateInfo allocation_create_info{
+        .preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    };
+
+    Mut<VmaAllocation> allocation{};
+    VK_CALL(vmaAllocateMemory(m_device.get_allocator(), &requirements, &allocation_create_info, &allocation, nullptr),
+            "Allocating transient heap");
+
+    frame.transient_heaps.push_back({
+        .allocation = allocation,
+        .size = size,
+        .alignment = alignment,
+        .memory_type_bits = memory_type_bits,
+        .in_use = true,
+    });
+    return allocation;
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,163 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/descriptor_allocator.hpp>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  // Per-set type mix of the first pool, before any usage has been observed.
+  static constexpr u32 DEFAULT_DESCRIPTORS_PER_SET[] = {1, 1, 4, 1};
+
+  static constexpr u32 MIN_DESCRIPTOR_COUNT = 16;
+  static constexpr u32 MAX_POOL_SET_COUNT = 64 * 1024;
+
+  static auto is_pool_exhausted(VkResult result) -> bool
+  {
+    return result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL;
+  }
+
+  auto DescriptorAllocator::initialize(VkDevice device, bool is_transient, u32 initial_set_count) -> Result<void>
+  {
+    m_device = device;
+    m_is_transient = is_transient;
+    m_initial_set_count = std::max(initial_set_count, 1u);
+
+    return create_pool(m_initial_set_count, {});
+  }
+
+  auto DescriptorAllocator::destroy() -> void
+  {
+    for (const auto pool : m_pools)
+      vkDestroyDescriptorPool(m_device, pool, nullptr);
+    m_pools.clear();
+    m_current_pool = 0;
+  }
+
+  auto DescriptorAllocator::allocate(Ref<BindingLayoutImpl> layout) -> Result<Allocation>
+  {
+    Mut<Usage> needed{.set_count = 1};
+    for (const auto &entry : layout.entries)
+      needed.descriptor_counts[(u32) entry.type] += entry.count;
+
+    m_total_usage.set_count++;
+    m_cycle_usage.set_count++;
+    for (Mut<u32> i = 0; i < DESCRIPTOR_TYPE_COUNT; i++)
+    {
+      m_total_usage.descriptor_counts[i] += needed.descriptor_counts[i];
+      m_cycle_usage.descriptor_counts[i] += needed.descriptor_counts[i];
+    }
+
+    Mut<Allocation> allocation{.pool = m_pools[m_current_pool]};
+    Mut<VkResult> result = try_allocate(allocation.pool, layout.handle, allocation.set);
+    if (result == VK_SUCCESS)
+      return allocation;
+    if IA_B_UNLIKELY (!is_pool_exhausted(result))
+      return fail("Allocating a descriptor set failed with code {}", (i64) result);
+
+    // Sets freed since a pool filled up may have made room in it again.
+    if (!m_is_transient)
+    {
+      for (Mut<u32> i = 0; i < m_pools.size(); i++)
+      {
+        if (i == m_current_pool)
+          continue;
+
+        result = try_allocate(m_pools[i], layout.handle, allocation.set);
+        if (result == VK_SUCCESS)
+        {
+          m_current_pool = i;
+          allocation.pool = m_pools[i];
+          return allocation;
+        }
+      }
+    }
+
+    AU_TRY_PURE(create_pool(std::min(m_last_pool_set_count * 2, MAX_POOL_SET_COUNT), needed));
+    m_current_pool = (u32) m_pools.size() - 1;
+
+    allocation.pool = m_pools[m_current_pool];
+    VK_CALL(try_allocate(allocation.pool, layout.handle, allocation.set), "Allocating descriptor set");
+    return allocation;
+  }
+
+  auto DescriptorAllocator::reset() -> Result<void>
+  {
+    if (m_pools.size() == 1)
+      vkResetDescriptorPool(m_device, m_pools[0], 0);
+    else
+    {
+      // Half again as much as the cycle used, so a slightly busier frame still fits into one pool.
+      const u64 set_count = m_cycle_usage.set_count + m_cycle_usage.set_count / 2;
+      destroy();
+      AU_TRY_PURE(create_pool((u32) std::clamp<u64>(set_count, m_initial_set_count, MAX_POOL_SET_COUNT),
+                              m_cycle_usage));
+    }
+
+    m_current_pool = 0;
+    m_cycle_usage = {};
+    return {};
+  }
+
+  auto DescriptorAllocator::create_pool(u32 set_count, Ref<Usage> minimum) -> Result<void>
+  {
+    static constexpr VkDescriptorType TYPES[] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                 VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                                 VK_DESCRIPTOR_TYPE_STORAGE_IMAGE};
+    static_assert(sizeof(TYPES) / sizeof(TYPES[0]) == DESCRIPTOR_TYPE_COUNT);
+
+    Mut<VkDescriptorPoolSize> pool_sizes[DESCRIPTOR_TYPE_COUNT];
+    for (Mut<u32> i = 0; i < DESCRIPTOR_TYPE_COUNT; i++)
+    {
+      const u64 observed = m_total_usage.set_count
+                               ? (m_total_usage.descriptor_counts[i] * set_count + m_total_usage.set_count - 1) /
+                                     m_total_usage.set_count
+                               : (u64) DEFAULT_DESCRIPTORS_PER_SET[i] * set_count;
+      pool_sizes[i] = {
+          .type = TYPES[i],
+          .descriptorCount = (u32) std::max({observed, minimum.descriptor_counts[i], (u64) MIN_DESCRIPTOR_COUNT}),
+      };
+    }
+
+    set_count = std::max<u32>(set_count, (u32) minimum.set_count);
+    const VkDescriptorPoolCreateInfo pool_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .flags = m_is_transient ? 0u : (u32) VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+        .maxSets = set_count,
+        .poolSizeCount = DESCRIPTOR_TYPE_COUNT,
+        .pPoolSizes = pool_sizes,
+    };
+
+    Mut<VkDescriptorPool> pool{};
+    VK_CALL(vkCreateDescriptorPool(m_device, &pool_info, nullptr, &pool), "Creating descriptor pool");
+
+    m_pools.push_back(pool);
+    m_last_pool_set_count = set_count;
+    return {};
+  }
+
+  auto DescriptorAllocator::try_allocate(VkDescriptorPool pool, VkDescriptorSetLayout layout,
+                                         MutRef<VkDescriptorSet> out) -> VkResult
+  {
+    const VkDescriptorSetAllocateInfo allocate_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool = pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &layout,
+    };
+    return vkAllocateDescriptorSets(m_device, &allocate_info, &out);
+  }
+} // namespace ia::gpu::vulkan
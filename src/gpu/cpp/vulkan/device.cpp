@@ -17,38 +17,409 @@
 
 #include <vulkan/device.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <format>
+#include <utility>
+
 namespace ia::gpu::vulkan
 {
-  auto Device::boot(VkInstance instance, VkSurfaceKHR surface, Span<const char *> extensions) -> Result<void>
+  // Score of one physical device, kept in parts for the log. A device that cannot run the backend has a rejection
+  // reason instead and is never picked.
+  struct DeviceScore
   {
-    m_surface = surface;
+    const char *rejection = nullptr;
+    u32 present_queue_family = UINT32_MAX;
+
+    u32 type = 0;
+    u32 memory = 0;
+    u32 queues = 0;
+    u32 subgroup = 0;
+
+    u64 device_local_bytes = 0;
+    u32 subgroup_size = 0;
+    bool has_async_compute = false;
+    bool has_dedicated_transfer = false;
+
+    [[nodiscard]] auto total() const -> u32
+    {
+      return type + memory + queues + subgroup;
+    }
+  };
+
+  static auto supports_bindless(Ref<VkPhysicalDeviceVulkan12Features> f) -> bool
+  {
+    return f.descriptorIndexing && f.runtimeDescriptorArray && f.descriptorBindingPartiallyBound &&
+           f.descriptorBindingSampledImageUpdateAfterBind && f.descriptorBindingStorageImageUpdateAfterBind &&
+           f.descriptorBindingStorageBufferUpdateAfterBind && f.shaderSampledImageArrayNonUniformIndexing &&
+           f.shaderStorageImageArrayNonUniformIndexing && f.shaderStorageBufferArrayNonUniformIndexing;
+  }
+
+  // The device type dominates the score, memory, queues and subgroups only break ties within a type.
+  static auto get_device_type_score(VkPhysicalDeviceType type) -> u32
+  {
+    switch (type)
+    {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+      return 10000;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+      return 5000;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+      return 2500;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:
+      return 100;
+    default:
+      return 0;
+    }
+  }
+
+  static auto get_device_type_name(VkPhysicalDeviceType type) -> const char *
+  {
+    switch (type)
+    {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+      return "discrete";
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+      return "integrated";
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+      return "virtual";
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:
+      return "cpu";
+    default:
+      return "other";
+    }
+  }
+
+  static auto format_uuid(const u8 (&uuid)[VK_UUID_SIZE]) -> std::string
+  {
+    Mut<std::string> result;
+    result.reserve(VK_UUID_SIZE * 2);
+    for (const u8 byte : uuid)
+      result += std::format("{:02x}", byte);
+    return result;
+  }
+
+  // Compares against the 32 hex digits of a UUID, case-insensitive and ignoring dashes.
+  static auto matches_uuid(const u8 (&uuid)[VK_UUID_SIZE], std::string_view text) -> bool
+  {
+    Mut<std::string> digits;
+    for (const char c : text)
+    {
+      if (c != '-')
+        digits += (char) std::tolower((unsigned char) c);
+    }
+    return digits == format_uuid(uuid);
+  }
+
+  static auto contains_case_insensitive(std::string_view haystack, std::string_view needle) -> bool
+  {
+    const auto it = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(), [](char a, char b) {
+      return std::tolower((unsigned char) a) == std::tolower((unsigned char) b);
+    });
+    return it != haystack.end();
+  }
+
+  static auto score_physical_device(VkPhysicalDevice pd, Ref<VkPhysicalDeviceProperties> props,
+                                    Ref<VkPhysicalDeviceSubgroupProperties> subgroup_props, VkSurfaceKHR surface,
+                                    Span<const char *> extensions, bool enable_bindless) -> DeviceScore
+  {
+    Mut<DeviceScore> score{};
+
+    if (props.apiVersion < VULKAN_API_VERSION)
+    {
+      score.rejection = "Vulkan 1.3 is not supported";
+      return score;
+    }
+
+    Mut<Vec<VkExtensionProperties>> available_extensions;
+    VK_ENUM_CALL(vkEnumerateDeviceExtensionProperties, available_extensions, pd, nullptr);
+    for (const char *extension : extensions)
+    {
+      const bool found = std::any_of(available_extensions.begin(), available_extensions.end(),
+                                     [&](Ref<VkExtensionProperties> available) {
+                                       return !strcmp(available.extensionName, extension);
+                                     });
+      if (!found)
+      {
+        score.rejection = "a required extension is missing";
+        return score;
+      }
+    }
 
-    AU_TRY_PURE(initialize_device(instance, extensions));
-
-    const VkDescriptorPoolSize pool_sizes[] = {{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1024},
-                                               {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1024},
-                                               {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4096},
-                                               {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1024}};
-    const VkDescriptorPoolCreateInfo pool_info{
-        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-        .maxSets = 1000,
-        .poolSizeCount = 4,
-        .pPoolSizes = pool_sizes,
+    Mut<VkPhysicalDeviceVulkan12Features> vulkan12_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+    };
+    Mut<VkPhysicalDeviceVulkan13Features> vulkan13_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES,
+        .pNext = &vulkan12_features,
+    };
+    Mut<VkPhysicalDeviceFeatures2> features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext = &vulkan13_features,
     };
-    VK_CALL(vkCreateDescriptorPool(m_handle, &pool_info, nullptr, m_descriptor_pool.ptr()),
-            "Failed to create descriptor pool");
+    vkGetPhysicalDeviceFeatures2(pd, &features);
+
+    if (!vulkan12_features.timelineSemaphore || !vulkan13_features.synchronization2 ||
+        !vulkan13_features.dynamicRendering)
+    {
+      score.rejection = "timeline semaphores, synchronization2 or dynamic rendering are missing";
+      return score;
+    }
+    if (enable_bindless && !supports_bindless(vulkan12_features))
+    {
+      score.rejection = "bindless was requested, but descriptor indexing is missing";
+      return score;
+    }
+
+    Mut<Vec<VkQueueFamilyProperties>> queue_family_props;
+    VK_ENUM_CALL(vkGetPhysicalDeviceQueueFamilyProperties, queue_family_props, pd);
+
+    Mut<bool> has_compute = false;
+    for (Mut<u32> i = 0; i < queue_family_props.size(); i++)
+    {
+      const VkQueueFlags flags = queue_family_props[i].queueFlags;
+      has_compute |= (flags & VK_QUEUE_COMPUTE_BIT) != 0;
+      if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT))
+        score.has_async_compute = true;
+      if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+        score.has_dedicated_transfer = true;
+
+      if (surface && score.present_queue_family == UINT32_MAX && (flags & VK_QUEUE_GRAPHICS_BIT))
+      {
+        Mut<VkBool32> supports_present = VK_FALSE;
+        vkGetPhysicalDeviceSurfaceSupportKHR(pd, i, surface, &supports_present);
+        if (supports_present)
+          score.present_queue_family = i;
+      }
+    }
+
+    if (!has_compute)
+    {
+      score.rejection = "no queue family supports compute";
+      return score;
+    }
+    if (surface && score.present_queue_family == UINT32_MAX)
+    {
+      score.rejection = "no graphics queue family can present to the surface";
+      return score;
+    }
+
+    Mut<VkPhysicalDeviceMemoryProperties> memory_props{};
+    vkGetPhysicalDeviceMemoryProperties(pd, &memory_props);
+    for (Mut<u32> i = 0; i < memory_props.memoryHeapCount; i++)
+    {
+      if (memory_props.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+        score.device_local_bytes = std::max(score.device_local_bytes, (u64) memory_props.memoryHeaps[i].size);
+    }
+
+    // Wider subgroups and the compute subgroup operations shaders commonly use (reductions, ballots, shuffles).
+    score.subgroup_size = subgroup_props.subgroupSize;
+    const bool has_compute_subgroups = (subgroup_props.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) != 0;
+    if (has_compute_subgroups)
+    {
+      score.subgroup = (u32) std::bit_width(std::min(subgroup_props.subgroupSize, 128u)) * 5;
+      for (const auto op : {VK_SUBGROUP_FEATURE_ARITHMETIC_BIT, VK_SUBGROUP_FEATURE_BALLOT_BIT,
+                             VK_SUBGROUP_FEATURE_SHUFFLE_BIT})
+      {
+        if (subgroup_props.supportedOperations & op)
+          score.subgroup += 10;
+      }
+    }
+
+    score.type = get_device_type_score(props.deviceType);
+    score.memory = (u32) std::min<u64>(score.device_local_bytes >> 30, 1024); // a point per GiB
+    score.queues = (score.has_async_compute ? 200 : 0) + (score.has_dedicated_transfer ? 100 : 0);
+    return score;
+  }
+
+  auto Device::boot(VkInstance instance, VkSurfaceKHR surface, Span<const char *> extensions, bool enable_bindless,
+                    bool enable_profiling, Ref<DeviceSelection> selection, u64 device_memory_limit) -> Result<void>
+  {
+    m_surface = surface;
+
+    AU_TRY_PURE(
+        initialize_device(instance, extensions, enable_bindless, enable_profiling, selection, device_memory_limit));
 
     return {};
   }
 
   auto Device::wait_idle() -> void
   {
-    vkDeviceWaitIdle(m_handle);
+    if (m_handle != VK_NULL_HANDLE)
+      vkDeviceWaitIdle(m_handle);
+  }
+
+  auto Device::destroy() -> void
+  {
+    if (m_handle == VK_NULL_HANDLE)
+      return;
+
+    wait_idle();
+
+    // Moved out one at a time, the fence and the allocator need the device they were made with.
+    {
+      const auto fence = std::move(m_command_submit_fence);
+    }
+    {
+      const auto allocator = std::move(m_allocator);
+    }
+    {
+      const auto handle = std::move(m_handle);
+    }
+  }
+
+  auto Device::get_calibrated_timestamps(MutRef<u64> device_ticks, MutRef<u64> host_ns) const -> bool
+  {
+#if IA_PLATFORM_LINUX || IA_PLATFORM_ANDROID
+    if (!m_get_calibrated_timestamps)
+      return false;
+
+    const VkCalibratedTimestampInfoKHR infos[2]{
+        {.sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR, .timeDomain = VK_TIME_DOMAIN_DEVICE_KHR},
+        {.sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR, .timeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_KHR},
+    };
+    Mut<u64> values[2]{};
+    Mut<u64> max_deviation{};
+    if (m_get_calibrated_timestamps(m_handle, 2, infos, values, &max_deviation) != VK_SUCCESS)
+      return false;
+
+    device_ticks = values[0];
+    host_ns = values[1];
+    return true;
+#else
+    AU_UNUSED(device_ticks);
+    AU_UNUSED(host_ns);
+    return false;
+#endif
   }
 
-  auto Device::initialize_device(VkInstance instance, Span<const char *> extensions) -> Result<void>
+  auto Device::initialize_device(VkInstance instance, Span<const char *> extensions, bool enable_bindless,
+                                 bool enable_profiling, Ref<DeviceSelection> selection, u64 device_memory_limit)
+      -> Result<void>
   {
-    m_physical_device = AU_TRY(select_physical_device(instance));
+    m_physical_device = AU_TRY(select_physical_device(instance, extensions, enable_bindless, selection));
+
+    Mut<Vec<VkExtensionProperties>> available_extensions;
+    VK_ENUM_CALL(vkEnumerateDeviceExtensionProperties, available_extensions, m_physical_device, nullptr);
+    const auto has_extension = [&](const char *name) {
+      return std::any_of(available_extensions.begin(), available_extensions.end(),
+                         [&](Ref<VkExtensionProperties> extension) { return !strcmp(extension.extensionName, name); });
+    };
+
+    // Profiling resets its query pools from the host. Host and device timestamps can only be lined up with the
+    // calibrated timestamps extension, on the monotonic clock steady_clock uses, which is optional.
+    Mut<Vec<const char *>> enabled_extensions(extensions.begin(), extensions.end());
+    Mut<const char *> calibration_extension = nullptr;
+    if (enable_profiling)
+    {
+      Mut<VkPhysicalDeviceVulkan12Features> supported_vulkan12_features{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+      };
+      Mut<VkPhysicalDeviceFeatures2> supported_features{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+          .pNext = &supported_vulkan12_features,
+      };
+      vkGetPhysicalDeviceFeatures2(m_physical_device, &supported_features);
+
+      if (supported_vulkan12_features.hostQueryReset)
+        m_is_profiling_enabled = true;
+      else
+        GPU_LOG_WARN("GPU profiling was requested, but the device cannot reset queries from the host");
+    }
+
+#if IA_PLATFORM_LINUX || IA_PLATFORM_ANDROID
+    if (m_is_profiling_enabled)
+    {
+      if (has_extension(VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME))
+        calibration_extension = VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+      else if (has_extension(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME))
+        calibration_extension = VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+
+      if (calibration_extension)
+      {
+        const bool is_khr = !strcmp(calibration_extension, VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+        const auto get_domains = is_khr ? vkGetPhysicalDeviceCalibrateableTimeDomainsKHR
+                                        : vkGetPhysicalDeviceCalibrateableTimeDomainsEXT;
+
+        Mut<Vec<VkTimeDomainKHR>> domains;
+        VK_ENUM_CALL(get_domains, domains, m_physical_device);
+        const bool has_device = std::find(domains.begin(), domains.end(), VK_TIME_DOMAIN_DEVICE_KHR) != domains.end();
+        const bool has_host =
+            std::find(domains.begin(), domains.end(), VK_TIME_DOMAIN_CLOCK_MONOTONIC_KHR) != domains.end();
+        if (has_device && has_host)
+          enabled_extensions.push_back(calibration_extension);
+        else
+          calibration_extension = nullptr;
+      }
+    }
+#endif
+
+    // Pipeline statistics queries and conditional rendering are enabled whenever the device has them, neither costs
+    // anything unless used.
+    {
+      Mut<VkPhysicalDeviceConditionalRenderingFeaturesEXT> supported_conditional_rendering{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT,
+      };
+      const bool has_conditional_rendering = has_extension(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
+      Mut<VkPhysicalDeviceFeatures2> supported_features{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+          .pNext = has_conditional_rendering ? &supported_conditional_rendering : nullptr,
+      };
+      vkGetPhysicalDeviceFeatures2(m_physical_device, &supported_features);
+
+      m_is_pipeline_statistics_supported = supported_features.features.pipelineStatisticsQuery;
+      m_is_conditional_rendering_supported = supported_conditional_rendering.conditionalRendering;
+      if (m_is_conditional_rendering_supported)
+        enabled_extensions.push_back(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
+    }
+
+    // Budget queries and allocation priorities are enabled whenever the device has them. Pageable device-local memory
+    // lets the driver move low priority allocations out to host memory under pressure and back once they are used.
+    {
+      m_is_memory_budget_supported = has_extension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+      if (m_is_memory_budget_supported)
+        enabled_extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+      Mut<VkPhysicalDeviceMemoryPriorityFeaturesEXT> supported_memory_priority{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT,
+      };
+      Mut<VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT> supported_pageable_memory{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT,
+          .pNext = &supported_memory_priority,
+      };
+      Mut<VkPhysicalDeviceFeatures2> supported_features{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+          .pNext = &supported_pageable_memory,
+      };
+      vkGetPhysicalDeviceFeatures2(m_physical_device, &supported_features);
+
+      m_is_memory_priority_supported =
+          has_extension(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME) && supported_memory_priority.memoryPriority;
+      m_is_pageable_memory_supported = m_is_memory_priority_supported &&
+                                       has_extension(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME) &&
+                                       supported_pageable_memory.pageableDeviceLocalMemory;
+      if (m_is_memory_priority_supported)
+        enabled_extensions.push_back(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME);
+      if (m_is_pageable_memory_supported)
+        enabled_extensions.push_back(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME);
+    }
+
+    if (enable_bindless)
+    {
+      Mut<VkPhysicalDeviceVulkan12Features> supported_vulkan12_features{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+      };
+      Mut<VkPhysicalDeviceFeatures2> supported_features{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+          .pNext = &supported_vulkan12_features,
+      };
+      vkGetPhysicalDeviceFeatures2(m_physical_device, &supported_features);
+
+      if (!supports_bindless(supported_vulkan12_features))
+        return fail("Bindless descriptors were requested, but the device lacks the descriptor indexing features");
+      m_is_bindless_enabled = true;
+    }
 
     Mut<Vec<VkDeviceQueueCreateInfo>> device_queue_create_infos;
 
@@ -57,16 +428,24 @@ namespace ia::gpu::vulkan
 
     for (Mut<u32> i = 0; i < queue_family_props.size(); i++)
     {
-      const auto &props = queue_family_props[i];
-      if (props.queueFlags & VK_QUEUE_COMPUTE_BIT)
+      if (queue_family_props[i].queueFlags & VK_QUEUE_COMPUTE_BIT)
       {
-        if (m_compute_queue_family == UINT32_MAX)
-          m_compute_queue_family = i;
-        else if (m_graphics_queue_family != UINT32_MAX && i != m_graphics_queue_family)
-        {
-          m_graphics_queue_family = i;
-          break;
-        }
+        m_compute_queue_family = i;
+        break;
+      }
+    }
+
+    // Async compute prefers a compute family without graphics, the hardware queues that run beside the graphics
+    // pipe. Otherwise it asks for one more queue of the main family, which only exists if that family has a spare.
+    const u32 main_queue_family = m_surface ? m_graphics_queue_family : m_compute_queue_family;
+    m_async_compute_queue_family = main_queue_family;
+    for (Mut<u32> i = 0; i < queue_family_props.size(); i++)
+    {
+      const VkQueueFlags flags = queue_family_props[i].queueFlags;
+      if (i != main_queue_family && (flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT))
+      {
+        m_async_compute_queue_family = i;
+        break;
       }
     }
 
@@ -94,6 +473,8 @@ namespace ia::gpu::vulkan
       queue_family_index_map[m_graphics_queue_family]++;
     if (m_compute_queue_family != UINT32_MAX)
       queue_family_index_map[m_compute_queue_family]++;
+    if (m_async_compute_queue_family != UINT32_MAX)
+      queue_family_index_map[m_async_compute_queue_family]++;
     if (m_transfer_queue_family != UINT32_MAX)
       queue_family_index_map[m_transfer_queue_family]++;
 
@@ -125,16 +506,61 @@ namespace ia::gpu::vulkan
         .extendedDynamicState = VK_TRUE,
     };
 
+    Mut<VkPhysicalDeviceConditionalRenderingFeaturesEXT> enable_conditional_rendering_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT,
+        .pNext = &enable_extended_dynamic_state_features,
+        .conditionalRendering = VK_TRUE,
+    };
+
+    Mut<VkPhysicalDeviceVulkan12Features> enable_vulkan12_features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext = m_is_conditional_rendering_supported ? (void *) &enable_conditional_rendering_features
+                                                      : (void *) &enable_extended_dynamic_state_features,
+        .descriptorIndexing = m_is_bindless_enabled,
+        .shaderSampledImageArrayNonUniformIndexing = m_is_bindless_enabled,
+        .shaderStorageBufferArrayNonUniformIndexing = m_is_bindless_enabled,
+        .shaderStorageImageArrayNonUniformIndexing = m_is_bindless_enabled,
+        .descriptorBindingSampledImageUpdateAfterBind = m_is_bindless_enabled,
+        .descriptorBindingStorageImageUpdateAfterBind = m_is_bindless_enabled,
+        .descriptorBindingStorageBufferUpdateAfterBind = m_is_bindless_enabled,
+        .descriptorBindingPartiallyBound = m_is_bindless_enabled,
+        .runtimeDescriptorArray = m_is_bindless_enabled,
+        .hostQueryReset = m_is_profiling_enabled,
+        .timelineSemaphore = VK_TRUE,
+    };
+
     Mut<VkPhysicalDeviceVulkan13Features> enable_vulkan13_features = {
         .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES,
-        .pNext = &enable_extended_dynamic_state_features,
+        .pNext = &enable_vulkan12_features,
         .synchronization2 = VK_TRUE,
         .dynamicRendering = VK_TRUE,
     };
 
+    Mut<VkPhysicalDeviceMemoryPriorityFeaturesEXT> enable_memory_priority_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT,
+        .pNext = &enable_vulkan13_features,
+        .memoryPriority = VK_TRUE,
+    };
+
+    Mut<VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT> enable_pageable_memory_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT,
+        .pNext = &enable_memory_priority_features,
+        .pageableDeviceLocalMemory = VK_TRUE,
+    };
+
+    Mut<void *> enable_features_head = &enable_vulkan13_features;
+    if (m_is_pageable_memory_supported)
+      enable_features_head = &enable_pageable_memory_features;
+    else if (m_is_memory_priority_supported)
+      enable_features_head = &enable_memory_priority_features;
+
     const VkPhysicalDeviceFeatures2 enable_device_features2{
         .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
-        .pNext = &enable_vulkan13_features,
+        .pNext = enable_features_head,
+        .features =
+            {
+                .pipelineStatisticsQuery = m_is_pipeline_statistics_supported,
+            },
     };
 
     const VkDeviceCreateInfo device_create_info{
@@ -143,13 +569,18 @@ namespace ia::gpu::vulkan
         .queueCreateInfoCount = static_cast<u32>(device_queue_create_infos.size()),
         .pQueueCreateInfos = device_queue_create_infos.data(),
         .enabledLayerCount = 0,
-        .enabledExtensionCount = static_cast<u32>(extensions.size()),
-        .ppEnabledExtensionNames = extensions.data(),
+        .enabledExtensionCount = static_cast<u32>(enabled_extensions.size()),
+        .ppEnabledExtensionNames = enabled_extensions.data(),
     };
     VK_CALL(vkCreateDevice(m_physical_device, &device_create_info, nullptr, m_handle.ptr()), "Creating logical device");
 
     volkLoadDevice(m_handle);
 
+    if (calibration_extension)
+      m_get_calibrated_timestamps = !strcmp(calibration_extension, VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)
+                                        ? vkGetCalibratedTimestampsKHR
+                                        : vkGetCalibratedTimestampsEXT;
+
     Mut<HashMap<u32, u32>> tmp_queue_family_index_map;
     if (m_graphics_queue_family != UINT32_MAX)
     {
@@ -165,6 +596,15 @@ namespace ia::gpu::vulkan
 
       vkGetDeviceQueue(m_handle, m_compute_queue_family, q_index, &m_compute_queue);
     }
+    if (m_async_compute_queue_family != UINT32_MAX)
+    {
+      // Never falls back to a queue index that is already taken, sharing the main queue is left to the caller.
+      const u32 q_index = tmp_queue_family_index_map[m_async_compute_queue_family]++;
+      if (q_index < queue_family_props[m_async_compute_queue_family].queueCount)
+        vkGetDeviceQueue(m_handle, m_async_compute_queue_family, q_index, &m_async_compute_queue);
+      else
+        m_async_compute_queue_family = UINT32_MAX;
+    }
     if (m_transfer_queue_family != UINT32_MAX)
     {
       u32 q_index = tmp_queue_family_index_map[m_transfer_queue_family]++;
@@ -181,9 +621,31 @@ namespace ia::gpu::vulkan
     VK_CALL(vkCreateFence(m_handle, &fence_create_info, nullptr, m_command_submit_fence.ptr()),
             "Creating command submit fence");
 
+    // The context's memory ceiling is enforced by VMA as a size limit on every device-local heap, allocations past it
+    // move on to the next suitable memory type like any other failed allocation.
+    Mut<VkPhysicalDeviceMemoryProperties> memory_props{};
+    vkGetPhysicalDeviceMemoryProperties(m_physical_device, &memory_props);
+    Mut<VkDeviceSize> heap_size_limits[VK_MAX_MEMORY_HEAPS];
+    for (Mut<u32> i = 0; i < VK_MAX_MEMORY_HEAPS; i++)
+    {
+      heap_size_limits[i] = VK_WHOLE_SIZE;
+      if (device_memory_limit && i < memory_props.memoryHeapCount &&
+          (memory_props.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+        heap_size_limits[i] = std::min<VkDeviceSize>(device_memory_limit, memory_props.memoryHeaps[i].size);
+    }
+    m_device_memory_limit = device_memory_limit;
+
+    Mut<VmaAllocatorCreateFlags> allocator_flags = 0;
+    if (m_is_memory_budget_supported)
+      allocator_flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    if (m_is_memory_priority_supported)
+      allocator_flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_PRIORITY_BIT;
+
     Mut<VmaAllocatorCreateInfo> allocator_create_info{
+        .flags = allocator_flags,
         .physicalDevice = m_physical_device,
         .device = m_handle,
+        .pHeapSizeLimit = heap_size_limits,
         .instance = instance,
         .vulkanApiVersion = VULKAN_API_VERSION,
     };
@@ -195,52 +657,87 @@ namespace ia::gpu::vulkan
     return {};
   }
 
-  auto Device::select_physical_device(VkInstance instance) -> Result<VkPhysicalDevice>
+  auto Device::select_physical_device(VkInstance instance, Span<const char *> extensions, bool enable_bindless,
+                                      Ref<DeviceSelection> selection) -> Result<VkPhysicalDevice>
   {
-    Mut<VkPhysicalDeviceProperties> props{};
-    Mut<VkPhysicalDeviceFeatures> features{};
     Mut<Vec<VkPhysicalDevice>> physical_devices;
     VK_ENUM_CALL(vkEnumeratePhysicalDevices, physical_devices, instance);
 
-    for (const auto &pd : physical_devices)
-    {
-      vkGetPhysicalDeviceProperties(pd, &props);
-      vkGetPhysicalDeviceFeatures(pd, &features);
+    const bool has_override = selection.index != UINT32_MAX || selection.uuid || selection.name;
 
-      // [IATODO]: IMPL GPU Ranking
+    Mut<u32> best_index = UINT32_MAX;
+    Mut<DeviceScore> best_score{};
+    Mut<VkPhysicalDeviceProperties> best_props{};
 
-      if (m_surface == nullptr)
-      {
-        m_physical_device = pd;
-        break;
-      }
+    for (Mut<u32> i = 0; i < physical_devices.size(); i++)
+    {
+      const VkPhysicalDevice pd = physical_devices[i];
+
+      Mut<VkPhysicalDeviceSubgroupProperties> subgroup_props{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES,
+      };
+      Mut<VkPhysicalDeviceIDProperties> id_props{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES,
+          .pNext = &subgroup_props,
+      };
+      Mut<VkPhysicalDeviceProperties2> props{
+          .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+          .pNext = &id_props,
+      };
+      vkGetPhysicalDeviceProperties2(pd, &props);
+
+      const DeviceScore score =
+          score_physical_device(pd, props.properties, subgroup_props, m_surface, extensions, enable_bindless);
+      const std::string uuid = format_uuid(id_props.deviceUUID);
+
+      if (score.rejection)
+        GPU_LOG_DEBUG("Device {} \"{}\" ({}) is unsuitable: {}", i, props.properties.deviceName, uuid, score.rejection);
       else
-      {
-        Mut<u32> queue_count = 0;
-        vkGetPhysicalDeviceQueueFamilyProperties(pd, &queue_count, nullptr);
-        Mut<Vec<VkQueueFamilyProperties>> queues(queue_count);
-        vkGetPhysicalDeviceQueueFamilyProperties(pd, &queue_count, queues.data());
+        GPU_LOG_DEBUG("Device {} \"{}\" ({}) scores {}", i, props.properties.deviceName, uuid, score.total());
 
-        for (Mut<u32> i = 0; i < queue_count; i++)
-        {
-          Mut<VkBool32> supports_present = VK_FALSE;
-          vkGetPhysicalDeviceSurfaceSupportKHR(pd, i, m_surface, &supports_present);
-
-          if ((queues[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) && supports_present)
-          {
-            m_physical_device = pd;
-            m_graphics_queue_family = i;
-            goto found;
-          }
-        }
+      if (has_override)
+      {
+        Mut<bool> matches = false;
+        if (selection.index != UINT32_MAX)
+          matches = selection.index == i;
+        else if (selection.uuid)
+          matches = matches_uuid(id_props.deviceUUID, selection.uuid);
+        else
+          matches = contains_case_insensitive(props.properties.deviceName, selection.name);
+        if (!matches)
+          continue;
+
+        if (score.rejection)
+          return fail("The requested device \"{}\" is unsuitable: {}", props.properties.deviceName, score.rejection);
       }
+      else if (score.rejection || (best_index != UINT32_MAX && score.total() <= best_score.total()))
+        continue;
+
+      best_index = i;
+      best_score = score;
+      best_props = props.properties;
+      if (has_override)
+        break;
     }
 
-  found:
-    if (m_physical_device == VK_NULL_HANDLE)
+    if (best_index == UINT32_MAX)
+    {
+      if (has_override)
+        return fail("No device matches the requested device override");
       return fail("Failed to find suitable graphics hardware.");
+    }
 
-    GPU_LOG_INFO("Using the hardware device \"{}\"", props.deviceName);
+    m_physical_device = physical_devices[best_index];
+    if (m_surface)
+      m_graphics_queue_family = best_score.present_queue_family;
+
+    GPU_LOG_INFO("Using the {} device {} \"{}\"{}", get_device_type_name(best_props.deviceType), best_index,
+                 best_props.deviceName, has_override ? " (selected by override)" : "");
+    GPU_LOG_INFO("Device score {} = type {} + memory {} ({} MiB device-local) + queues {} (async compute: {}, "
+                 "dedicated transfer: {}) + subgroups {} (size {})",
+                 best_score.total(), best_score.type, best_score.memory, best_score.device_local_bytes >> 20,
+                 best_score.queues, best_score.has_async_compute, best_score.has_dedicated_transfer,
+                 best_score.subgroup, best_score.subgroup_size);
     return m_physical_device;
   }
 } // namespace ia::gpu::vulkan
\ No newline at end of file
@@ -0,0 +1,536 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/frame_graph.hpp>
+
+namespace ia::gpu::vulkan
+{
+  // Mirrors CommandList: only transitions between different states, or into a writable state, reach the GPU.
+  static auto needs_transition(EResourceState old_state, EResourceState new_state) -> bool
+  {
+    if (old_state != new_state)
+      return true;
+
+    switch (new_state)
+    {
+    case EResourceState::TransferDst:
+    case EResourceState::GeneralWrite:
+    case EResourceState::ColorTarget:
+    case EResourceState::DepthTarget:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  auto FrameGraph::overwrites_contents(Ref<Access> access) -> bool
+  {
+    if (access.access == EAccess::ResolveAttachment)
+      return true;
+    return (access.access == EAccess::ColorAttachment || access.access == EAccess::DepthAttachment) && access.clear;
+  }
+
+  auto FrameGraph::PassBuilder::read(Texture texture) -> PassBuilder &
+  {
+    const bool is_transfer = m_graph->m_passes[m_pass].type == EPassType::Transfer;
+    return read(texture, is_transfer ? EResourceState::TransferSrc : EResourceState::GeneralRead);
+  }
+
+  auto FrameGraph::PassBuilder::read(Texture texture, EResourceState state) -> PassBuilder &
+  {
+    m_graph->add_access(m_pass, texture, true, EAccess::Read, state);
+    return *this;
+  }
+
+  auto FrameGraph::PassBuilder::read(Buffer buffer) -> PassBuilder &
+  {
+    const bool is_transfer = m_graph->m_passes[m_pass].type == EPassType::Transfer;
+    return read(buffer, is_transfer ? EResourceState::TransferSrc : EResourceState::GeneralRead);
+  }
+
+  auto FrameGraph::PassBuilder::read(Buffer buffer, EResourceState state) -> PassBuilder &
+  {
+    m_graph->add_access(m_pass, buffer, false, EAccess::Read, state);
+    return *this;
+  }
+
+  auto FrameGraph::PassBuilder::write(Texture texture) -> PassBuilder &
+  {
+    const bool is_transfer = m_graph->m_passes[m_pass].type == EPassType::Transfer;
+    return write(texture, is_transfer ? EResourceState::TransferDst : EResourceState::GeneralWrite);
+  }
+
+  auto FrameGraph::PassBuilder::write(Texture texture, EResourceState state) -> PassBuilder &
+  {
+    m_graph->add_access(m_pass, texture, true, EAccess::Write, state);
+    return *this;
+  }
+
+  auto FrameGraph::PassBuilder::write(Buffer buffer) -> PassBuilder &
+  {
+    const bool is_transfer = m_graph->m_passes[m_pass].type == EPassType::Transfer;
+    return write(buffer, is_transfer ? EResourceState::TransferDst : EResourceState::GeneralWrite);
+  }
+
+  auto FrameGraph::PassBuilder::write(Buffer buffer, EResourceState state) -> PassBuilder &
+  {
+    m_graph->add_access(m_pass, buffer, false, EAccess::Write, state);
+    return *this;
+  }
+
+#if !IAGPU_DISABLE_GRAPHICS
+  auto FrameGraph::PassBuilder::color_attachment(Texture texture, Texture resolve_target) -> PassBuilder &
+  {
+    MutRef<Access> access =
+        m_graph->add_access(m_pass, texture, true, EAccess::ColorAttachment, EResourceState::ColorTarget);
+    access.resolve_target = resolve_target;
+
+    if (resolve_target)
+      m_graph->add_access(m_pass, resolve_target, true, EAccess::ResolveAttachment, EResourceState::ColorTarget);
+    return *this;
+  }
+
+  auto FrameGraph::PassBuilder::clear_color_attachment(Texture texture, f32 r, f32 g, f32 b, f32 a,
+                                                       Texture resolve_target) -> PassBuilder &
+  {
+    color_attachment(texture, resolve_target);
+
+    for (auto it = m_graph->m_passes[m_pass].accesses.rbegin(); it != m_graph->m_passes[m_pass].accesses.rend(); ++it)
+    {
+      if (it->access != EAccess::ColorAttachment)
+        continue;
+      it->clear = true;
+      it->clear_value[0] = r;
+      it->clear_value[1] = g;
+      it->clear_value[2] = b;
+      it->clear_value[3] = a;
+      break;
+    }
+    return *this;
+  }
+
+  auto FrameGraph::PassBuilder::depth_attachment(Texture texture) -> PassBuilder &
+  {
+    m_graph->add_access(m_pass, texture, true, EAccess::DepthAttachment, EResourceState::DepthTarget);
+    return *this;
+  }
+
+  auto FrameGraph::PassBuilder::clear_depth_attachment(Texture texture, f32 depth) -> PassBuilder &
+  {
+    MutRef<Access> access =
+        m_graph->add_access(m_pass, texture, true, EAccess::DepthAttachment, EResourceState::DepthTarget);
+    access.clear = true;
+    access.clear_value[0] = depth;
+    return *this;
+  }
+#endif
+
+  auto FrameGraph::PassBuilder::side_effects() -> PassBuilder &
+  {
+    m_graph->m_passes[m_pass].side_effects = true;
+    return *this;
+  }
+
+  auto FrameGraph::add_compute_pass(const char *name, PassCallback callback) -> PassBuilder
+  {
+    return add_pass(name, EPassType::Compute, std::move(callback));
+  }
+
+  auto FrameGraph::add_transfer_pass(const char *name, PassCallback callback) -> PassBuilder
+  {
+    return add_pass(name, EPassType::Transfer, std::move(callback));
+  }
+
+#if !IAGPU_DISABLE_GRAPHICS
+  auto FrameGraph::add_render_pass(const char *name, PassCallback callback) -> PassBuilder
+  {
+    return add_pass(name, EPassType::Render, std::move(callback));
+  }
+#endif
+
+  auto FrameGraph::import_texture(Texture texture) -> void
+  {
+    m_resources[get_resource(texture, true)].imported = true;
+  }
+
+  auto FrameGraph::import_buffer(Buffer buffer) -> void
+  {
+    m_resources[get_resource(buffer, false)].imported = true;
+  }
+
+  auto FrameGraph::export_texture(Texture texture, EResourceState final_state) -> void
+  {
+    MutRef<Resource> resource = m_resources[get_resource(texture, true)];
+    resource.imported = true;
+    resource.exported = true;
+    resource.final_state = final_state;
+  }
+
+  auto FrameGraph::export_buffer(Buffer buffer, EResourceState final_state) -> void
+  {
+    MutRef<Resource> resource = m_resources[get_resource(buffer, false)];
+    resource.imported = true;
+    resource.exported = true;
+    resource.final_state = final_state;
+  }
+
+  auto FrameGraph::compile() -> Result<void>
+  {
+    m_schedule.clear();
+    m_transitions.clear();
+    m_barrier_point_count = 0;
+    m_compiled = false;
+
+    for (const auto &pass : m_passes)
+    {
+      if IA_B_UNLIKELY (pass.has_conflict)
+        return fail("Frame graph pass '{}' uses a resource in two incompatible ways", pass.name);
+
+#if !IAGPU_DISABLE_GRAPHICS
+      Mut<u32> color_count = 0;
+      Mut<u32> depth_count = 0;
+      for (const auto &access : pass.accesses)
+      {
+        color_count += access.access == EAccess::ColorAttachment;
+        depth_count += access.access == EAccess::DepthAttachment;
+      }
+
+      if IA_B_UNLIKELY (pass.type != EPassType::Render && (color_count || depth_count))
+        return fail("Frame graph pass '{}' declares attachments but is not a render pass", pass.name);
+      if IA_B_UNLIKELY (pass.type == EPassType::Render && ((!color_count && !depth_count) || color_count > 8 ||
+                                                           depth_count > 1))
+        return fail("Frame graph render pass '{}' needs 1-8 color attachments and at most one depth attachment",
+                    pass.name);
+#endif
+    }
+
+    cull_passes();
+    resolve_accesses();
+    place_transitions();
+
+    m_compiled = true;
+    return {};
+  }
+
+  auto FrameGraph::execute(MutRef<CommandList> cmd) -> void
+  {
+    assert(m_compiled && "FrameGraph::compile must succeed before execute");
+
+    Mut<size_t> next_transition = 0;
+    for (Mut<u32> slot = 0; slot < (u32) m_schedule.size(); slot++)
+    {
+      while (next_transition < m_transitions.size() && m_transitions[next_transition].placement == slot)
+        record_transition(cmd, m_transitions[next_transition++]);
+
+      MutRef<Pass> pass = m_passes[m_schedule[slot]];
+      switch (pass.type)
+      {
+      case EPassType::Compute:
+        cmd.begin_compute();
+        pass.callback(&cmd);
+        cmd.end_compute();
+        break;
+
+      case EPassType::Transfer:
+        cmd.flush_transitions();
+        pass.callback(&cmd);
+        break;
+
+#if !IAGPU_DISABLE_GRAPHICS
+      case EPassType::Render: {
+        Mut<ColorAttachment> colors[8]{};
+        Mut<DepthAttachment> depth{};
+        Mut<u32> color_count = 0;
+        Mut<bool> has_depth = false;
+
+        for (const auto &access : pass.accesses)
+        {
+          if (access.access == EAccess::ColorAttachment)
+          {
+            MutRef<ColorAttachment> color = colors[color_count++];
+            color.texture = (Texture) m_resources[access.resource].handle;
+            color.resolve_target = access.resolve_target;
+            color.set_clear_color(access.clear_value[0], access.clear_value[1], access.clear_value[2],
+                                  access.clear_value[3]);
+            color.load_op = access.load_op;
+            color.store_op = access.store_op;
+          }
+          else if (access.access == EAccess::DepthAttachment)
+          {
+            depth.texture = (Texture) m_resources[access.resource].handle;
+            depth.clear_depth = access.clear_value[0];
+            depth.load_op = access.load_op;
+            depth.store_op = access.store_op;
+            has_depth = true;
+          }
+        }
+
+        cmd.begin_rendering(color_count, colors, has_depth ? &depth : nullptr);
+        pass.callback(&cmd);
+        cmd.end_rendering();
+        break;
+      }
+#endif
+      }
+    }
+
+    // Exported final states.
+    while (next_transition < m_transitions.size())
+      record_transition(cmd, m_transitions[next_transition++]);
+    cmd.flush_transitions();
+  }
+
+#if !IAGPU_DISABLE_GRAPHICS
+  auto FrameGraph::get_attachment_ops(u32 pass, Texture texture) const -> std::pair<ELoadOp, EStoreOp>
+  {
+    assert(is_pass_scheduled(pass) && "Attachment ops are only chosen for passes that survived compile()");
+
+    const auto it = m_texture_indices.find(reinterpret_cast<u64>(texture));
+    assert(it != m_texture_indices.end() && "The texture is not used by the graph");
+
+    for (const auto &access : m_passes[pass].accesses)
+    {
+      if (access.resource == it->second && (access.access == EAccess::ColorAttachment ||
+                                            access.access == EAccess::DepthAttachment))
+        return {access.load_op, access.store_op};
+    }
+    assert(false && "The texture is not a color or depth attachment of the pass");
+    return {ELoadOp::Load, EStoreOp::Store};
+  }
+#endif
+
+  auto FrameGraph::reset() -> void
+  {
+    m_passes.clear();
+    m_resources.clear();
+    m_texture_indices.clear();
+    m_buffer_indices.clear();
+    m_schedule.clear();
+    m_transitions.clear();
+    m_barrier_point_count = 0;
+    m_compiled = false;
+  }
+
+  auto FrameGraph::add_pass(const char *name, EPassType type, PassCallback callback) -> PassBuilder
+  {
+    m_compiled = false;
+    m_passes.push_back({
+        .name = name,
+        .type = type,
+        .callback = std::move(callback),
+    });
+    return PassBuilder(this, (u32) (m_passes.size() - 1));
+  }
+
+  auto FrameGraph::add_access(u32 pass_index, void *handle, bool is_texture, EAccess access, EResourceState state)
+      -> MutRef<Access>
+  {
+    MutRef<Pass> pass = m_passes[pass_index];
+    const u32 resource = get_resource(handle, is_texture);
+    const bool is_attachment = access != EAccess::Read && access != EAccess::Write;
+
+    // A resource declared twice by the same pass. Reads and writes fold into one access when they agree on a state, or
+    // when the pass reads back its own storage writes.
+    for (auto &existing : pass.accesses)
+    {
+      if (existing.resource != resource)
+        continue;
+
+      const bool existing_is_attachment = existing.access != EAccess::Read && existing.access != EAccess::Write;
+      const bool read_write =
+          (existing.state == EResourceState::GeneralRead && state == EResourceState::GeneralWrite) ||
+          (existing.state == EResourceState::GeneralWrite && state == EResourceState::GeneralRead);
+      if (is_attachment || existing_is_attachment || (existing.state != state && !read_write))
+      {
+        pass.has_conflict = true;
+        return existing;
+      }
+
+      if (read_write)
+        existing.state = EResourceState::GeneralWrite;
+      if (access == EAccess::Write || read_write)
+        existing.access = EAccess::Write;
+      return existing;
+    }
+
+    pass.accesses.push_back({
+        .resource = resource,
+        .access = access,
+        .state = state,
+    });
+    return pass.accesses.back();
+  }
+
+  auto FrameGraph::get_resource(void *handle, bool is_texture) -> u32
+  {
+    MutRef<HashMap<u64, u32>> indices = is_texture ? m_texture_indices : m_buffer_indices;
+    const u64 key = reinterpret_cast<u64>(handle);
+
+    const auto it = indices.find(key);
+    if (it != indices.end())
+      return it->second;
+
+    const u32 index = (u32) m_resources.size();
+    m_resources.push_back({
+        .handle = handle,
+        .is_texture = is_texture,
+    });
+    indices[key] = index;
+    return index;
+  }
+
+  auto FrameGraph::cull_passes() -> void
+  {
+    for (auto &resource : m_resources)
+      resource.needed = resource.exported;
+
+    // Walk backwards: a pass lives if it has side effects or writes something a later live pass (or the outside world)
+    // consumes. Its own inputs then become needed in turn, unless the pass overwrites them completely.
+    for (Mut<size_t> i = m_passes.size(); i-- > 0;)
+    {
+      MutRef<Pass> pass = m_passes[i];
+
+      pass.alive = pass.side_effects;
+      for (const auto &access : pass.accesses)
+      {
+        if (access.access != EAccess::Read && m_resources[access.resource].needed)
+          pass.alive = true;
+      }
+
+      if (!pass.alive)
+        continue;
+
+      // Storage writes may be partial, so whatever an earlier pass wrote survives them.
+      for (const auto &access : pass.accesses)
+        m_resources[access.resource].needed = !overwrites_contents(access);
+    }
+
+    for (Mut<u32> i = 0; i < (u32) m_passes.size(); i++)
+    {
+      if (m_passes[i].alive)
+        m_schedule.push_back(i);
+    }
+  }
+
+  auto FrameGraph::resolve_accesses() -> void
+  {
+    for (auto &resource : m_resources)
+    {
+      resource.last_use = -1;
+      resource.has_contents = resource.imported;
+      resource.state_known = false;
+      resource.last_attachment = nullptr;
+    }
+
+    for (Mut<u32> slot = 0; slot < (u32) m_schedule.size(); slot++)
+    {
+      for (auto &access : m_passes[m_schedule[slot]].accesses)
+      {
+        MutRef<Resource> resource = m_resources[access.resource];
+        const bool is_attachment = access.access != EAccess::Read && access.access != EAccess::Write;
+        const bool overwrites = overwrites_contents(access);
+
+        // An earlier attachment only has to store what a later use will see.
+        if (resource.last_attachment && !overwrites)
+          resource.last_attachment->store_op = EStoreOp::Store;
+
+        if (is_attachment)
+        {
+          if (access.clear)
+            access.load_op = ELoadOp::Clear;
+          else
+            access.load_op = resource.has_contents ? ELoadOp::Load : ELoadOp::DontCare;
+          access.store_op = EStoreOp::DontCare;
+          resource.last_attachment = &access;
+
+          // begin_rendering transitions attachments itself, the entry only reserves the barrier at this pass.
+          m_transitions.push_back({
+              .resource = access.resource,
+              .state = access.state,
+              .earliest = slot,
+              .latest = slot,
+              .is_attachment = true,
+          });
+        }
+        else
+        {
+          if (!resource.state_known || needs_transition(resource.state, access.state))
+            m_transitions.push_back({
+                .resource = access.resource,
+                .state = access.state,
+                .earliest = (u32) (resource.last_use + 1),
+                .latest = slot,
+            });
+          resource.last_attachment = nullptr;
+        }
+
+        resource.state = access.state;
+        resource.state_known = true;
+        resource.last_use = (i32) slot;
+        if (access.access != EAccess::Read)
+          resource.has_contents = true;
+      }
+    }
+
+    const u32 end_slot = (u32) m_schedule.size();
+    for (Mut<u32> i = 0; i < (u32) m_resources.size(); i++)
+    {
+      MutRef<Resource> resource = m_resources[i];
+      if (!resource.exported)
+        continue;
+
+      if (resource.last_attachment)
+        resource.last_attachment->store_op = EStoreOp::Store;
+
+      if (resource.final_state != EResourceState::Undefined &&
+          (!resource.state_known || needs_transition(resource.state, resource.final_state)))
+        m_transitions.push_back({
+            .resource = i,
+            .state = resource.final_state,
+            .earliest = (u32) (resource.last_use + 1),
+            .latest = end_slot,
+        });
+    }
+  }
+
+  auto FrameGraph::place_transitions() -> void
+  {
+    // Interval stabbing: transitions are generated in order of their latest slot, placing each unplaced one at its
+    // latest slot also serves every later transition whose window contains that slot. This yields the fewest barrier
+    // points, and since the windows of one resource never overlap its transitions keep their order.
+    Mut<i64> point = -1;
+    for (auto &transition : m_transitions)
+    {
+      if ((i64) transition.earliest > point)
+      {
+        point = transition.latest;
+        m_barrier_point_count++;
+      }
+      transition.placement = (u32) point;
+    }
+  }
+
+  auto FrameGraph::record_transition(MutRef<CommandList> cmd, Ref<Transition> transition) -> void
+  {
+    if (transition.is_attachment)
+      return;
+
+    Ref<Resource> resource = m_resources[transition.resource];
+    if (resource.is_texture)
+      cmd.transition_texture((Texture) resource.handle, transition.state);
+    else
+      cmd.transition_buffer((Buffer) resource.handle, transition.state);
+  }
+} // namespace ia::gpu::vulkan
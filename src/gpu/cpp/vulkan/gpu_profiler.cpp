@@ -0,0 +1,166 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/device.hpp>
+#include <vulkan/gpu_profiler.hpp>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  auto GpuProfiler::initialize(Ref<Device> device, u32 queue_family, u32 max_scopes) -> Result<void>
+  {
+    m_device = &device;
+    m_max_scopes = max_scopes;
+
+    Mut<VkPhysicalDeviceProperties> properties{};
+    vkGetPhysicalDeviceProperties(device.get_physical_hande(), &properties);
+    m_timestamp_period = properties.limits.timestampPeriod;
+
+    Mut<Vec<VkQueueFamilyProperties>> queue_family_props;
+    VK_ENUM_CALL(vkGetPhysicalDeviceQueueFamilyProperties, queue_family_props, device.get_physical_hande());
+    if (queue_family >= queue_family_props.size() || queue_family_props[queue_family].timestampValidBits == 0)
+      return fail("The main queue does not support timestamps");
+
+    const VkQueryPoolCreateInfo pool_create_info{
+        .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .queryType = VK_QUERY_TYPE_TIMESTAMP,
+        .queryCount = max_scopes * 2,
+    };
+    for (auto &slot : m_slots)
+    {
+      VK_CALL(vkCreateQueryPool(device.get_handle(), &pool_create_info, nullptr, &slot.pool),
+              "Creating timestamp query pool");
+      vkResetQueryPool(device.get_handle(), slot.pool, 0, pool_create_info.queryCount);
+      slot.scopes.resize(max_scopes);
+      slot.use = ++m_use_count;
+    }
+
+    return {};
+  }
+
+  auto GpuProfiler::destroy() -> void
+  {
+    if (!m_device)
+      return;
+
+    for (auto &slot : m_slots)
+    {
+      vkDestroyQueryPool(m_device->get_handle(), slot.pool, nullptr);
+      slot.pool = VK_NULL_HANDLE;
+    }
+  }
+
+  auto GpuProfiler::open_slot(u32 slot_index, u64 submitted_value) -> void
+  {
+    MutRef<Slot> slot = m_slots[slot_index];
+    slot.use = ++m_use_count;
+    read_back_slot(slot, submitted_value);
+
+    // Published last, recording threads only start on the slot once its readback and reset are done.
+    m_active_slot.store(slot_index, std::memory_order_release);
+  }
+
+  auto GpuProfiler::read_back_slot(MutRef<Slot> slot, u64 submitted_value) -> void
+  {
+    const u32 scope_count = std::min(slot.scope_count.load(std::memory_order_relaxed), m_max_scopes);
+    if (!scope_count)
+      return;
+
+    // The slot's submission has finished, so every written query is available. Scopes whose end was never recorded
+    // come out with zero length instead of failing the whole readback.
+    const u32 query_count = scope_count * 2;
+    m_query_results.resize(query_count * 2);
+    vkGetQueryPoolResults(m_device->get_handle(), slot.pool, 0, query_count, m_query_results.size() * sizeof(u64),
+                          m_query_results.data(), 2 * sizeof(u64),
+                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+    const auto get_ticks = [&](u32 query) -> u64 { return m_query_results[query * 2]; };
+    const auto is_available = [&](u32 query) -> bool { return m_query_results[query * 2 + 1] != 0; };
+
+    Mut<u64> device_now{};
+    Mut<u64> host_now{};
+    const bool is_calibrated = m_device->get_calibrated_timestamps(device_now, host_now);
+
+    Mut<u64> first_ticks = UINT64_MAX;
+    for (Mut<u32> i = 0; i < scope_count; i++)
+    {
+      if (is_available(i * 2))
+        first_ticks = std::min(first_ticks, get_ticks(i * 2));
+    }
+
+    const f64 period = m_timestamp_period;
+    const auto to_ns = [&](u64 ticks) -> u64 {
+      if (is_calibrated)
+        return host_now - (u64) ((f64) (device_now - ticks) * period);
+      return (u64) ((f64) (ticks - first_ticks) * period);
+    };
+
+    m_last_frame.submission_value = submitted_value;
+    m_last_frame.is_calibrated = is_calibrated;
+    m_last_frame.scopes.clear();
+    for (Mut<u32> i = 0; i < scope_count; i++)
+    {
+      Ref<Scope> scope = slot.scopes[i];
+
+      // A parent is always recorded before its children; anything else is a scope left open in an earlier frame.
+      const u32 parent = scope.parent < i ? scope.parent : INVALID_SCOPE;
+
+      Mut<GpuScopeTiming> timing{
+          .name = scope.name,
+          .parent = parent,
+          .depth = parent != INVALID_SCOPE ? m_last_frame.scopes[parent].depth + 1 : 0,
+          .track = scope.track,
+      };
+      if (is_available(i * 2))
+      {
+        timing.begin_ns = to_ns(get_ticks(i * 2));
+        timing.end_ns = is_available(i * 2 + 1) ? to_ns(get_ticks(i * 2 + 1)) : timing.begin_ns;
+      }
+      m_last_frame.scopes.push_back(timing);
+    }
+
+    vkResetQueryPool(m_device->get_handle(), slot.pool, 0, query_count);
+    slot.scope_count.store(0, std::memory_order_relaxed);
+    slot.track_count.store(0, std::memory_order_relaxed);
+  }
+
+  auto GpuProfiler::begin_scope(MutRef<Track> track, VkCommandBuffer cmd, u32 parent, const char *name) -> u32
+  {
+    const u32 slot_index = m_active_slot.load(std::memory_order_acquire);
+    MutRef<Slot> slot = m_slots[slot_index];
+
+    const u32 scope = slot.scope_count.fetch_add(1, std::memory_order_relaxed);
+    if IA_B_UNLIKELY (scope >= m_max_scopes)
+      return INVALID_SCOPE;
+
+    if (track.slot_use != slot.use)
+      track = {.slot_use = slot.use, .index = slot.track_count.fetch_add(1, std::memory_order_relaxed)};
+
+    const bool has_parent = parent != INVALID_SCOPE && get_scope_slot(parent) == slot_index;
+    slot.scopes[scope] = {name, has_parent ? get_scope_index(parent) : INVALID_SCOPE, track.index};
+    vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, slot.pool, scope * 2);
+    return make_scope_handle(slot_index, scope);
+  }
+
+  auto GpuProfiler::end_scope(VkCommandBuffer cmd, u32 scope) -> void
+  {
+    if (scope == INVALID_SCOPE)
+      return;
+
+    vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_slots[get_scope_slot(scope)].pool,
+                         get_scope_index(scope) * 2 + 1);
+  }
+} // namespace ia::gpu::vulkan
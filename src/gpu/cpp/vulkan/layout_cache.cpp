@@ -0,0 +1,230 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/layout_cache.hpp>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  static auto is_same_entry(Ref<BindingLayoutEntry> a, Ref<BindingLayoutEntry> b) -> bool
+  {
+    return a.binding == b.binding && a.count == b.count && a.visibility == b.visibility && a.type == b.type;
+  }
+
+  static auto is_same_push_constant_range(Ref<VkPushConstantRange> a, Ref<VkPushConstantRange> b) -> bool
+  {
+    return a.stageFlags == b.stageFlags && a.offset == b.offset && a.size == b.size;
+  }
+
+  // Colliding keys probe on to the next one, so a key in either cache always names exactly one layout.
+  static auto next_probe_key(u64 key) -> u64
+  {
+    return hash_combine(key, 1);
+  }
+
+  auto acquire_binding_layout(VkDevice device, MutRef<ResourceTables> resources,
+                              std::span<const BindingLayoutEntry> entries) -> Result<BindingLayout>
+  {
+    // Sorted so that the same interface declared in a different order still shares one layout.
+    Mut<Vec<BindingLayoutEntry>> sorted(entries.begin(), entries.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](Ref<BindingLayoutEntry> a, Ref<BindingLayoutEntry> b) { return a.binding < b.binding; });
+
+    Mut<u64> key = HASH_SEED;
+    for (const auto &entry : sorted)
+    {
+      key = hash_combine(key, entry.binding);
+      key = hash_combine(key, entry.count);
+      key = hash_combine(key, (u64) entry.visibility);
+      key = hash_combine(key, (u64) entry.type);
+    }
+
+    const std::lock_guard lock(resources.layout_mutex);
+
+    for (;; key = next_probe_key(key))
+    {
+      const auto it = resources.binding_layout_cache.find(key);
+      if (it == resources.binding_layout_cache.end())
+        break;
+
+      const auto impl = resources.binding_layouts.get(it->second);
+      if (std::equal(impl->entries.begin(), impl->entries.end(), sorted.begin(), sorted.end(), is_same_entry))
+      {
+        impl->ref_count++;
+        return it->second;
+      }
+    }
+
+    Mut<BindingLayoutImpl> layout{};
+
+    Mut<Vec<VkDescriptorSetLayoutBinding>> bindings;
+    bindings.reserve(sorted.size());
+    for (const auto &entry : sorted)
+    {
+      const auto type = map_descriptor_type(entry.type);
+      bindings.push_back({
+          .binding = entry.binding,
+          .descriptorType = type,
+          .descriptorCount = entry.count,
+          .stageFlags = map_shader_stages(entry.visibility),
+      });
+      layout.binding_types[entry.binding] = type;
+    }
+
+    const VkDescriptorSetLayoutCreateInfo layout_create_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .bindingCount = (u32) bindings.size(),
+        .pBindings = bindings.data(),
+    };
+    VK_CALL(vkCreateDescriptorSetLayout(device, &layout_create_info, nullptr, &layout.handle),
+            "Creating descriptor set layout");
+
+    // The template reads one PackedDescriptor per descriptor, all bindings back to back in entry order.
+    Mut<Vec<VkDescriptorUpdateTemplateEntry>> template_entries;
+    template_entries.reserve(sorted.size());
+    for (const auto &entry : sorted)
+    {
+      template_entries.push_back({
+          .dstBinding = entry.binding,
+          .dstArrayElement = 0,
+          .descriptorCount = entry.count,
+          .descriptorType = map_descriptor_type(entry.type),
+          .offset = layout.descriptor_count * sizeof(PackedDescriptor),
+          .stride = sizeof(PackedDescriptor),
+      });
+      layout.descriptor_count += entry.count;
+    }
+
+    if (!template_entries.empty())
+    {
+      const VkDescriptorUpdateTemplateCreateInfo template_create_info{
+          .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+          .descriptorUpdateEntryCount = (u32) template_entries.size(),
+          .pDescriptorUpdateEntries = template_entries.data(),
+          .templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,
+          .descriptorSetLayout = layout.handle,
+      };
+      if IA_B_UNLIKELY (vkCreateDescriptorUpdateTemplate(device, &template_create_info, nullptr,
+                                                         &layout.update_template) != VK_SUCCESS)
+      {
+        vkDestroyDescriptorSetLayout(device, layout.handle, nullptr);
+        return fail("Failed to create descriptor update template");
+      }
+    }
+
+    layout.entries = std::move(sorted);
+    layout.hash = key;
+
+    const auto handle = resources.binding_layouts.create(std::move(layout));
+    resources.binding_layout_cache.emplace(key, handle);
+    return handle;
+  }
+
+  auto release_binding_layout(VkDevice device, MutRef<ResourceTables> resources, BindingLayout layout) -> void
+  {
+    const std::lock_guard lock(resources.layout_mutex);
+
+    const auto impl = resources.binding_layouts.try_get(layout);
+    if (!impl || --impl->ref_count != 0)
+      return;
+
+    if (impl->update_template != VK_NULL_HANDLE)
+      vkDestroyDescriptorUpdateTemplate(device, impl->update_template, nullptr);
+    vkDestroyDescriptorSetLayout(device, impl->handle, nullptr);
+    resources.binding_layout_cache.erase(impl->hash);
+    resources.binding_layouts.destroy(layout);
+  }
+
+  auto acquire_pipeline_layout(VkDevice device, MutRef<ResourceTables> resources,
+                               std::span<const BindingLayout> set_layouts, Ref<VkPushConstantRange> push_constant_range,
+                               MutRef<PipelineImpl> pipeline) -> Result<void>
+  {
+    // Binding layout handles are generational, so hashing them is as good as hashing their contents now that equal
+    // contents share one handle.
+    Mut<u64> key = HASH_SEED;
+    for (const auto layout : set_layouts)
+      key = hash_combine(key, reinterpret_cast<u64>(layout));
+    key = hash_combine(key, push_constant_range.stageFlags);
+    key = hash_combine(key, push_constant_range.size);
+
+    const std::lock_guard lock(resources.layout_mutex);
+
+    for (;; key = next_probe_key(key))
+    {
+      const auto it = resources.pipeline_layout_cache.find(key);
+      if (it == resources.pipeline_layout_cache.end())
+        break;
+
+      MutRef<ResourceTables::PipelineLayoutEntry> entry = it->second;
+      if (std::equal(entry.set_layouts.begin(), entry.set_layouts.end(), set_layouts.begin(), set_layouts.end()) &&
+          is_same_push_constant_range(entry.push_constant_range, push_constant_range))
+      {
+        entry.ref_count++;
+        pipeline.layout = entry.handle;
+        pipeline.layout_key = key;
+        return {};
+      }
+    }
+
+    Mut<Vec<VkDescriptorSetLayout>> set_layout_handles;
+    set_layout_handles.reserve(set_layouts.size());
+    for (const auto layout : set_layouts)
+      set_layout_handles.push_back(resources.binding_layouts.get(layout)->handle);
+
+    const VkPipelineLayoutCreateInfo layout_create_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = (u32) set_layout_handles.size(),
+        .pSetLayouts = set_layout_handles.data(),
+        .pushConstantRangeCount = push_constant_range.size ? 1u : 0u,
+        .pPushConstantRanges = &push_constant_range,
+    };
+
+    Mut<ResourceTables::PipelineLayoutEntry> entry{
+        .set_layouts = Vec<BindingLayout>(set_layouts.begin(), set_layouts.end()),
+        .push_constant_range = push_constant_range,
+        .ref_count = 1,
+    };
+    VK_CALL(vkCreatePipelineLayout(device, &layout_create_info, nullptr, &entry.handle), "Creating pipeline layout");
+
+    // The entry keeps its set layouts alive so their handles cannot be recycled into a different key meanwhile.
+    for (const auto layout : set_layouts)
+      resources.binding_layouts.get(layout)->ref_count++;
+
+    pipeline.layout = entry.handle;
+    pipeline.layout_key = key;
+    resources.pipeline_layout_cache.emplace(key, std::move(entry));
+    return {};
+  }
+
+  auto release_pipeline_layout(VkDevice device, MutRef<ResourceTables> resources, u64 key) -> void
+  {
+    Mut<Vec<BindingLayout>> set_layouts;
+    {
+      const std::lock_guard lock(resources.layout_mutex);
+
+      const auto it = resources.pipeline_layout_cache.find(key);
+      if (it == resources.pipeline_layout_cache.end() || --it->second.ref_count != 0)
+        return;
+
+      vkDestroyPipelineLayout(device, it->second.handle, nullptr);
+      set_layouts = std::move(it->second.set_layouts);
+      resources.pipeline_layout_cache.erase(it);
+    }
+
+    for (const auto layout : set_layouts)
+      release_binding_layout(device, resources, layout);
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,198 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/pipeline_cache.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+namespace ia::gpu::vulkan
+{
+  static auto compute_checksum(std::span<const u8> data) -> u64
+  {
+    // FNV-1a, only meant to catch truncated and corrupted files.
+    Mut<u64> hash = 0xcbf29ce484222325ull;
+    for (const u8 byte : data)
+    {
+      hash ^= byte;
+      hash *= 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+  PipelineCache::~PipelineCache()
+  {
+    destroy();
+  }
+
+  auto PipelineCache::destroy() -> void
+  {
+    if (m_handle == VK_NULL_HANDLE)
+      return;
+
+    if (!m_path.empty())
+    {
+      const auto result = save();
+      if (!result)
+        GPU_LOG_WARN("Failed to save the pipeline cache: {}", result.error());
+    }
+    release();
+  }
+
+  PipelineCache::PipelineCache(PipelineCache &&other) noexcept
+      : m_device(other.m_device), m_handle(std::exchange(other.m_handle, VK_NULL_HANDLE)),
+        m_properties(other.m_properties), m_path(std::move(other.m_path))
+  {
+  }
+
+  PipelineCache &PipelineCache::operator=(PipelineCache &&other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      m_device = other.m_device;
+      m_handle = std::exchange(other.m_handle, VK_NULL_HANDLE);
+      m_properties = other.m_properties;
+      m_path = std::move(other.m_path);
+    }
+    return *this;
+  }
+
+  auto PipelineCache::initialize(VkDevice device, VkPhysicalDevice physical_device, const char *path) -> Result<void>
+  {
+    m_device = device;
+    m_path = path ? path : "";
+    vkGetPhysicalDeviceProperties(physical_device, &m_properties);
+
+    const Vec<u8> initial_data = load_file();
+
+    const VkPipelineCacheCreateInfo create_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .initialDataSize = initial_data.size(),
+        .pInitialData = initial_data.empty() ? nullptr : initial_data.data(),
+    };
+    VK_CALL(vkCreatePipelineCache(m_device, &create_info, nullptr, &m_handle), "Creating pipeline cache");
+
+    return {};
+  }
+
+  auto PipelineCache::save() -> Result<void>
+  {
+    if (m_path.empty())
+      return {};
+
+    Mut<size_t> data_size{};
+    VK_CALL(vkGetPipelineCacheData(m_device, m_handle, &data_size, nullptr), "Querying pipeline cache size");
+
+    Mut<Vec<u8>> data(data_size);
+    VK_CALL(vkGetPipelineCacheData(m_device, m_handle, &data_size, data.data()), "Reading pipeline cache");
+    data.resize(data_size);
+
+    const FileHeader header = make_header(data.size(), compute_checksum(data));
+
+    const std::string temp_path = m_path + ".tmp";
+    {
+      Mut<std::ofstream> file(temp_path, std::ios::binary | std::ios::trunc);
+      if (!file)
+        return fail("Failed to open '{}' for writing", temp_path);
+
+      file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      file.write(reinterpret_cast<const char *>(data.data()), (std::streamsize) data.size());
+      file.flush();
+      if (!file)
+        return fail("Failed to write '{}'", temp_path);
+    }
+
+    Mut<std::error_code> ec;
+    std::filesystem::rename(temp_path, m_path, ec);
+    if (ec)
+    {
+      std::filesystem::remove(temp_path, ec);
+      return fail("Failed to replace '{}'", m_path);
+    }
+
+    return {};
+  }
+
+  auto PipelineCache::load_file() -> Vec<u8>
+  {
+    if (m_path.empty())
+      return {};
+
+    Mut<std::error_code> ec;
+    const u64 file_size = std::filesystem::file_size(m_path, ec);
+    if (ec)
+      return {};
+
+    Mut<std::ifstream> file(m_path, std::ios::binary);
+    if (!file)
+      return {};
+
+    Mut<FileHeader> header{};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    {
+      GPU_LOG_WARN("Ignoring truncated pipeline cache '{}'", m_path);
+      return {};
+    }
+
+    const FileHeader expected = make_header(header.data_size, header.checksum);
+    if (memcmp(&header, &expected, sizeof(header)) != 0)
+    {
+      GPU_LOG_INFO("Ignoring pipeline cache '{}' built for a different device or driver", m_path);
+      return {};
+    }
+
+    // The size is checked against the file before anything is allocated for it, a corrupt header must not decide how
+    // much memory gets reserved.
+    if (header.data_size != file_size - sizeof(header))
+    {
+      GPU_LOG_WARN("Ignoring pipeline cache '{}' whose size does not match its header", m_path);
+      return {};
+    }
+
+    Mut<Vec<u8>> data(header.data_size);
+    if (!file.read(reinterpret_cast<char *>(data.data()), (std::streamsize) data.size()) ||
+        compute_checksum(data) != header.checksum)
+    {
+      GPU_LOG_WARN("Ignoring corrupt pipeline cache '{}'", m_path);
+      return {};
+    }
+
+    return data;
+  }
+
+  auto PipelineCache::make_header(u64 data_size, u64 checksum) const -> FileHeader
+  {
+    Mut<FileHeader> header{};
+    header.magic = FILE_MAGIC;
+    header.version = FILE_VERSION;
+    header.vendor_id = m_properties.vendorID;
+    header.device_id = m_properties.deviceID;
+    header.driver_version = m_properties.driverVersion;
+    memcpy(header.pipeline_cache_uuid, m_properties.pipelineCacheUUID, VK_UUID_SIZE);
+    header.data_size = data_size;
+    header.checksum = checksum;
+    return header;
+  }
+
+  auto PipelineCache::release() -> void
+  {
+    if (m_handle != VK_NULL_HANDLE)
+      vkDestroyPipelineCache(m_device, m_handle, nullptr);
+    m_handle = VK_NULL_HANDLE;
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,268 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/readback_ring.hpp>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  // Keeps tickets off each other's cache lines.
+  static constexpr u64 READBACK_ALIGNMENT = 64;
+
+  static auto align_up(u64 value, u64 alignment) -> u64
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  auto ReadbackRing::initialize(VmaAllocator allocator, u64 capacity, std::span<const u32> queue_families)
+      -> Result<void>
+  {
+    m_allocator = allocator;
+    m_queue_families.assign(queue_families.begin(), queue_families.end());
+
+    m_ring = AU_TRY(create_buffer(capacity));
+    m_capacity = capacity;
+
+    return {};
+  }
+
+  auto ReadbackRing::destroy() -> void
+  {
+    const std::lock_guard lock(m_mutex);
+    Mut<Vec<ReadbackTicket>> tickets;
+    m_entries.for_each([&](ReadbackTicket ticket, Ref<Entry>) { tickets.push_back(ticket); });
+    for (const auto ticket : tickets)
+      free_entry(ticket);
+
+    m_ring_order.clear();
+    m_unsubmitted.clear();
+    m_released_spills.clear();
+
+    vmaDestroyBuffer(m_allocator, m_ring.handle, m_ring.allocation);
+    m_ring = {};
+    m_head = m_tail = m_used = 0;
+  }
+
+  auto ReadbackRing::allocate(VkCommandBuffer cmd, u64 size) -> Result<Allocation>
+  {
+    const std::lock_guard lock(m_mutex);
+    const u64 previous_head = m_head;
+    Mut<Entry> entry{
+        .cmd = cmd,
+        .size = size,
+    };
+
+    if (size > m_capacity / 2 || !allocate_from_ring(entry))
+    {
+      const auto spill = AU_TRY(create_buffer(size));
+      entry.buffer = spill.handle;
+      entry.allocation = spill.allocation;
+      entry.mapped = spill.mapped;
+      entry.is_spill = true;
+    }
+
+    const ReadbackTicket ticket = m_entries.create(entry);
+    if IA_B_UNLIKELY (!ticket)
+    {
+      if (entry.is_spill)
+        vmaDestroyBuffer(m_allocator, entry.buffer, entry.allocation);
+      else
+      {
+        m_head = previous_head;
+        m_used -= entry.consumed;
+      }
+      return fail("Too many readback tickets in flight");
+    }
+
+    if (!entry.is_spill)
+      m_ring_order.push_back(ticket);
+    m_unsubmitted.push_back(ticket);
+
+    return Allocation{
+        .ticket = ticket,
+        .buffer = entry.buffer,
+        .offset = entry.offset,
+    };
+  }
+
+  auto ReadbackRing::submit(VkCommandBuffer cmd, EQueue queue, u64 value) -> void
+  {
+    const std::lock_guard lock(m_mutex);
+    for (Mut<size_t> i = 0; i < m_unsubmitted.size();)
+    {
+      MutRef<Entry> entry = *m_entries.get(m_unsubmitted[i]);
+      if (entry.cmd != cmd)
+      {
+        i++;
+        continue;
+      }
+
+      entry.cmd = VK_NULL_HANDLE;
+      entry.queue = queue;
+      entry.value = value;
+      m_unsubmitted[i] = m_unsubmitted.back();
+      m_unsubmitted.pop_back();
+    }
+  }
+
+  auto ReadbackRing::get_data(ReadbackTicket ticket, u64 main_completed, u64 async_completed) -> std::span<const u8>
+  {
+    const std::lock_guard lock(m_mutex);
+    MutRef<Entry> entry = *m_entries.get(ticket);
+    if (!is_complete(entry, main_completed, async_completed))
+      return {};
+
+    if (!entry.is_invalidated)
+    {
+      vmaInvalidateAllocation(m_allocator, entry.allocation, entry.offset, entry.size);
+      entry.is_invalidated = true;
+    }
+    return {entry.mapped, entry.size};
+  }
+
+  auto ReadbackRing::release(ReadbackTicket ticket, u64 main_completed, u64 async_completed) -> void
+  {
+    const std::lock_guard lock(m_mutex);
+    MutRef<Entry> entry = *m_entries.get(ticket);
+    entry.is_released = true;
+    if (entry.is_spill)
+      m_released_spills.push_back(ticket);
+
+    collect_locked(main_completed, async_completed);
+  }
+
+  auto ReadbackRing::collect(u64 main_completed, u64 async_completed) -> void
+  {
+    const std::lock_guard lock(m_mutex);
+    collect_locked(main_completed, async_completed);
+  }
+
+  auto ReadbackRing::collect_locked(u64 main_completed, u64 async_completed) -> void
+  {
+    while (!m_ring_order.empty())
+    {
+      const ReadbackTicket ticket = m_ring_order.front();
+      Ref<Entry> entry = *m_entries.get(ticket);
+      if (!entry.is_released || !is_complete(entry, main_completed, async_completed))
+        break;
+
+      m_tail = entry.end;
+      m_used -= entry.consumed;
+      free_entry(ticket);
+      m_ring_order.pop_front();
+    }
+
+    // Nothing left in flight, rewind so the next copies get the longest contiguous run.
+    if (m_used == 0)
+      m_head = m_tail = 0;
+
+    std::erase_if(m_released_spills, [&](ReadbackTicket ticket) {
+      if (!is_complete(*m_entries.get(ticket), main_completed, async_completed))
+        return false;
+      free_entry(ticket);
+      return true;
+    });
+  }
+
+  auto ReadbackRing::is_complete(Ref<Entry> entry, u64 main_completed, u64 async_completed) -> bool
+  {
+    if (entry.cmd != VK_NULL_HANDLE)
+      return false;
+    return entry.value <= (entry.queue == EQueue::Main ? main_completed : async_completed);
+  }
+
+  auto ReadbackRing::create_buffer(u64 size) -> Result<MappedBuffer>
+  {
+    const bool is_concurrent = m_queue_families.size() > 1;
+    const VkBufferCreateInfo buffer_create_info{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = size,
+        .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = is_concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = is_concurrent ? (u32) m_queue_families.size() : 0,
+        .pQueueFamilyIndices = is_concurrent ? m_queue_families.data() : nullptr,
+    };
+
+    // Random host access steers VMA to host-cached memory, reading write-combined memory would be very slow.
+    const VmaAllocationCreateInfo allocation_create_info{
+        .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+        .usage = VMA_MEMORY_USAGE_AUTO,
+    };
+
+    Mut<VkBuffer> buffer{};
+    Mut<VmaAllocation> allocation{};
+    Mut<VmaAllocationInfo> allocation_info{};
+    VK_CALL(vmaCreateBuffer(m_allocator, &buffer_create_info, &allocation_create_info, &buffer, &allocation,
+                            &allocation_info),
+            "Creating readback buffer");
+
+    return MappedBuffer{
+        .handle = buffer,
+        .allocation = allocation,
+        .mapped = static_cast<u8 *>(allocation_info.pMappedData),
+    };
+  }
+
+  auto ReadbackRing::allocate_from_ring(MutRef<Entry> entry) -> bool
+  {
+    // Free space is [head, capacity) + [0, tail) unless the ring has wrapped, in which case it is [head, tail).
+    const bool is_full = m_head == m_tail && m_used > 0;
+    const u64 aligned_head = align_up(m_head, READBACK_ALIGNMENT);
+
+    Mut<u64> offset = UINT64_MAX;
+    Mut<u64> consumed = 0;
+    if (m_head >= m_tail && !is_full)
+    {
+      if (aligned_head + entry.size <= m_capacity)
+      {
+        offset = aligned_head;
+        consumed = aligned_head + entry.size - m_head;
+      }
+      else if (entry.size <= m_tail)
+      {
+        offset = 0;
+        consumed = (m_capacity - m_head) + entry.size;
+      }
+    }
+    else if (!is_full && aligned_head + entry.size <= m_tail)
+    {
+      offset = aligned_head;
+      consumed = aligned_head + entry.size - m_head;
+    }
+
+    if (offset == UINT64_MAX)
+      return false;
+
+    m_head = offset + entry.size;
+    m_used += consumed;
+
+    entry.buffer = m_ring.handle;
+    entry.allocation = m_ring.allocation;
+    entry.mapped = m_ring.mapped + offset;
+    entry.offset = offset;
+    entry.end = m_head;
+    entry.consumed = consumed;
+    return true;
+  }
+
+  auto ReadbackRing::free_entry(ReadbackTicket ticket) -> void
+  {
+    Ref<Entry> entry = *m_entries.get(ticket);
+    if (entry.is_spill)
+      vmaDestroyBuffer(m_allocator, entry.buffer, entry.allocation);
+    m_entries.destroy(ticket);
+  }
+} // namespace ia::gpu::vulkan
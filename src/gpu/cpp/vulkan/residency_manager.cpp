@@ -0,0 +1,249 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/residency_manager.hpp>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  // Allocation priorities as VK_EXT_memory_priority reads them, demoted allocations go to the very bottom.
+  static constexpr f32 HIGH_PRIORITY = 1.0f;
+  static constexpr f32 LOW_PRIORITY = 0.25f;
+  static constexpr f32 DEMOTED_PRIORITY = 0.0f;
+
+  // Pressure ends this far below the threshold, so that usage hovering around it does not flip demotions every frame.
+  static constexpr f32 RESTORE_MARGIN = 0.1f;
+
+  auto ResidencyManager::initialize(Ref<Device> device, f32 pressure_threshold) -> void
+  {
+    m_device = device.get_handle();
+    m_allocator = device.get_allocator();
+    m_is_memory_budget_supported = device.is_memory_budget_supported();
+    m_is_memory_priority_supported = device.is_memory_priority_supported();
+    m_is_pageable_memory_supported = device.is_pageable_memory_supported();
+    m_device_memory_limit = device.get_device_memory_limit();
+    m_pressure_threshold = std::clamp(pressure_threshold, RESTORE_MARGIN, 1.0f);
+
+    Mut<const VkPhysicalDeviceMemoryProperties *> memory_props = nullptr;
+    vmaGetMemoryProperties(m_allocator, &memory_props);
+    m_heap_count = memory_props->memoryHeapCount;
+    for (Mut<u32> i = 0; i < memory_props->memoryTypeCount; i++)
+      m_memory_type_heaps[i] = memory_props->memoryTypes[i].heapIndex;
+    for (Mut<u32> i = 0; i < m_heap_count; i++)
+      m_is_heap_device_local[i] = (memory_props->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+
+    GPU_LOG_INFO("Memory budget: {}, priorities: {}, pageable device memory: {}",
+                 m_is_memory_budget_supported ? "driver" : "estimated", m_is_memory_priority_supported,
+                 m_is_pageable_memory_supported);
+    if (m_device_memory_limit)
+      GPU_LOG_INFO("Device-local heaps limited to {} bytes", m_device_memory_limit);
+  }
+
+  auto ResidencyManager::build_allocation_create_info(EMemoryPriority priority, VmaMemoryUsage usage) const
+      -> VmaAllocationCreateInfo
+  {
+    Mut<VmaAllocationCreateInfo> info{
+        .usage = usage,
+    };
+
+    if (priority == EMemoryPriority::Low && m_is_under_pressure)
+      info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+
+    // With a ceiling the process budget is enforced too, so that other tenants of the device cannot push this context
+    // into an out-of-memory failure. Like the ceiling itself it only makes VMA move on to the next memory type.
+    if (m_device_memory_limit)
+      info.flags |= VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT;
+
+    // A priority only sticks to memory the allocation does not share, and demotion changes it per memory object.
+    if (priority != EMemoryPriority::Normal && m_is_memory_priority_supported)
+    {
+      info.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+      info.priority = priority == EMemoryPriority::High ? HIGH_PRIORITY : LOW_PRIORITY;
+    }
+
+    return info;
+  }
+
+  auto ResidencyManager::track(EMemoryPriority priority, VmaAllocation allocation, Ref<VmaAllocationInfo> info)
+      -> void
+  {
+    if (priority != EMemoryPriority::Low || !m_is_pageable_memory_supported || !allocation)
+      return;
+
+    const u32 heap = m_memory_type_heaps[info.memoryType];
+    if (!m_is_heap_device_local[heap])
+      return;
+
+    m_tracked[allocation] = {
+        .memory = info.deviceMemory,
+        .size = info.size,
+        .heap = heap,
+    };
+  }
+
+  auto ResidencyManager::untrack(VmaAllocation allocation) -> void
+  {
+    const auto it = m_tracked.find(allocation);
+    if (it == m_tracked.end())
+      return;
+
+    if (it->second.is_demoted)
+      m_demoted_bytes[it->second.heap] -= it->second.size;
+    m_tracked.erase(it);
+  }
+
+  auto ResidencyManager::get_heap_budget(Ref<VmaBudget> budget) const -> u64
+  {
+    return m_device_memory_limit ? std::min<u64>(budget.budget, m_device_memory_limit) : budget.budget;
+  }
+
+  auto ResidencyManager::update() -> bool
+  {
+    // VMA refreshes the driver budgets when the frame index changes.
+    vmaSetCurrentFrameIndex(m_allocator, ++m_frame_index);
+
+    Mut<VmaBudget> budgets[VK_MAX_MEMORY_HEAPS]{};
+    vmaGetHeapBudgets(m_allocator, budgets);
+
+    const bool was_under_pressure = m_is_under_pressure;
+    m_is_under_pressure = false;
+    for (Mut<u32> heap = 0; heap < m_heap_count; heap++)
+    {
+      if (!m_is_heap_device_local[heap])
+        continue;
+
+      const f64 budget = (f64) get_heap_budget(budgets[heap]);
+      const u64 usage = budgets[heap].usage;
+      const u64 pressure_usage = (u64) (budget * m_pressure_threshold);
+      const u64 restore_usage = (u64) (budget * (m_pressure_threshold - RESTORE_MARGIN));
+
+      if (usage > pressure_usage)
+        m_is_heap_under_pressure[heap] = true;
+      else if (usage < restore_usage)
+      {
+        if (m_is_heap_under_pressure[heap])
+          restore(heap);
+        m_is_heap_under_pressure[heap] = false;
+      }
+
+      // Demoting down to the restore line rather than the threshold keeps the heap from coming straight back.
+      if (m_is_heap_under_pressure[heap] && usage > restore_usage + m_demoted_bytes[heap])
+        demote(heap, usage - restore_usage - m_demoted_bytes[heap]);
+
+      m_is_under_pressure |= m_is_heap_under_pressure[heap];
+    }
+
+    if (m_is_under_pressure != was_under_pressure)
+    {
+      const auto [usage, budget] = get_device_local_usage();
+      if (m_is_under_pressure)
+        GPU_LOG_WARN("Device memory under pressure: {} of {} bytes in use", usage, budget);
+      else
+        GPU_LOG_INFO("Device memory pressure relieved: {} of {} bytes in use", usage, budget);
+    }
+
+    return m_is_under_pressure && !was_under_pressure;
+  }
+
+  auto ResidencyManager::demote(u32 heap, u64 bytes) -> void
+  {
+    Mut<Vec<TrackedAllocation *>> candidates;
+    for (auto &[allocation, tracked] : m_tracked)
+    {
+      AU_UNUSED(allocation);
+      if (tracked.heap == heap && !tracked.is_demoted)
+        candidates.push_back(&tracked);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const TrackedAllocation *a, const TrackedAllocation *b) { return a->size > b->size; });
+
+    Mut<u64> demoted = 0;
+    for (auto *tracked : candidates)
+    {
+      if (demoted >= bytes)
+        break;
+
+      vkSetDeviceMemoryPriorityEXT(m_device, tracked->memory, DEMOTED_PRIORITY);
+      tracked->is_demoted = true;
+      demoted += tracked->size;
+    }
+
+    m_demoted_bytes[heap] += demoted;
+    if (demoted)
+      GPU_LOG_DEBUG("Demoted {} bytes of low priority memory on heap {}", demoted, heap);
+  }
+
+  auto ResidencyManager::restore(u32 heap) -> void
+  {
+    for (auto &[allocation, tracked] : m_tracked)
+    {
+      AU_UNUSED(allocation);
+      if (tracked.heap != heap || !tracked.is_demoted)
+        continue;
+
+      vkSetDeviceMemoryPriorityEXT(m_device, tracked.memory, LOW_PRIORITY);
+      tracked.is_demoted = false;
+    }
+
+    m_demoted_bytes[heap] = 0;
+  }
+
+  auto ResidencyManager::get_budget() const -> MemoryBudget
+  {
+    Mut<VmaBudget> budgets[VK_MAX_MEMORY_HEAPS]{};
+    vmaGetHeapBudgets(m_allocator, budgets);
+
+    Mut<const VkPhysicalDeviceMemoryProperties *> memory_props = nullptr;
+    vmaGetMemoryProperties(m_allocator, &memory_props);
+
+    Mut<MemoryBudget> result{};
+    result.is_driver_budget = m_is_memory_budget_supported;
+    result.is_under_pressure = m_is_under_pressure;
+    result.heaps.resize(m_heap_count);
+    for (Mut<u32> heap = 0; heap < m_heap_count; heap++)
+    {
+      result.heaps[heap] = {
+          .size = memory_props->memoryHeaps[heap].size,
+          .budget = m_is_heap_device_local[heap] ? get_heap_budget(budgets[heap]) : budgets[heap].budget,
+          .usage = budgets[heap].usage,
+          .allocated_bytes = budgets[heap].statistics.allocationBytes,
+          .block_bytes = budgets[heap].statistics.blockBytes,
+          .demoted_bytes = m_demoted_bytes[heap],
+          .device_local = m_is_heap_device_local[heap],
+      };
+    }
+
+    return result;
+  }
+
+  auto ResidencyManager::get_device_local_usage() const -> std::pair<u64, u64>
+  {
+    Mut<VmaBudget> budgets[VK_MAX_MEMORY_HEAPS]{};
+    vmaGetHeapBudgets(m_allocator, budgets);
+
+    Mut<u64> usage = 0;
+    Mut<u64> budget = 0;
+    for (Mut<u32> heap = 0; heap < m_heap_count; heap++)
+    {
+      if (!m_is_heap_device_local[heap])
+        continue;
+      usage += budgets[heap].usage;
+      budget += get_heap_budget(budgets[heap]);
+    }
+
+    return {usage, budget};
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,131 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/shader_reflection.hpp>
+
+#include <spirv_reflect.h>
+
+#include <algorithm>
+
+namespace ia::gpu::vulkan
+{
+  static auto map_reflected_descriptor_type(SpvReflectDescriptorType type) -> Result<EDescriptorType>
+  {
+    switch (type)
+    {
+    case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+      return EDescriptorType::UniformBuffer;
+    case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+      return EDescriptorType::StorageBuffer;
+    case SPV_REFLECT_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+    case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+      return EDescriptorType::SampledImage;
+    case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+      return EDescriptorType::StorageImage;
+    default:
+      return fail("descriptor type {} has no EDescriptorType equivalent", (i32) type);
+    }
+  }
+
+  auto reflect_shader(std::span<const u32> words, EShaderStage stage) -> Result<ShaderReflection>
+  {
+    Mut<SpvReflectShaderModule> module{};
+    if (spvReflectCreateShaderModule(words.size_bytes(), words.data(), &module) != SPV_REFLECT_RESULT_SUCCESS)
+      return fail("Failed to reflect SPIR-V module");
+
+    Mut<u32> binding_count = 0;
+    spvReflectEnumerateDescriptorBindings(&module, &binding_count, nullptr);
+    Mut<Vec<SpvReflectDescriptorBinding *>> bindings(binding_count);
+    spvReflectEnumerateDescriptorBindings(&module, &binding_count, bindings.data());
+
+    Mut<u32> push_constant_count = 0;
+    spvReflectEnumeratePushConstantBlocks(&module, &push_constant_count, nullptr);
+    Mut<Vec<SpvReflectBlockVariable *>> push_constants(push_constant_count);
+    spvReflectEnumeratePushConstantBlocks(&module, &push_constant_count, push_constants.data());
+
+    Mut<ShaderReflection> reflection{.is_valid = true};
+    for (const auto *block : push_constants)
+      reflection.push_constant_size = std::max(reflection.push_constant_size, block->offset + block->size);
+
+    Mut<Result<void>> result{};
+    for (const auto *binding : bindings)
+    {
+      const auto type = map_reflected_descriptor_type(binding->descriptor_type);
+      if (!type)
+      {
+        result = fail("Binding {}.{} ('{}'): {}", binding->set, binding->binding, binding->name ? binding->name : "",
+                      type.error());
+        break;
+      }
+
+      reflection.bindings.push_back({
+          .set = binding->set,
+          .entry =
+              {
+                  .binding = binding->binding,
+                  .count = std::max(binding->count, 1u),
+                  .visibility = stage,
+                  .type = *type,
+              },
+      });
+    }
+
+    spvReflectDestroyShaderModule(&module);
+    AU_TRY_PURE(result);
+
+    std::sort(reflection.bindings.begin(), reflection.bindings.end(),
+              [](Ref<ShaderReflection::Binding> a, Ref<ShaderReflection::Binding> b) {
+                return a.set != b.set ? a.set < b.set : a.entry.binding < b.entry.binding;
+              });
+
+    return reflection;
+  }
+
+  auto merge_shader_bindings(std::span<const ShaderReflection *const> shaders) -> Result<Vec<Vec<BindingLayoutEntry>>>
+  {
+    Mut<Vec<Vec<BindingLayoutEntry>>> sets;
+    for (const auto *shader : shaders)
+    {
+      for (const auto &binding : shader->bindings)
+      {
+        if (binding.set >= 8)
+          return fail("Descriptor set {} is used, at most 8 are supported", binding.set);
+        if (binding.set >= sets.size())
+          sets.resize(binding.set + 1);
+
+        MutRef<Vec<BindingLayoutEntry>> set = sets[binding.set];
+        const auto it = std::find_if(set.begin(), set.end(),
+                                     [&](Ref<BindingLayoutEntry> e) { return e.binding == binding.entry.binding; });
+        if (it == set.end())
+        {
+          set.push_back(binding.entry);
+          continue;
+        }
+
+        if (it->type != binding.entry.type || it->count != binding.entry.count)
+          return fail("Binding {}.{} is declared differently by two stages", binding.set, binding.entry.binding);
+        it->visibility = (EShaderStage) ((u32) it->visibility | (u32) binding.entry.visibility);
+      }
+    }
+
+    for (auto &set : sets)
+    {
+      std::sort(set.begin(), set.end(),
+                [](Ref<BindingLayoutEntry> a, Ref<BindingLayoutEntry> b) { return a.binding < b.binding; });
+    }
+
+    return sets;
+  }
+} // namespace ia::gpu::vulkan
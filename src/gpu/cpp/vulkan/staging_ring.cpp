@@ -0,0 +1,205 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/staging_ring.hpp>
+
+namespace ia::gpu::vulkan
+{
+  static auto align_up(u64 value, u64 alignment) -> u64
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  auto StagingRing::initialize(VmaAllocator allocator, ResourceTables *resources, u64 capacity) -> Result<void>
+  {
+    m_allocator = allocator;
+    m_resources = resources;
+
+    const auto ring = AU_TRY(create_buffer(capacity));
+    m_buffer = ring.buffer;
+    m_mapped = static_cast<u8 *>(ring.mapped);
+    m_capacity = capacity;
+
+    m_stats.ring_capacity = capacity;
+
+    return {};
+  }
+
+  auto StagingRing::destroy() -> void
+  {
+    if (!m_resources)
+      return;
+
+    for (auto &frame : m_frames)
+    {
+      for (const auto spill : frame.spills)
+        destroy_buffer(spill);
+      frame = {};
+    }
+
+    for (const auto spill : m_open_spills)
+      destroy_buffer(spill);
+    m_open_spills.clear();
+
+    destroy_buffer(m_buffer);
+    m_buffer = {};
+    m_mapped = nullptr;
+  }
+
+  auto StagingRing::allocate(u64 size, u64 alignment) -> Result<Allocation>
+  {
+    if (size > m_capacity / MAX_PENDING_FRAME_COUNT)
+      return spill(size);
+
+    // Free space is [head, capacity) + [0, tail) unless the ring has wrapped, in which case it is [head, tail).
+    const bool is_full = m_head == m_tail && m_used > 0;
+    const u64 aligned_head = align_up(m_head, alignment);
+
+    Mut<u64> offset = UINT64_MAX;
+    Mut<u64> consumed = 0;
+    if (m_head >= m_tail && !is_full)
+    {
+      if (aligned_head + size <= m_capacity)
+      {
+        offset = aligned_head;
+        consumed = aligned_head + size - m_head;
+      }
+      else if (size <= m_tail)
+      {
+        offset = 0;
+        consumed = (m_capacity - m_head) + size;
+      }
+    }
+    else if (!is_full && aligned_head + size <= m_tail)
+    {
+      offset = aligned_head;
+      consumed = aligned_head + size - m_head;
+    }
+
+    if (offset == UINT64_MAX)
+    {
+      m_stats.ring_full_count++;
+      return spill(size);
+    }
+
+    m_head = offset + size;
+    m_used += consumed;
+    m_open_bytes += consumed;
+
+    m_stats.ring_bytes_in_use = m_used;
+    m_stats.ring_high_water_mark = std::max(m_stats.ring_high_water_mark, m_used);
+    m_stats.frame_high_water_mark = std::max(m_stats.frame_high_water_mark, m_open_bytes);
+
+    return Allocation{
+        .buffer = m_buffer,
+        .offset = offset,
+        .mapped = m_mapped + offset,
+    };
+  }
+
+  auto StagingRing::flush(Ref<Allocation> allocation, u64 size) -> void
+  {
+    vmaFlushAllocation(m_allocator, m_resources->buffers.get(allocation.buffer)->allocation, allocation.offset, size);
+  }
+
+  auto StagingRing::retire_frame(u32 frame_index) -> void
+  {
+    MutRef<FrameRegion> frame = m_frames[frame_index];
+    if (!frame.in_flight)
+      return;
+
+    for (const auto spill : frame.spills)
+      destroy_buffer(spill);
+    frame.spills.clear();
+
+    m_tail = frame.end;
+    m_used -= frame.bytes;
+    frame.in_flight = false;
+
+    // Nothing left in flight, rewind so the next frame gets the longest contiguous run.
+    if (m_used == 0)
+      m_head = m_tail = 0;
+
+    m_stats.ring_bytes_in_use = m_used;
+  }
+
+  auto StagingRing::close_frame(u32 frame_index) -> void
+  {
+    MutRef<FrameRegion> frame = m_frames[frame_index];
+    assert(!frame.in_flight && "Closing a staging frame that has not been retired");
+
+    frame.end = m_head;
+    frame.bytes = m_open_bytes;
+    frame.spills = std::move(m_open_spills);
+    frame.in_flight = true;
+
+    m_open_bytes = 0;
+    m_open_spills.clear();
+  }
+
+  auto StagingRing::get_stats() const -> StagingStats
+  {
+    return m_stats;
+  }
+
+  auto StagingRing::create_buffer(u64 size) -> Result<Allocation>
+  {
+    const VkBufferCreateInfo buffer_create_info{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = size,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+    };
+
+    const VmaAllocationCreateInfo allocation_create_info{
+        .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+        .usage = VMA_MEMORY_USAGE_AUTO,
+    };
+
+    Mut<VkBuffer> buffer{};
+    Mut<VmaAllocation> allocation{};
+    Mut<VmaAllocationInfo> allocation_info{};
+    VK_CALL(vmaCreateBuffer(m_allocator, &buffer_create_info, &allocation_create_info, &buffer, &allocation,
+                            &allocation_info),
+            "Creating staging buffer");
+
+    return Allocation{
+        .buffer = m_resources->buffers.create_internal(m_allocator, buffer, allocation, allocation_info, size),
+        .offset = 0,
+        .mapped = allocation_info.pMappedData,
+    };
+  }
+
+  auto StagingRing::destroy_buffer(Buffer buffer) -> void
+  {
+    const auto impl = m_resources->buffers.try_get(buffer);
+    if (!impl)
+      return;
+
+    vmaDestroyBuffer(m_allocator, impl->handle, impl->allocation);
+    m_resources->buffers.destroy_internal(buffer);
+  }
+
+  auto StagingRing::spill(u64 size) -> Result<Allocation>
+  {
+    const auto allocation = AU_TRY(create_buffer(size));
+    m_open_spills.push_back(allocation.buffer);
+
+    m_stats.spill_count++;
+    m_stats.spill_bytes += size;
+
+    return allocation;
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,110 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/timeline.hpp>
+
+namespace ia::gpu::vulkan
+{
+  auto Timeline::initialize(VkDevice device, const char *name) -> Result<void>
+  {
+    m_device = device;
+    m_last_submitted_value = 0;
+
+    const VkSemaphoreTypeCreateInfo semaphore_type_create_info{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+        .initialValue = 0,
+    };
+    const VkSemaphoreCreateInfo semaphore_create_info{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = &semaphore_type_create_info,
+    };
+    VK_CALL(vkCreateSemaphore(m_device, &semaphore_create_info, nullptr, &m_semaphore), name);
+
+    return {};
+  }
+
+  auto Timeline::destroy() -> void
+  {
+    if (m_semaphore == VK_NULL_HANDLE)
+      return;
+
+    vkDestroySemaphore(m_device, m_semaphore, nullptr);
+    m_semaphore = VK_NULL_HANDLE;
+  }
+
+  auto Timeline::advance() -> u64
+  {
+    return ++m_last_submitted_value;
+  }
+
+  auto Timeline::get_signal_info(u64 value, VkPipelineStageFlags2 stage) const -> VkSemaphoreSubmitInfo
+  {
+    return {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+        .semaphore = m_semaphore,
+        .value = value,
+        .stageMask = stage,
+    };
+  }
+
+  auto Timeline::get_wait_info(u64 value, VkPipelineStageFlags2 stage) const -> VkSemaphoreSubmitInfo
+  {
+    return get_signal_info(value, stage);
+  }
+
+  auto Timeline::get_completed_value() const -> u64
+  {
+    Mut<u64> value{};
+    vkGetSemaphoreCounterValue(m_device, m_semaphore, &value);
+    return value;
+  }
+
+  auto Timeline::wait(u64 value, u64 timeout) const -> bool
+  {
+    if (value == 0)
+      return true;
+
+    const VkSemaphoreWaitInfo wait_info{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        .semaphoreCount = 1,
+        .pSemaphores = &m_semaphore,
+        .pValues = &value,
+    };
+    return vkWaitSemaphores(m_device, &wait_info, timeout) == VK_SUCCESS;
+  }
+
+  auto DeferredReleaseQueue::push(u64 value, std::function<void()> release) -> void
+  {
+    m_entries.push_back({value, std::move(release)});
+  }
+
+  auto DeferredReleaseQueue::collect(u64 completed_value) -> void
+  {
+    // Entries are pushed with non-decreasing values, so the finished ones form a prefix.
+    Mut<u64> count = 0;
+    while (count < m_entries.size() && m_entries[count].value <= completed_value)
+      m_entries[count++].release();
+
+    m_entries.erase(m_entries.begin(), m_entries.begin() + count);
+  }
+
+  auto DeferredReleaseQueue::drain() -> void
+  {
+    for (auto &entry : m_entries)
+      entry.release();
+    m_entries.clear();
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,422 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vulkan/upload_queue.hpp>
+
+#include <stream_copy.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace ia::gpu::vulkan
+{
+  auto UploadQueue::initialize(VkDevice device, VmaAllocator allocator, ResourceTables *resources, VkQueue queue,
+                               u32 queue_family, u32 consumer_queue_family, VkSemaphore main_timeline, u64 ring_size)
+      -> Result<void>
+  {
+    m_device = device;
+    m_resources = resources;
+    m_queue = queue;
+    m_main_timeline = main_timeline;
+    m_queue_family = queue_family;
+    m_consumer_queue_family = consumer_queue_family;
+
+    AU_TRY_PURE(m_timeline.initialize(m_device, "Creating upload timeline semaphore"));
+
+    const VkCommandPoolCreateInfo command_pool_create_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+        .queueFamilyIndex = m_queue_family,
+    };
+    VK_CALL(vkCreateCommandPool(m_device, &command_pool_create_info, nullptr, &m_command_pool),
+            "Creating upload command pool");
+
+    for (auto &batch : m_batches)
+    {
+      const VkCommandBufferAllocateInfo allocate_info{
+          .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+          .commandPool = m_command_pool,
+          .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+          .commandBufferCount = 1,
+      };
+      VK_CALL(vkAllocateCommandBuffers(m_device, &allocate_info, &batch.command_buffer),
+              "Allocating upload command buffer");
+    }
+
+    AU_TRY_PURE(m_staging.initialize(allocator, resources, ring_size));
+
+    return {};
+  }
+
+  auto UploadQueue::destroy() -> void
+  {
+    // Safe after a partial initialize, each step only undoes what was created.
+    if (m_device == VK_NULL_HANDLE)
+      return;
+
+    if (m_timeline.get_semaphore() != VK_NULL_HANDLE)
+      wait(m_timeline.get_last_submitted_value(), UINT64_MAX);
+
+    m_staging.destroy();
+    vkDestroyCommandPool(m_device, m_command_pool, nullptr);
+    m_command_pool = VK_NULL_HANDLE;
+    m_timeline.destroy();
+    m_device = VK_NULL_HANDLE;
+  }
+
+  auto UploadQueue::upload_buffer(Buffer dst, u64 offset, std::span<const u8> data, u64 main_wait_value)
+      -> Result<u64>
+  {
+    const auto cmd = AU_TRY(open_batch(main_wait_value));
+
+    const auto staging = AU_TRY(m_staging.allocate(data.size(), 16));
+    stream_copy(staging.mapped, data.data(), data.size());
+    m_staging.flush(staging, data.size());
+
+    const auto dst_impl = m_resources->buffers.get(dst);
+    const VkBufferCopy copy{
+        .srcOffset = staging.offset,
+        .dstOffset = dst_impl->offset + offset,
+        .size = data.size(),
+    };
+    vkCmdCopyBuffer(cmd, m_resources->buffers.get(staging.buffer)->handle, dst_impl->handle, 1, &copy);
+
+    m_open_buffers.push_back(dst);
+
+    return m_timeline.get_last_submitted_value() + 1;
+  }
+
+  auto UploadQueue::upload_texture(Texture dst, std::span<const u8> data,
+                                   std::span<const BufferTextureCopyRegion> regions, u64 main_wait_value)
+      -> Result<u64>
+  {
+    const auto cmd = AU_TRY(open_batch(main_wait_value));
+
+    MutRef<TextureImpl> texture = *m_resources->textures.get(dst);
+    const VkImageAspectFlags aspect = get_image_aspect(texture.format);
+
+    const u32 texel_size = texture.is_compressed_data ? get_compressed_format_block_size(texture.format)
+                                                      : get_uncompressed_pixel_size(texture.format);
+    const auto staging = AU_TRY(m_staging.allocate(data.size(), std::lcm<u64>(16, texel_size ? texel_size : 4)));
+    stream_copy(staging.mapped, data.data(), data.size());
+    m_staging.flush(staging, data.size());
+
+    Mut<OpenTexture *> open = nullptr;
+    for (auto &candidate : m_open_textures)
+    {
+      if (candidate.texture == dst)
+        open = &candidate;
+    }
+    if (!open)
+    {
+      const u32 subresource_count = texture.mip_levels * texture.array_layer_count;
+      open = &m_open_textures.emplace_back();
+      open->texture = dst;
+      open->written.resize(subresource_count);
+      open->restore_states.resize(subresource_count);
+    }
+
+    // Take the subresources this upload writes into TransferDst, each from the layout it was left in by the main queue
+    // submissions the batch waits for. Subresources written earlier in the batch already are.
+    const BufferTextureCopyRegion whole_texture{.layer_count = texture.array_layer_count};
+    const std::span<const BufferTextureCopyRegion> written_regions =
+        regions.empty() ? std::span<const BufferTextureCopyRegion>(&whole_texture, 1) : regions;
+
+    Mut<Vec<VkImageMemoryBarrier2>> barriers;
+    for (const auto &region : written_regions)
+    {
+      for (Mut<u32> layer = region.base_array_layer; layer < region.base_array_layer + region.layer_count; layer++)
+      {
+        const u32 index = layer * texture.mip_levels + region.mip_level;
+        if (open->written[index])
+          continue;
+
+        const EResourceState state = texture.get_current_state(layer, region.mip_level);
+        open->written[index] = true;
+        open->restore_states[index] = state;
+
+        barriers.push_back({
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+            .srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+            .srcAccessMask = VK_ACCESS_2_NONE,
+            .dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+            .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            .oldLayout = map_image_layout(state),
+            .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = texture.handle,
+            .subresourceRange = {aspect, region.mip_level, 1, layer, 1},
+        });
+      }
+    }
+    if (!barriers.empty())
+    {
+      const VkDependencyInfo dependency_info{
+          .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+          .imageMemoryBarrierCount = (u32) barriers.size(),
+          .pImageMemoryBarriers = barriers.data(),
+      };
+      vkCmdPipelineBarrier2(cmd, &dependency_info);
+    }
+
+    Mut<Vec<VkBufferImageCopy>> copies;
+    copies.reserve(std::max<u64>(regions.size(), 1));
+    for (const auto &region : regions)
+    {
+      copies.push_back({
+          .bufferOffset = staging.offset + region.buffer_offset,
+          .bufferRowLength = region.buffer_row_length,
+          .bufferImageHeight = region.buffer_image_height,
+          .imageSubresource = {aspect, region.mip_level, region.base_array_layer, region.layer_count},
+          .imageOffset = {region.texture_x, region.texture_y, region.texture_z},
+          .imageExtent = {region.width, region.height, region.depth},
+      });
+    }
+    if (copies.empty())
+    {
+      copies.push_back({
+          .bufferOffset = staging.offset,
+          .imageSubresource = {aspect, 0, 0, texture.array_layer_count},
+          .imageExtent = texture.extent,
+      });
+    }
+
+    vkCmdCopyBufferToImage(cmd, m_resources->buffers.get(staging.buffer)->handle, texture.handle,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (u32) copies.size(), copies.data());
+
+    return m_timeline.get_last_submitted_value() + 1;
+  }
+
+  auto UploadQueue::flush() -> Result<u64>
+  {
+    MutRef<Batch> batch = m_batches[m_batch_index];
+    if (!batch.recording)
+      return m_timeline.get_last_submitted_value();
+
+    const bool transfers_ownership =
+        m_consumer_queue_family != VK_QUEUE_FAMILY_IGNORED && m_queue_family != m_consumer_queue_family;
+    const u32 src_family = transfers_ownership ? m_queue_family : VK_QUEUE_FAMILY_IGNORED;
+    const u32 dst_family = transfers_ownership ? m_consumer_queue_family : VK_QUEUE_FAMILY_IGNORED;
+
+    Mut<Vec<VkBufferMemoryBarrier2>> release_buffer_barriers;
+    Mut<Vec<VkImageMemoryBarrier2>> release_image_barriers;
+
+    // Within one queue family the semaphore signal/wait pair already orders buffer writes, only the layouts and the
+    // ownership of exclusive resources need explicit barriers.
+    if (transfers_ownership)
+    {
+      std::sort(m_open_buffers.begin(), m_open_buffers.end());
+      m_open_buffers.erase(std::unique(m_open_buffers.begin(), m_open_buffers.end()), m_open_buffers.end());
+
+      for (const auto buffer : m_open_buffers)
+      {
+        const auto impl = m_resources->buffers.get(buffer);
+        Mut<VkBufferMemoryBarrier2> barrier{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+            .srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+            .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            .srcQueueFamilyIndex = src_family,
+            .dstQueueFamilyIndex = dst_family,
+            .buffer = impl->handle,
+            .offset = impl->offset,
+            .size = impl->get_range(),
+        };
+        release_buffer_barriers.push_back(barrier);
+
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        barrier.srcAccessMask = VK_ACCESS_2_NONE;
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+        m_acquire_buffer_barriers.push_back(barrier);
+      }
+    }
+
+    // Every written subresource goes back to the layout the main queue tracks for it, never-used ones to GeneralRead.
+    for (const auto &open : m_open_textures)
+    {
+      MutRef<TextureImpl> impl = *m_resources->textures.get(open.texture);
+      const VkImageAspectFlags aspect = get_image_aspect(impl.format);
+
+      for (Mut<u32> layer = 0; layer < impl.array_layer_count; layer++)
+      {
+        for (Mut<u32> mip = 0; mip < impl.mip_levels; mip++)
+        {
+          const u32 index = layer * impl.mip_levels + mip;
+          if (!open.written[index])
+            continue;
+
+          Mut<EResourceState> state = open.restore_states[index];
+          if (state == EResourceState::Undefined)
+          {
+            state = EResourceState::GeneralRead;
+            impl.set_current_state(state, mip, 1, layer, 1);
+          }
+
+          Mut<VkImageMemoryBarrier2> barrier{
+              .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+              .srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+              .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+              .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+              .newLayout = map_image_layout(state),
+              .srcQueueFamilyIndex = src_family,
+              .dstQueueFamilyIndex = dst_family,
+              .image = impl.handle,
+              .subresourceRange = {aspect, mip, 1, layer, 1},
+          };
+          release_image_barriers.push_back(barrier);
+
+          if (transfers_ownership)
+          {
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+            barrier.srcAccessMask = VK_ACCESS_2_NONE;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+            m_acquire_image_barriers.push_back(barrier);
+          }
+        }
+      }
+    }
+
+    m_open_buffers.clear();
+    m_open_textures.clear();
+
+    const VkDependencyInfo dependency_info{
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .bufferMemoryBarrierCount = (u32) release_buffer_barriers.size(),
+        .pBufferMemoryBarriers = release_buffer_barriers.data(),
+        .imageMemoryBarrierCount = (u32) release_image_barriers.size(),
+        .pImageMemoryBarriers = release_image_barriers.data(),
+    };
+    vkCmdPipelineBarrier2(batch.command_buffer, &dependency_info);
+    VK_CALL(vkEndCommandBuffer(batch.command_buffer), "Ending upload command buffer");
+
+    const VkCommandBufferSubmitInfo command_buffer_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+        .commandBuffer = batch.command_buffer,
+    };
+    const u64 value = m_timeline.advance();
+    const VkSemaphoreSubmitInfo signal_info = m_timeline.get_signal_info(value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    const VkSemaphoreSubmitInfo wait_info{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+        .semaphore = m_main_timeline,
+        .value = batch.main_wait_value,
+        .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+    };
+    const VkSubmitInfo2 submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+        .waitSemaphoreInfoCount = batch.main_wait_value ? 1u : 0u,
+        .pWaitSemaphoreInfos = &wait_info,
+        .commandBufferInfoCount = 1,
+        .pCommandBufferInfos = &command_buffer_info,
+        .signalSemaphoreInfoCount = 1,
+        .pSignalSemaphoreInfos = &signal_info,
+    };
+    VK_CALL(vkQueueSubmit2(m_queue, 1, &submit_info, VK_NULL_HANDLE), "Submitting upload batch");
+
+    m_staging.close_frame(m_batch_index);
+
+    batch.value = value;
+    batch.main_wait_value = 0;
+    batch.recording = false;
+    batch.in_flight = true;
+
+    m_batch_index = (m_batch_index + 1) % MAX_PENDING_FRAME_COUNT;
+
+    return value;
+  }
+
+  auto UploadQueue::get_completed_value() const -> u64
+  {
+    return m_timeline.get_completed_value();
+  }
+
+  auto UploadQueue::wait(u64 value, u64 timeout) const -> bool
+  {
+    return m_timeline.wait(value, timeout);
+  }
+
+  auto UploadQueue::acquire_submitted(MutRef<CommandList> cmd) -> u64
+  {
+    if (!has_unacquired_uploads())
+      return 0;
+
+    if (!m_acquire_buffer_barriers.empty() || !m_acquire_image_barriers.empty())
+    {
+      cmd.flush_transitions();
+
+      const VkDependencyInfo dependency_info{
+          .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+          .bufferMemoryBarrierCount = (u32) m_acquire_buffer_barriers.size(),
+          .pBufferMemoryBarriers = m_acquire_buffer_barriers.data(),
+          .imageMemoryBarrierCount = (u32) m_acquire_image_barriers.size(),
+          .pImageMemoryBarriers = m_acquire_image_barriers.data(),
+      };
+      vkCmdPipelineBarrier2(cmd.get_handle(), &dependency_info);
+
+      m_acquire_buffer_barriers.clear();
+      m_acquire_image_barriers.clear();
+    }
+
+    m_last_acquired_value = m_timeline.get_last_submitted_value();
+    return m_last_acquired_value;
+  }
+
+  auto UploadQueue::open_batch(u64 main_wait_value) -> Result<VkCommandBuffer>
+  {
+    MutRef<Batch> batch = m_batches[m_batch_index];
+    batch.main_wait_value = std::max(batch.main_wait_value, main_wait_value);
+    if (batch.recording)
+      return batch.command_buffer;
+
+    retire_completed_batches();
+
+    // Every batch slot is still in flight, the oldest one has to finish before its slot can be reused.
+    if (batch.in_flight)
+    {
+      wait(batch.value, UINT64_MAX);
+      retire_completed_batches();
+    }
+
+    const VkCommandBufferBeginInfo begin_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    VK_CALL(vkBeginCommandBuffer(batch.command_buffer, &begin_info), "Beginning upload command buffer");
+
+    batch.recording = true;
+    return batch.command_buffer;
+  }
+
+  auto UploadQueue::retire_completed_batches() -> void
+  {
+    const u64 completed_value = get_completed_value();
+
+    // Slots are used round-robin, so the oldest in-flight batch is the one after the current slot.
+    for (Mut<u32> i = 1; i <= MAX_PENDING_FRAME_COUNT; i++)
+    {
+      const u32 index = (m_batch_index + i) % MAX_PENDING_FRAME_COUNT;
+      MutRef<Batch> batch = m_batches[index];
+      if (!batch.in_flight)
+        continue;
+      if (batch.value > completed_value)
+        break;
+
+      m_staging.retire_frame(index);
+      batch.in_flight = false;
+    }
+  }
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,79 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <gpu/gpu.hpp>
+
+#if IAGPU_ENABLE_COUNTERS
+#include <chrono>
+#endif
+
+// Hot-path API counters. Without IAGPU_ENABLE_COUNTERS both macros expand to nothing, arguments included, so the
+// counting compiles away entirely and the counter members they name need not exist.
+#if IAGPU_ENABLE_COUNTERS
+#define IAGPU_COUNT(counter, value) ((counter) += (value))
+#define IAGPU_TIME_SCOPE(counter) const ::ia::gpu::CounterTimer iagpu_counter_timer(counter)
+#else
+#define IAGPU_COUNT(counter, value) ((void) 0)
+#define IAGPU_TIME_SCOPE(counter) ((void) 0)
+#endif
+
+namespace ia::gpu
+{
+#if IAGPU_ENABLE_COUNTERS
+  // Adds the steady clock time of its own lifetime to a nanosecond counter.
+  class CounterTimer
+  {
+public:
+    explicit CounterTimer(MutRef<u64> counter) : m_counter(counter), m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    CounterTimer(const CounterTimer &) = delete;
+    CounterTimer &operator=(const CounterTimer &) = delete;
+
+    ~CounterTimer()
+    {
+      const auto elapsed = std::chrono::steady_clock::now() - m_start;
+      m_counter += (u64) std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+private:
+    MutRef<u64> m_counter;
+    std::chrono::steady_clock::time_point m_start;
+  };
+#endif
+
+  inline auto accumulate_counters(MutRef<ApiCounters> into, Ref<ApiCounters> from) -> void
+  {
+    into.draws += from.draws;
+    into.dispatches += from.dispatches;
+    into.pipeline_binds += from.pipeline_binds;
+    into.descriptor_binds += from.descriptor_binds;
+    into.barriers += from.barriers;
+    into.barrier_batches += from.barrier_batches;
+    into.descriptor_writes += from.descriptor_writes;
+    into.staging_bytes += from.staging_bytes;
+    into.async_upload_bytes += from.async_upload_bytes;
+    into.resources_created += from.resources_created;
+    into.resources_destroyed += from.resources_destroyed;
+    into.immediate_submissions += from.immediate_submissions;
+    into.async_compute_submissions += from.async_compute_submissions;
+    into.begin_frame_ns += from.begin_frame_ns;
+    into.end_frame_ns += from.end_frame_ns;
+    into.immediate_commands_ns += from.immediate_commands_ns;
+  }
+} // namespace ia::gpu
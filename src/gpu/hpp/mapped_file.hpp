@@ -0,0 +1,54 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <gpu/gpu.hpp>
+
+namespace ia::gpu
+{
+  // Read-only memory mapping of a whole file, unmapped on destruction.
+  class MappedFile
+  {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    static auto open(const char *path) -> Result<MappedFile>;
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    [[nodiscard]] auto get_data() const -> std::span<const u8>
+    {
+      return {static_cast<const u8 *>(m_data), m_size};
+    }
+
+private:
+    auto close() -> void;
+
+private:
+    const void *m_data{};
+    u64 m_size{};
+
+#if defined(_WIN32)
+    void *m_file{};
+    void *m_mapping{};
+#endif
+  };
+} // namespace ia::gpu
@@ -0,0 +1,224 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <counters.hpp>
+#include <gpu/gpu.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace ia::gpu
+{
+  // Generational slot map backing the opaque public handle types.
+  //
+  // A handle packs the slot index into its low 32 bits and the slot generation into its high 32 bits, so the public
+  // `typedef struct X_T *X` handles keep their size and their null semantics (generations start at 1, a live handle is
+  // never null). Slots live in fixed-size pages that never move, which keeps pointers to live objects stable across
+  // later creates and lets `get` run without locking while another thread only reads.
+  //
+  // create/destroy must be externally synchronized, the same as the Vulkan objects the slots hold.
+  template<typename T, typename HandleT> class SlotMap
+  {
+    static_assert(sizeof(HandleT) == sizeof(u64), "SlotMap handles must be 64-bit");
+
+public:
+    static constexpr u32 PAGE_SIZE = 1024;
+    static constexpr u32 MAX_PAGES = 1024;
+    static constexpr u32 INVALID_INDEX = UINT32_MAX;
+
+    SlotMap() = default;
+
+    SlotMap(const SlotMap &) = delete;
+    SlotMap &operator=(const SlotMap &) = delete;
+
+    ~SlotMap()
+    {
+      for (Mut<u32> i = 0; i < m_capacity; i++)
+      {
+        MutRef<Slot> slot = get_slot(i);
+        if (slot.alive)
+          slot.value()->~T();
+      }
+    }
+
+    template<typename... Args> auto create(Args &&...args) -> HandleT
+    {
+      const HandleT handle = create_internal(std::forward<Args>(args)...);
+      if (handle)
+        IAGPU_COUNT(m_created_count, 1);
+      return handle;
+    }
+
+    auto destroy(HandleT handle) -> bool
+    {
+      if (!destroy_internal(handle))
+        return false;
+
+      IAGPU_COUNT(m_destroyed_count, 1);
+      return true;
+    }
+
+    // For objects the backend keeps in the map only so that their handles resolve like public ones, such as staging
+    // buffers. They are left out of the created/destroyed totals the API counters report.
+    template<typename... Args> auto create_internal(Args &&...args) -> HandleT
+    {
+      Mut<u32> index = m_free_head;
+      if (index != INVALID_INDEX)
+        m_free_head = get_slot(index).next_free;
+      else
+      {
+        if IA_B_UNLIKELY (m_capacity == PAGE_SIZE * MAX_PAGES)
+          return nullptr;
+
+        if (m_capacity % PAGE_SIZE == 0)
+          m_pages[m_capacity / PAGE_SIZE] = std::make_unique<Slot[]>(PAGE_SIZE);
+        index = m_capacity++;
+      }
+
+      MutRef<Slot> slot = get_slot(index);
+      new (slot.storage) T(std::forward<Args>(args)...);
+      slot.alive = true;
+      m_live_count++;
+
+      return encode(index, slot.generation);
+    }
+
+    auto destroy_internal(HandleT handle) -> bool
+    {
+      if (!is_valid(handle))
+        return false;
+
+      const u32 index = decode_index(handle);
+      MutRef<Slot> slot = get_slot(index);
+      slot.value()->~T();
+      slot.alive = false;
+
+      // Generation 0 is reserved so that a handle can never encode to null.
+      slot.generation = (slot.generation == UINT32_MAX) ? 1 : slot.generation + 1;
+      slot.next_free = m_free_head;
+      m_free_head = index;
+      m_live_count--;
+
+      return true;
+    }
+
+    // Hot path lookup. Stale and foreign handles are only caught in debug builds.
+    [[nodiscard]] auto get(HandleT handle) const -> T *
+    {
+      assert(is_valid(handle) && "Use of a destroyed or invalid GPU handle");
+      return get_slot(decode_index(handle)).value();
+    }
+
+    [[nodiscard]] auto try_get(HandleT handle) const -> T *
+    {
+      return is_valid(handle) ? get_slot(decode_index(handle)).value() : nullptr;
+    }
+
+    [[nodiscard]] auto is_valid(HandleT handle) const -> bool
+    {
+      if (handle == nullptr)
+        return false;
+
+      const u32 index = decode_index(handle);
+      if (index >= m_capacity)
+        return false;
+
+      Ref<Slot> slot = get_slot(index);
+      return slot.alive && slot.generation == decode_generation(handle);
+    }
+
+    [[nodiscard]] auto size() const -> u32
+    {
+      return m_live_count;
+    }
+
+    [[nodiscard]] auto capacity() const -> u32
+    {
+      return m_capacity;
+    }
+
+#if IAGPU_ENABLE_COUNTERS
+    // Totals over the map's lifetime, for the per-frame API counters.
+    [[nodiscard]] auto get_created_count() const -> u64
+    {
+      return m_created_count;
+    }
+
+    [[nodiscard]] auto get_destroyed_count() const -> u64
+    {
+      return m_destroyed_count;
+    }
+#endif
+
+    template<typename Func> auto for_each(Func &&func) -> void
+    {
+      for (Mut<u32> i = 0; i < m_capacity; i++)
+      {
+        MutRef<Slot> slot = get_slot(i);
+        if (slot.alive)
+          func(encode(i, slot.generation), *slot.value());
+      }
+    }
+
+private:
+    struct Slot
+    {
+      alignas(T) std::byte storage[sizeof(T)];
+      u32 generation{1};
+      u32 next_free{INVALID_INDEX};
+      bool alive{};
+
+      auto value() -> T *
+      {
+        return std::launder(reinterpret_cast<T *>(storage));
+      }
+    };
+
+    static auto encode(u32 index, u32 generation) -> HandleT
+    {
+      return reinterpret_cast<HandleT>((static_cast<u64>(generation) << 32) | index);
+    }
+
+    static auto decode_index(HandleT handle) -> u32
+    {
+      return static_cast<u32>(reinterpret_cast<u64>(handle));
+    }
+
+    static auto decode_generation(HandleT handle) -> u32
+    {
+      return static_cast<u32>(reinterpret_cast<u64>(handle) >> 32);
+    }
+
+    auto get_slot(u32 index) const -> MutRef<Slot>
+    {
+      return m_pages[index / PAGE_SIZE][index % PAGE_SIZE];
+    }
+
+    std::unique_ptr<Slot[]> m_pages[MAX_PAGES];
+    u32 m_capacity{};
+    u32 m_live_count{};
+    u32 m_free_head{INVALID_INDEX};
+
+#if IAGPU_ENABLE_COUNTERS
+    u64 m_created_count{};
+    u64 m_destroyed_count{};
+#endif
+  };
+} // namespace ia::gpu
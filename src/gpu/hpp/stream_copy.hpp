@@ -0,0 +1,46 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <gpu/gpu.hpp>
+
+namespace ia::gpu
+{
+  enum class EStreamCopyPath
+  {
+    Memcpy = 0,
+    Sse2,
+    Avx2,
+    Avx512,
+    Neon,
+  };
+
+  // Copies into mapped GPU memory with non-temporal stores of whole cache lines.
+  //
+  // Write-combined memory is only fast when every line is written completely and in order, which memcpy does not
+  // promise. The destination is brought to a cache line boundary with a plain copy of the head, the body goes out a
+  // line at a time through the widest vector stores the CPU offers, and the partial tail line is copied plainly again.
+  // On cached memory the streaming stores still skip the read-for-ownership of every line, which pays off once the
+  // copy no longer fits in the caches. The path is picked once per process from the CPU features.
+  auto stream_copy(void *dst, const void *src, u64 size) -> void;
+
+  // A specific path, for benchmarks and tests. It must be supported.
+  auto stream_copy(EStreamCopyPath path, void *dst, const void *src, u64 size) -> void;
+
+  [[nodiscard]] auto get_stream_copy_path() -> EStreamCopyPath;
+  [[nodiscard]] auto is_stream_copy_path_supported(EStreamCopyPath path) -> bool;
+  [[nodiscard]] auto get_stream_copy_path_name(EStreamCopyPath path) -> const char *;
+} // namespace ia::gpu
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <gpu/gpu.hpp>
+#include <slot_map.hpp>
 
 #include <crux/logger.hpp>
 #include <crux/unique_handle.hpp>
@@ -26,6 +27,10 @@
 #include <volk.h>
 #include <vk_mem_alloc.h>
 
+#include <bit>
+#include <mutex>
+#include <string>
+
 #define VK_CALL(call, description)                                                                                     \
   {                                                                                                                    \
     const auto r = call;                                                                                               \
@@ -51,44 +56,100 @@ namespace ia::gpu::vulkan
 {
   static constexpr u32 VULKAN_API_VERSION = VK_MAKE_VERSION(1, 3, 0);
 
+  // Counters of a pipeline statistics query, in the bit order Vulkan writes them and PipelineStatistics lists them.
+  // Graphics counters are not allowed on the compute queue headless builds record on.
+#if IAGPU_DISABLE_GRAPHICS
+  static constexpr VkQueryPipelineStatisticFlags PIPELINE_STATISTICS_FLAGS =
+      VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+#else
+  static constexpr VkQueryPipelineStatisticFlags PIPELINE_STATISTICS_FLAGS =
+      VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+#endif
+  static constexpr u32 PIPELINE_STATISTICS_VALUE_COUNT = (u32) std::popcount(PIPELINE_STATISTICS_FLAGS);
+
   struct BufferImpl
   {
     VmaAllocator vma_allocator;
 
     VkBuffer handle;
     VmaAllocation allocation;
-    VmaAllocationInfo alloc_info;
+    void *mapped_data;
     u64 size;
 
+    // Start of the buffer's range inside `handle` and `allocation`. Only buffers suballocated from a BufferPool page
+    // share their handle, everything that binds, copies, describes or flushes a buffer adds this to its own offsets.
+    u64 offset{};
+    u32 pool_page{UINT32_MAX};
+    VmaVirtualAllocation pool_allocation{VK_NULL_HANDLE};
+
     EResourceState current_state{EResourceState::Undefined};
+    u32 bindless_index{BINDLESS_INVALID_INDEX};
+
+    // Shares a transient heap with other buffers, see TextureImpl::is_aliased.
+    bool is_aliased{};
+
+    // Host-visible memory that is also host-cached, anything else is write-combined or uncached on the host.
+    bool is_host_cached{};
 
     BufferImpl(VmaAllocator allocator, VkBuffer buffer, VmaAllocation allocation, Ref<VmaAllocationInfo> info,
                u64 size_bytes)
-        : vma_allocator(allocator), handle(buffer), allocation(allocation), alloc_info(info), size(size_bytes)
+        : vma_allocator(allocator), handle(buffer), allocation(allocation), mapped_data(info.pMappedData),
+          size(size_bytes)
+    {
+    }
+
+    // Whole range of the buffer, for barriers and descriptors that cannot use VK_WHOLE_SIZE on a shared handle.
+    [[nodiscard]] auto get_range() const -> VkDeviceSize
     {
+      return pool_allocation ? size : VK_WHOLE_SIZE;
     }
 
+    // Points at the start of the buffer's range, pooled buffers are only ever host visible through a mapped page.
     void *map()
     {
-      if (alloc_info.pMappedData)
-        return alloc_info.pMappedData;
+      if (mapped_data)
+        return mapped_data;
 
       Mut<void *> data;
       vmaMapMemory(vma_allocator, allocation, &data);
-      return data;
+      return static_cast<u8 *>(data) + offset;
     }
 
     void unmap()
     {
-      if (!alloc_info.pMappedData)
+      if (!mapped_data)
         vmaUnmapMemory(vma_allocator, allocation);
     }
   };
 
+  // One descriptor as both vkUpdateDescriptorSets and update templates read it. Both info structs have the same size,
+  // so an array of these is also a valid array of either.
+  union PackedDescriptor
+  {
+    VkDescriptorBufferInfo buffer;
+    VkDescriptorImageInfo image;
+  };
+  static_assert(sizeof(VkDescriptorBufferInfo) == sizeof(PackedDescriptor) &&
+                sizeof(VkDescriptorImageInfo) == sizeof(PackedDescriptor));
+
   struct BindingLayoutImpl
   {
     VkDescriptorSetLayout handle{VK_NULL_HANDLE};
     HashMap<u32, VkDescriptorType> binding_types;
+
+    // Identical layouts are shared, every create_binding_layout returning this one holds a reference.
+    Vec<BindingLayoutEntry> entries;
+    u64 hash{};
+    u32 ref_count{1};
+
+    // Writes a whole table from one PackedDescriptor per descriptor, in entry order.
+    VkDescriptorUpdateTemplate update_template{VK_NULL_HANDLE};
+    u32 descriptor_count{};
   };
 
   struct PipelineImpl
@@ -97,18 +158,62 @@ namespace ia::gpu::vulkan
     VkPipeline handle{VK_NULL_HANDLE};
     VkPipelineLayout layout{VK_NULL_HANDLE};
     VkPipelineBindPoint bind_point{VK_PIPELINE_BIND_POINT_GRAPHICS};
+
+    // Key of the shared pipeline layout in ResourceTables::pipeline_layout_cache.
+    u64 layout_key{};
+
+    // One layout per descriptor set. Layouts derived from reflection are referenced by the pipeline and released with
+    // it, layouts passed in the desc belong to the caller.
+    Vec<BindingLayout> set_layouts;
+    bool owns_set_layouts{};
   };
 
   struct DescriptorTableImpl
   {
     VkDescriptorSet handle{VK_NULL_HANDLE};
     BindingLayoutImpl *layout{nullptr};
+
+    // Pool the set is freed back to, null for transient tables which are reclaimed with their frame.
+    VkDescriptorPool pool{VK_NULL_HANDLE};
+  };
+
+  struct ShaderReflection
+  {
+    struct Binding
+    {
+      u32 set;
+      BindingLayoutEntry entry;
+    };
+
+    Vec<Binding> bindings; // sorted by set, then binding
+    u32 push_constant_size{};
+    bool is_valid{};
   };
 
   struct ShaderImpl
   {
     VkShaderModule handle{VK_NULL_HANDLE};
     VkPipelineShaderStageCreateInfo stage_create_info{};
+    std::string entry_point;
+    ShaderReflection reflection;
+  };
+
+  struct SamplerImpl
+  {
+    VkSampler handle{VK_NULL_HANDLE};
+    u32 bindless_index{BINDLESS_INVALID_INDEX};
+  };
+
+  struct FenceImpl
+  {
+    VkFence handle{VK_NULL_HANDLE};
+  };
+
+  struct QueryPoolImpl
+  {
+    VkQueryPool handle{VK_NULL_HANDLE};
+    EQueryType type{EQueryType::Occlusion};
+    u32 query_count{};
   };
 
   struct TextureImpl
@@ -125,6 +230,11 @@ namespace ia::gpu::vulkan
     EFormat format{EFormat::Undefined};
     u32 mip_levels{1};
     u32 array_layer_count{1};
+    u32 bindless_index{BINDLESS_INVALID_INDEX};
+
+    // Placed in a transient heap that other resources alias. Its memory carries no allocation of its own, and a
+    // transition out of Undefined has to wait on whatever used the memory before.
+    bool is_aliased{};
 
     TextureImpl() = default;
 
@@ -146,6 +256,9 @@ namespace ia::gpu::vulkan
 
     void set_current_state(EResourceState new_state, u32 mip_base, u32 mip_count, u32 layer_base, u32 layer_count)
     {
+      if IA_B_UNLIKELY (m_subresource_states.empty())
+        m_subresource_states.resize(mip_levels * array_layer_count, EResourceState::Undefined);
+
       Mut<u32> actual_mip_count = mip_count;
       if (mip_count == VK_REMAINING_MIP_LEVELS)
         actual_mip_count = this->mip_levels - mip_base;
@@ -166,6 +279,49 @@ private:
     Vec<EResourceState> m_subresource_states;
   };
 
+  // Every handle the Context hands out resolves through one of these tables. Kept behind a single heap allocation so
+  // that moving a Context does not invalidate the tables referenced by its command lists.
+  struct ResourceTables
+  {
+    SlotMap<BufferImpl, Buffer> buffers;
+    SlotMap<TextureImpl, Texture> textures;
+    SlotMap<SamplerImpl, Sampler> samplers;
+    SlotMap<ShaderImpl, Shader> shaders;
+    SlotMap<PipelineImpl, Pipeline> pipelines;
+    SlotMap<BindingLayoutImpl, BindingLayout> binding_layouts;
+    SlotMap<DescriptorTableImpl, DescriptorTable> descriptor_tables;
+    SlotMap<FenceImpl, Fence> fences;
+    SlotMap<QueryPoolImpl, QueryPool> query_pools;
+
+    // The bindless heap's set, null unless ContextConfig::bindless_enabled.
+    VkDescriptorSet bindless_set{VK_NULL_HANDLE};
+
+    // Without VK_EXT_conditional_rendering, predicated commands simply always execute.
+    bool conditional_rendering_enabled{};
+
+    struct PipelineLayoutEntry
+    {
+      Vec<BindingLayout> set_layouts; // each holds a reference for as long as the entry lives
+      VkPushConstantRange push_constant_range{};
+      VkPipelineLayout handle{VK_NULL_HANDLE};
+      u32 ref_count{};
+    };
+
+    // Deduplicated layouts keyed by a hash of their contents. Pipelines may be built from several threads, so both
+    // caches and the binding layout table are guarded by layout_mutex while layouts are resolved.
+    std::mutex layout_mutex;
+    HashMap<u64, BindingLayout> binding_layout_cache;
+    HashMap<u64, PipelineLayoutEntry> pipeline_layout_cache;
+  };
+
+  // FNV-1a over 64-bit words, used to key the deduplicating caches.
+  inline constexpr u64 HASH_SEED = 14695981039346656037ull;
+
+  inline constexpr u64 hash_combine(u64 hash, u64 value)
+  {
+    return (hash ^ value) * 1099511628211ull;
+  }
+
   inline constexpr VkFormat map_format(EFormat format)
   {
     switch (format)
@@ -243,6 +399,44 @@ private:
     }
   }
 
+  inline constexpr VkImageAspectFlags get_image_aspect(EFormat format)
+  {
+    switch (format)
+    {
+    case EFormat::D16Unorm:
+    case EFormat::D32Sfloat:
+      return VK_IMAGE_ASPECT_DEPTH_BIT;
+
+    case EFormat::D16UnormS8Uint:
+    case EFormat::D24UnormS8Uint:
+    case EFormat::D32SfloatS8Uint:
+      return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+
+    default:
+      return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+  }
+
+  inline constexpr VkBufferUsageFlags map_buffer_usage(EBufferUsage usage)
+  {
+    Mut<VkBufferUsageFlags> flags = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    if ((u32) usage & (u32) EBufferUsage::Vertex)
+      flags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    if ((u32) usage & (u32) EBufferUsage::Index)
+      flags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    if ((u32) usage & (u32) EBufferUsage::Uniform)
+      flags |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    if ((u32) usage & (u32) EBufferUsage::Storage)
+      flags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if ((u32) usage & (u32) EBufferUsage::Transfer)
+      flags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    if ((u32) usage & (u32) EBufferUsage::Indirect)
+      flags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+    if ((u32) usage & (u32) EBufferUsage::Predicate)
+      flags |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+    return flags;
+  }
+
   inline constexpr VkShaderStageFlags map_shader_stages(EShaderStage stage)
   {
     Mut<VkShaderStageFlags> flags = 0;
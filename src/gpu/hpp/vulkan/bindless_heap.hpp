@@ -0,0 +1,79 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+namespace ia::gpu::vulkan
+{
+  // One update-after-bind descriptor set that holds every bindless resource, bound once per command list.
+  //
+  // Each resource type has its own partially bound array in the set. A resource keeps the index it got at creation for
+  // its whole lifetime, so shaders reach it through an index in a push constant or a buffer rather than through a
+  // per-draw descriptor table. Textures share one index between the sampled and the storage array. Indices are only
+  // recycled after the resource's deferred release, so a frame in flight never sees its slot rewritten.
+  class BindlessHeap
+  {
+public:
+    static constexpr u32 SAMPLED_IMAGE_BINDING = 0;
+    static constexpr u32 STORAGE_IMAGE_BINDING = 1;
+    static constexpr u32 STORAGE_BUFFER_BINDING = 2;
+    static constexpr u32 SAMPLER_BINDING = 3;
+
+    auto initialize(VkDevice device, VkPhysicalDevice physical_device, u32 resource_capacity, u32 sampler_capacity)
+        -> Result<void>;
+    auto destroy() -> void;
+
+    // Return BINDLESS_INVALID_INDEX when the heap is full.
+    auto add_texture(VkImageView view, bool is_sampled, bool is_storage) -> u32;
+    auto add_buffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) -> u32;
+    auto add_sampler(VkSampler sampler) -> u32;
+
+    auto remove_texture(u32 index) -> void;
+    auto remove_buffer(u32 index) -> void;
+    auto remove_sampler(u32 index) -> void;
+
+    [[nodiscard]] auto get_layout() const -> VkDescriptorSetLayout
+    {
+      return m_layout;
+    }
+
+    [[nodiscard]] auto get_set() const -> VkDescriptorSet
+    {
+      return m_set;
+    }
+
+private:
+    struct IndexAllocator
+    {
+      Vec<u32> free_indices;
+      u32 next_index{};
+      u32 capacity{};
+
+      auto allocate() -> u32;
+      auto release(u32 index) -> void;
+    };
+
+    VkDevice m_device{};
+    VkDescriptorSetLayout m_layout{VK_NULL_HANDLE};
+    VkDescriptorPool m_pool{VK_NULL_HANDLE};
+    VkDescriptorSet m_set{VK_NULL_HANDLE};
+
+    IndexAllocator m_textures;
+    IndexAllocator m_buffers;
+    IndexAllocator m_samplers;
+  };
+} // namespace ia::gpu::vulkan
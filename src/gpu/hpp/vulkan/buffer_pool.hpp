@@ -0,0 +1,77 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+namespace ia::gpu::vulkan
+{
+  // Small buffers suballocated from shared backing buffers, one list of pages per usage class.
+  //
+  // A page is one VkBuffer with one VMA allocation, carved up through a VMA virtual block. A pooled buffer's impl
+  // points at its page's handle and allocation and carries its offset into them, so command lists, copies and
+  // descriptor writes only add that offset. A class keeps its first page, later pages are freed once they run empty.
+  // Frees come in through the deferred releases, when the GPU is done with the range.
+  class BufferPool
+  {
+public:
+    static constexpr u32 INVALID_PAGE = UINT32_MAX;
+
+    struct Suballocation
+    {
+      VkBuffer buffer{};
+      VmaAllocation allocation{};
+      void *mapped{}; // already offset, null for pages that are not host visible
+      u64 offset{};
+      u32 page{INVALID_PAGE};
+      VmaVirtualAllocation virtual_allocation{};
+    };
+
+    auto initialize(VmaAllocator allocator, VkPhysicalDevice physical_device, u64 page_size) -> void;
+    auto destroy() -> void;
+
+    // Pages of a class are created from the same infos, with the size replaced by the page size. Buffers sharing
+    // a class must therefore agree on the usage flags, on being host visible and on the host access.
+    auto allocate(u64 size, Ref<VkBufferCreateInfo> buffer_create_info,
+                  Ref<VmaAllocationCreateInfo> allocation_create_info) -> Result<Suballocation>;
+    auto free(u32 page, VmaVirtualAllocation virtual_allocation) -> void;
+
+private:
+    struct Page
+    {
+      VkBuffer buffer{};
+      VmaAllocation allocation{};
+      u8 *mapped{};
+      VmaVirtualBlock block{};
+      u64 class_key{};
+    };
+
+    auto get_alignment(Ref<VkBufferCreateInfo> buffer_create_info, bool host_visible) const -> u64;
+    auto create_page(u64 class_key, Ref<VkBufferCreateInfo> buffer_create_info,
+                     Ref<VmaAllocationCreateInfo> allocation_create_info) -> Result<u32>;
+    auto destroy_page(u32 page) -> void;
+
+private:
+    VmaAllocator m_allocator{};
+    u64 m_page_size{};
+
+    VkPhysicalDeviceLimits m_limits{};
+
+    Vec<Page> m_pages;
+    Vec<u32> m_free_pages;
+    HashMap<u64, Vec<u32>> m_classes;
+  };
+} // namespace ia::gpu::vulkan
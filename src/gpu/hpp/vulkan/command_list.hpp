@@ -15,7 +15,10 @@
 
 #pragma once
 
-#include <gpu/concepts.hpp>
+#include <vulkan/base.hpp>
+#include <vulkan/gpu_profiler.hpp>
+
+#include <compare>
 
 namespace ia::gpu::vulkan
 {
@@ -33,6 +36,10 @@ public:
     void bind_pipeline(Pipeline pipeline);
     void bind_descriptor_table(u32 index, DescriptorTable table);
 
+    // Binds the bindless heap as descriptor set `index`. Pipelines sharing the same layouts up to that set keep it
+    // bound, so this is needed once per command list rather than per draw.
+    void bind_bindless_heap(u32 index);
+
     void push_constants(EShaderStage stage, u32 offset, u32 size, const void *data);
 
     void set_viewport(const Viewport &vp);
@@ -57,6 +64,136 @@ public:
     void copy_texture_to_buffer(Buffer src, std::span<const BufferTextureCopyRegion> regions);
     void blit_texture(Texture src, EResourceState src_state, Texture dst, EResourceState dst_state,
                       std::span<const TextureBlitRegion> regions, bool filter);
+
+    // Queries must be reset before each use, outside of rendering. Occlusion results count passing samples, and are
+    // only guaranteed to be non-zero when any sample passed.
+    void reset_queries(QueryPool pool, u32 first, u32 count);
+    void begin_query(QueryPool pool, u32 index);
+    void end_query(QueryPool pool, u32 index);
+
+    // Writes the results as u32 values on the GPU: one per occlusion query, PIPELINE_STATISTICS_VALUE_COUNT per
+    // pipeline statistics query (see PIPELINE_STATISTICS_FLAGS).
+    void copy_query_results(QueryPool pool, u32 first, u32 count, Buffer dst, u64 offset);
+
+    // Draws and dispatches up to end_conditional_rendering are skipped when the u32 at `offset` is 0 (non-zero when
+    // inverted). The buffer needs EBufferUsage::Predicate and is transitioned here, so call this outside of rendering
+    // unless it is already in the Predicate state. Without device support the commands always execute.
+    void begin_conditional_rendering(Buffer buffer, u64 offset, bool inverted);
+    void end_conditional_rendering();
+
+    // Named timing scope, nested under the innermost open scope of this list. No-ops unless GPU profiling is enabled.
+    // `name` is not copied and must stay valid until the frame's timings are read back.
+    void begin_gpu_scope(const char *name);
+    void end_gpu_scope();
+
+public:
+    // A buffer's handle and offset, pooled buffers share their handle, or an image's handle with offset UINT64_MAX.
+    struct TransitionedResource
+    {
+      u64 handle;
+      u64 offset;
+
+      auto operator<=>(const TransitionedResource &) const = default;
+    };
+
+    // `is_compute_only` is set for lists recorded for a queue family without graphics support, their barriers then
+    // stick to the stages that family offers.
+    CommandList(VkCommandBuffer handle, ResourceTables *resources, GpuProfiler *profiler = nullptr,
+                bool is_compute_only = false)
+        : m_handle(handle), m_resources(resources), m_profiler(profiler), m_is_compute_only(is_compute_only)
+    {
+    }
+
+    [[nodiscard]] auto get_handle() const -> VkCommandBuffer
+    {
+      return m_handle;
+    }
+
+#ifndef NDEBUG
+    // Buffers and images whose tracked state the list read or changed since the last clear. Debug builds check with
+    // them that the thread lists of a frame transition disjoint resources, see Context::begin_thread_commands.
+    [[nodiscard]] auto get_transitioned_resources() const -> Ref<Vec<TransitionedResource>>
+    {
+      return m_transitioned_resources;
+    }
+
+    auto clear_transitioned_resources() -> void
+    {
+      m_transitioned_resources.clear();
+    }
+#endif
+
+    // Adds what the list counted since the last collection to `counters`.
+    auto collect_counters(MutRef<ApiCounters> counters) -> void
+    {
+#if IAGPU_ENABLE_COUNTERS
+      accumulate_counters(counters, m_counters);
+      m_counters = {};
+#else
+      AU_UNUSED(counters);
+#endif
+    }
+
+private:
+    // A transition waiting for the next flush. Textures are tracked per subresource so that repeated transitions of
+    // the same subresource collapse into one, and flush_transitions can merge neighbouring ranges back together.
+    struct PendingBufferTransition
+    {
+      VkBuffer buffer;
+      VkDeviceSize offset; // pooled buffers share their handle, the range tells them apart
+      VkDeviceSize size;
+      EResourceState old_state;
+      EResourceState new_state;
+      bool alias;
+    };
+
+    struct PendingTextureTransition
+    {
+      VkImage image;
+      VkImageAspectFlags aspect;
+      u32 layer;
+      u32 mip;
+      EResourceState old_state;
+      EResourceState new_state;
+      bool discard;
+      bool alias;
+    };
+
+    // Transitions the given range from its tracked state. `discard` drops the old contents, the barrier then
+    // transitions from VK_IMAGE_LAYOUT_UNDEFINED but still waits on the old state's accesses.
+    auto record_texture_transition(MutRef<TextureImpl> texture, EResourceState state, u32 base_mip, u32 mip_count,
+                                   u32 base_layer, u32 layer_count, bool discard) -> void;
+
+    auto push_buffer_transition(Ref<BufferImpl> buffer, EResourceState old_state, EResourceState new_state) -> void;
+    auto push_texture_transition(Ref<TextureImpl> texture, EResourceState old_state, EResourceState new_state,
+                                 u32 layer, u32 mip, bool discard) -> void;
+
+    auto build_texture_barriers() -> void;
+
+private:
+    VkCommandBuffer m_handle{VK_NULL_HANDLE};
+    ResourceTables *m_resources{};
+    PipelineImpl *m_bound_pipeline{};
+    GpuProfiler *m_profiler{};
+    bool m_is_compute_only{};
+
+    Vec<PendingBufferTransition> m_pending_buffer_transitions;
+    Vec<PendingTextureTransition> m_pending_texture_transitions;
+
+    // Kept across flushes so steady-state recording does not allocate.
+    Vec<VkBufferMemoryBarrier2> m_buffer_barriers;
+    Vec<VkImageMemoryBarrier2> m_image_barriers;
+
+    Vec<u32> m_gpu_scope_stack;
+    GpuProfiler::Track m_gpu_track{};
+
+#ifndef NDEBUG
+    Vec<TransitionedResource> m_transitioned_resources;
+#endif
+
+#if IAGPU_ENABLE_COUNTERS
+    ApiCounters m_counters{};
+#endif
   };
 
   static_assert(IsCommandList<CommandList>, "CommandList must satisfy IsCommandList concept");
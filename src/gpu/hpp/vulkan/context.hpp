@@ -16,7 +16,22 @@
 #pragma once
 
 #include <vulkan/device.hpp>
+#include <vulkan/bindless_heap.hpp>
+#include <vulkan/buffer_pool.hpp>
 #include <vulkan/command_list.hpp>
+#include <vulkan/descriptor_allocator.hpp>
+#include <vulkan/gpu_profiler.hpp>
+#include <vulkan/pipeline_cache.hpp>
+#include <vulkan/readback_ring.hpp>
+#include <vulkan/residency_manager.hpp>
+#include <vulkan/staging_ring.hpp>
+#include <vulkan/timeline.hpp>
+#include <vulkan/upload_queue.hpp>
+
+#include <cassert>
+#include <deque>
+#include <memory>
+#include <type_traits>
 
 namespace ia::gpu::vulkan
 {
@@ -30,7 +45,7 @@ public:
 
     Context(Context &&) = default;
 
-    ~Context() = default;
+    ~Context();
 
     static auto create(Ref<ContextConfig> config) -> Result<Context>;
 
@@ -39,19 +54,72 @@ public:
     std::pair<CmdListType *, u32> begin_frame();
     bool end_frame(CmdListType *cmd);
 
+    // Command lists for worker threads, recorded from a pool owned by the thread index so that recording takes no
+    // locks. A thread index (below ContextConfig::max_recording_threads) must only be used by one thread at a time.
+    // Lists are begun after begin_frame and ended before end_frame, which submits them after the main list ordered by
+    // thread index, then by the order they were begun on that thread. Barrier state is shared by all lists and tracked
+    // in recording order, so the lists of different thread indices must transition disjoint buffers and textures, and
+    // the main list may only prepare those before the thread lists are begun. Debug builds assert this at end_frame.
+    CmdListType *begin_thread_commands(u32 thread_index);
+    void end_thread_commands(CmdListType *cmd);
+
+    // Command lists for the async compute queue (ContextConfig::async_compute_enabled), recorded from the open frame
+    // slot and submitted before that slot is reused. A submission runs beside the main queue once the main timeline
+    // reaches `wait_value` (0 waits for nothing, otherwise an already submitted value such as
+    // get_last_submission_value) and returns the async compute timeline value it signals, 0 on failure.
+    // add_async_compute_dependency makes the next main queue submission wait for such a value, so frame N can be
+    // post-processed while frame N + 1 renders and be waited for by frame N + 2. Barrier state is tracked in recording
+    // order, resources used on both queues must be ordered through these waits.
+    CmdListType *begin_async_compute_commands();
+    u64 submit_async_compute_commands(CmdListType *cmd, u64 wait_value);
+    void add_async_compute_dependency(u64 value);
+    u64 get_completed_async_compute_value();
+    bool wait_for_async_compute(u64 value, u64 timeout);
+
+    // True when async compute runs on a queue family of its own rather than beside or on the main queue's.
+    bool has_async_compute_family();
+
     bool create_buffers(std::span<const BufferDesc> descs, std::span<Buffer> out);
     void destroy_buffers(std::span<const Buffer> buffers);
 
     bool create_textures(std::span<const TextureDesc> descs, std::span<Texture> out);
     void destroy_textures(std::span<const Texture> textures);
 
+    // Creates the frame's intermediates in one go so that resources whose [first_use, last_use] intervals do not
+    // overlap can share memory. The handles need no destroy call and are released when the frame slot is reused,
+    // MAX_PENDING_FRAME_COUNT frames later. Contents are undefined at first use, and the first transition of each
+    // resource waits on the previous users of its memory.
+    bool create_transient_resources(std::span<const TransientTextureDesc> texture_descs,
+                                    std::span<Texture> out_textures, std::span<const TransientBufferDesc> buffer_descs,
+                                    std::span<Buffer> out_buffers);
+    TransientMemoryStats get_transient_memory_stats();
+
     Result<Pipeline> create_compute_pipeline(const ComputePipelineDesc &desc);
     Result<Pipeline> create_graphics_pipeline(const GraphicsPipelineDesc &desc);
     void destroy_pipeline(Pipeline p);
 
+    // Layout of descriptor set `set` as the pipeline uses it, derived from the shaders when the desc left the layouts
+    // empty. Owned by the pipeline, valid until it is destroyed.
+    Result<BindingLayout> get_pipeline_binding_layout(Pipeline pipeline, u32 set);
+
+    // Writes the pipeline cache to ContextConfig::pipeline_cache_path now rather than waiting for shutdown.
+    bool save_pipeline_cache();
+
+    // Maps a baked archive and creates all of its shaders, binding layouts and pipelines, the pipelines in parallel on
+    // thread_count threads (0 picks the hardware concurrency). SPIR-V is read straight from the mapping.
+    Result<LoadedPipelineArchive> load_pipeline_archive(const char *path, u32 thread_count);
+    void unload_pipeline_archive(LoadedPipelineArchive &archive);
+
     bool create_samplers(std::span<const SamplerDesc> descs, std::span<Sampler> out);
     void destroy_samplers(std::span<Sampler> samplers);
 
+    // Results are read without waiting: the getters return false until every requested query of the last submission
+    // using them has completed, which is usually MAX_PENDING_FRAME_COUNT frames later.
+    bool create_query_pools(std::span<const QueryPoolDesc> descs, std::span<QueryPool> out);
+    void destroy_query_pools(std::span<const QueryPool> pools);
+    bool get_occlusion_results(QueryPool pool, u32 first, std::span<u64> out);
+    bool get_pipeline_statistics(QueryPool pool, u32 first, std::span<PipelineStatistics> out);
+
     bool create_fences(std::span<Fence> out, bool signaled);
     void destroy_fences(std::span<const Fence> fences);
     bool wait_for_fences(std::span<const Fence> fences, bool wait_all, u64 timeout);
@@ -64,15 +132,51 @@ public:
     void destroy_binding_layout(BindingLayout l);
 
     bool create_descriptor_tables(BindingLayout layout, std::span<DescriptorTable> out);
+
+    // Tables for the frame being recorded. They need no destroy call and become invalid once the frame slot is reused,
+    // MAX_PENDING_FRAME_COUNT frames later, when their pools are reset as a whole.
+    bool create_transient_descriptor_tables(BindingLayout layout, std::span<DescriptorTable> out);
+
+    // Stable index of the resource in the bindless heap, BINDLESS_INVALID_INDEX when bindless is disabled, the heap is
+    // full, or the buffer has no storage usage.
+    u32 get_bindless_index(Texture texture);
+    u32 get_bindless_index(Buffer buffer);
+    u32 get_bindless_index(Sampler sampler);
+
+    // Layout of the bindless set for pipeline descs, owned by the context. Fails when bindless is disabled.
+    Result<BindingLayout> get_bindless_layout();
     void destroy_descriptor_tables(std::span<DescriptorTable> tables);
     void update_descriptor_tables(std::span<const DescriptorUpdate> updates);
 
+    // Rewrites every descriptor of the table with one templated update. `slots` holds one entry per descriptor, in
+    // binding order and then array element order, as many as the table's layout has descriptors.
+    void write_descriptor_table(DescriptorTable table, std::span<const DescriptorSlot> slots);
+
     Result<void> resize_swapchain(u32 width, u32 height);
     Texture get_back_buffer();
 
     void update_host_visible_buffer(Buffer buffer, u64 offset, std::span<const u8> data);
     void read_host_visible_buffer(Buffer buffer, u64 offset, std::span<u8> data);
 
+    // Persistent write pointer into a host-visible buffer, null for buffers that are not. It stays valid for the
+    // buffer's lifetime, writes through it must be followed by flush_host_visible_buffer before the GPU reads them.
+    // Buffers created with host_write_only must only be written, sequentially and whole, e.g. with stream_copy.
+    void *get_host_visible_pointer(Buffer buffer, u64 offset);
+    void flush_host_visible_buffer(Buffer buffer, u64 offset, u64 size);
+
+    // Typed view of `count` elements of T at `offset` through get_host_visible_pointer, empty if not host visible.
+    template<typename T> std::span<T> get_host_visible_span(Buffer buffer, u64 offset, u64 count);
+
+    // Non-blocking readback of `size` bytes at `offset`: transitions the buffer to TransferSrc and records a copy into
+    // host-cached memory. Once the submission carrying `cmd` has completed, get_readback_data returns the bytes in
+    // place, invalidated if the memory is not coherent, and an empty span before that. The bytes stay valid until the
+    // ticket is released, which also frees its memory for later readbacks, so tickets are best released in the order
+    // they were taken. `cmd` may be a frame, thread, async compute or immediate list, readbacks are taken under a lock
+    // so thread lists may record them concurrently.
+    Result<ReadbackTicket> read_buffer_async(CmdListType *cmd, Buffer buffer, u64 offset, u64 size);
+    std::span<const u8> get_readback_data(ReadbackTicket ticket);
+    void release_readback(ReadbackTicket ticket);
+
     bool update_texture(Texture texture, std::span<const u8> data, std::span<const BufferTextureCopyRegion> regions);
     bool generate_mipmaps(Texture texture);
 
@@ -80,6 +184,35 @@ public:
     u32 get_buffer_size(Buffer b);
     TextureInfo get_texture_info(Texture t);
 
+    StagingStats get_staging_stats();
+
+    // Per-heap budget and usage, sampled now. The pressure state is the one of the last frame begun.
+    MemoryBudget get_memory_budget();
+
+    // Scope timings of the most recent frame whose results were read back, MAX_PENDING_FRAME_COUNT frames behind the
+    // one being recorded. Empty unless ContextConfig::gpu_profiling_enabled is set and the device supports it.
+    GpuFrameTimings get_gpu_frame_timings();
+
+    // API usage of the last whole frame, from its begin_frame to the current one. Work recorded outside of frames
+    // (immediate commands, resource creation) counts toward the frame it happened in.
+    ApiCounters get_frame_counters();
+
+    // Every main queue submission signals the next value of a timeline, the value of a frame is known once
+    // end_frame returns. Waiting on an older value does not stall on the frames submitted after it.
+    u64 get_last_submission_value();
+    u64 get_completed_submission_value();
+    bool wait_for_submission(u64 value, u64 timeout);
+
+    // Uploads on the dedicated transfer queue. Each returns the timeline value that signals completion (0 on failure);
+    // frames submitted after the upload is flushed wait on it automatically. The upload itself waits for every main
+    // queue submission made before the call, the frame still being recorded must not use the destination before it.
+    u64 upload_buffer_async(Buffer buffer, u64 offset, std::span<const u8> data);
+    u64 upload_texture_async(Texture texture, std::span<const u8> data,
+                             std::span<const BufferTextureCopyRegion> regions);
+    u64 flush_async_uploads();
+    u64 get_completed_upload_value();
+    bool wait_for_upload(u64 value, u64 timeout);
+
     template<typename Func> bool execute_immediate_commands(Func &&func);
 
 private:
@@ -98,6 +231,10 @@ private:
     auto initialize_instance(bool enable_validation) -> Result<void>;
     auto destroy_instance() -> void;
 
+    // Everything made from m_device, the device last. Only called when the device was booted.
+    auto release_device_objects() -> void;
+    auto initialize_async_compute(bool enabled) -> Result<void>;
+
     auto begin_compute_only_frame() -> void;
     auto end_compute_only_frame(MutRef<CmdListType> cmd) -> bool;
 
@@ -106,26 +243,123 @@ private:
 
     auto advance_current_frame() -> MutRef<CmdListType>;
 
-    auto prepare_staging_memory(u64 size) -> Result<void *>;
+    // Create the Vulkan objects without registering a handle, safe to call from several threads at once as long as no
+    // shader is created or destroyed meanwhile.
+    auto build_compute_pipeline(Ref<ComputePipelineDesc> desc) -> Result<PipelineImpl>;
+    auto build_graphics_pipeline(Ref<GraphicsPipelineDesc> desc) -> Result<PipelineImpl>;
+
+    // Fills in the shared pipeline layout for build_*, deriving the set layouts and the push constant range from the
+    // shaders' reflection wherever the desc leaves them empty.
+    auto resolve_pipeline_layout(std::span<const Shader> shaders, std::span<const BindingLayout> layouts,
+                                 u32 push_constant_size, EShaderStage push_constant_stages,
+                                 MutRef<PipelineImpl> pipeline) -> Result<void>;
+    auto discard_pipeline_layout(MutRef<PipelineImpl> pipeline) -> void;
+
+    auto build_buffer_create_info(Ref<BufferDesc> desc) const -> VkBufferCreateInfo;
+    auto build_texture_create_info(Ref<TextureDesc> desc) const -> VkImageCreateInfo;
+
+    // Names the object, adds it to the bindless heap and hands out its handle. register_texture creates the view and
+    // destroys the image if that fails, returning null.
+    auto register_buffer(Ref<BufferDesc> desc, VkBuffer buffer, VmaAllocation allocation,
+                         Ref<VmaAllocationInfo> allocation_info) -> Buffer;
+    auto register_pooled_buffer(Ref<BufferDesc> desc, Ref<BufferPool::Suballocation> suballocation) -> Buffer;
+    auto is_pooled_buffer(Ref<BufferDesc> desc) const -> bool;
+    auto is_host_cached(VmaAllocation allocation) const -> bool;
+    auto register_texture(Ref<TextureDesc> desc, Ref<VkImageCreateInfo> image_create_info, Mut<TextureImpl> texture)
+        -> Texture;
+
+    auto allocate_descriptor_tables(MutRef<DescriptorAllocator> allocator, BindingLayout layout,
+                                    std::span<DescriptorTable> out) -> bool;
+
+    auto pack_descriptor(VkDescriptorType type, Buffer buffer, u64 buffer_offset, u64 buffer_range, Texture texture,
+                         Sampler sampler) -> PackedDescriptor;
+
+    // Reused by every descriptor update so that the hot path does not allocate once the capacity has settled.
+    struct DescriptorUpdateScratch
+    {
+      Vec<u32> order;
+      Vec<VkWriteDescriptorSet> writes;
+      Vec<PackedDescriptor> descriptors;
+    };
+    DescriptorUpdateScratch m_descriptor_update_scratch;
+
+    auto prepare_staging_memory(u64 size, u64 alignment) -> Result<StagingRing::Allocation>;
+    auto begin_upload_commands() -> Result<CmdListType>;
+
+#if IAGPU_ENABLE_COUNTERS
+    auto publish_frame_counters() -> void;
+#endif
+
+    auto begin_immediate_commands() -> VkCommandBuffer;
+    auto end_immediate_commands(MutRef<CmdListType> cmd) -> bool;
+
+    auto get_main_queue() const -> VkQueue;
+    auto get_main_queue_family() const -> u32;
+
+    auto set_object_name(VkObjectType type, u64 handle, const char *name) -> void;
+
+    std::unique_ptr<ResourceTables> m_resources;
 
     Texture m_back_buffer{};
 
     struct FrameContext
     {
-      VkFence in_flight_fence{VK_NULL_HANDLE};
+      // Main timeline value signaled by the frame's submission, 0 until the frame is first submitted.
+      u64 submitted_value{};
       VkCommandPool command_pool{VK_NULL_HANDLE};
 
+      // Open from the first recording after the fence wait until the frame is submitted.
+      bool is_open{};
+
+      // Staged uploads recorded into this frame, submitted ahead of the frame's own command lists.
+      VkCommandBuffer upload_command_buffer{VK_NULL_HANDLE};
+      bool has_pending_uploads{};
+
 #if !IAGPU_DISABLE_GRAPHICS
       VkImage swapchain_image{VK_NULL_HANDLE};
       VkImageView swapchain_image_view{VK_NULL_HANDLE};
       VkSemaphore image_available_semaphore{VK_NULL_HANDLE};
       VkSemaphore render_finished_semaphore{VK_NULL_HANDLE};
-      TextureImpl *render_target_texture{};
+      Texture render_target_texture{};
 #endif
 
       u32 used_cmd_list_count{};
       Vec<CmdListType> cmd_list_cache;
 
+      struct ThreadCommands
+      {
+        VkCommandPool command_pool{VK_NULL_HANDLE};
+        u32 used_cmd_list_count{};
+
+        // A deque so that lists handed out earlier keep their address when the cache grows.
+        std::deque<CmdListType> cmd_list_cache;
+      };
+      Vec<ThreadCommands> thread_commands;
+
+      // Async compute lists and the async compute timeline value of the last one submitted from this slot, which may
+      // finish after the frame's own submission.
+      VkCommandPool async_compute_command_pool{VK_NULL_HANDLE};
+      u32 used_async_compute_cmd_list_count{};
+      std::deque<CmdListType> async_compute_cmd_list_cache;
+      u64 async_compute_value{};
+
+      DescriptorAllocator transient_descriptors;
+      Vec<DescriptorTable> transient_tables;
+
+      // Transient resources and the heaps they alias in. A heap that sat unused through a whole cycle of the slot is
+      // freed when the slot is reopened, the others are kept for the next frame.
+      struct TransientHeap
+      {
+        VmaAllocation allocation{VK_NULL_HANDLE};
+        u64 size{};
+        u64 alignment{};
+        u32 memory_type_bits{};
+        bool in_use{};
+      };
+      Vec<TransientHeap> transient_heaps;
+      Vec<Texture> transient_textures;
+      Vec<Buffer> transient_buffers;
+
       FrameContext()
       {
         cmd_list_cache.reserve(32);
@@ -136,21 +370,79 @@ private:
     u32 m_active_sync_frame_index{};
     FrameContext m_frames[MAX_PENDING_FRAME_COUNT];
 
+    auto open_frame() -> MutRef<FrameContext>;
+    auto release_transient_resources(MutRef<FrameContext> frame) -> void;
+    auto acquire_transient_heap(MutRef<FrameContext> frame, u32 memory_type_bits, u64 size, u64 alignment)
+        -> Result<VmaAllocation>;
+    auto has_thread_commands() -> bool;
+#ifndef NDEBUG
+    auto are_thread_resources_disjoint(Ref<FrameContext> frame) -> bool;
+#endif
+    auto submit_frame(MutRef<CmdListType> cmd, CmdListType *epilogue, VkQueue queue, VkSemaphore wait_semaphore,
+                      VkSemaphore signal_semaphore) -> bool;
+
     VkCommandPool m_transient_command_pool{};
 
-    Sampler m_default_sampler;
+    PipelineCache m_pipeline_cache;
+
+    DescriptorAllocator m_descriptor_allocator;
+
+    // Heap-held so that the deferred releases of destroyed resources can return their indices after a move.
+    std::unique_ptr<BindlessHeap> m_bindless_heap;
+    BindingLayout m_bindless_layout{};
+
+    TransientMemoryStats m_transient_stats{};
+
+    ResidencyManager m_residency;
+
+    // Heap-held so that the deferred releases of destroyed pooled buffers can free their range after a move.
+    std::unique_ptr<BufferPool> m_buffer_pool;
+
+    // Heap-held so that the command lists keep a valid pointer after a move.
+    std::unique_ptr<GpuProfiler> m_profiler;
+
+    ApiCounters m_frame_counters{};
+    ApiCounters m_last_frame_counters{};
+#if IAGPU_ENABLE_COUNTERS
+    u64 m_resources_created_total{};
+    u64 m_resources_destroyed_total{};
+#endif
+
+    Timeline m_main_timeline;
+
+    // The async compute queue is the main queue when there is no spare one. Resources are created concurrent over
+    // m_shared_queue_families when it or the transfer queue belongs to another family.
+    VkQueue m_async_compute_queue{};
+    u32 m_async_compute_queue_family{};
+    bool m_async_compute_profiled{};
+    bool m_async_compute_only{};
+    Timeline m_async_compute_timeline;
+    u64 m_async_compute_dependency{};
+    u32 m_shared_queue_families[3]{};
+    u32 m_shared_queue_family_count{};
+
+    // Objects destroyed through the public API are released once the main timeline passes the submission that could
+    // still reference them, and the async compute work submitted during that frame has finished.
+    DeferredReleaseQueue m_deferred_releases;
+
+    auto get_release_value() const -> u64;
+
+    auto collect_readbacks() -> void;
+    auto get_collectable_release_value() const -> u64;
+
+    Sampler m_default_sampler{};
 
     i32 m_swapchain_buffer_count{};
-    Buffer m_staging_buffer_handle{};
-    VkBuffer m_staging_buffer{nullptr};
-    u64 m_staging_capacity{0};
-    void *m_staging_mapped_ptr{nullptr};
-    VmaAllocation m_staging_allocation{};
+    StagingRing m_staging_ring;
+
+    // Heap-held because its ticket table cannot move.
+    std::unique_ptr<ReadbackRing> m_readback_ring;
+    UploadQueue m_upload_queue;
 
 #if !IAGPU_DISABLE_GRAPHICS
     VkSurfaceKHR m_surface{};
 
-    VkSwapchainKHR m_swapchain;
+    VkSwapchainKHR m_swapchain{};
     VkFormat m_swapchain_format;
     VkExtent2D m_swapchain_extent;
     VkColorSpaceKHR m_swapchain_colorspace;
@@ -163,4 +455,31 @@ private:
   };
 
   static_assert(IsContext<Context>, "Context must satisfy IsContext concept");
+
+  template<typename Func> bool Context::execute_immediate_commands(Func &&func)
+  {
+    IAGPU_TIME_SCOPE(m_frame_counters.immediate_commands_ns);
+    IAGPU_COUNT(m_frame_counters.immediate_submissions, 1);
+
+    const auto handle = begin_immediate_commands();
+    if IA_B_UNLIKELY (handle == VK_NULL_HANDLE)
+      return false;
+
+    Mut<CmdListType> cmd(handle, m_resources.get());
+    func(&cmd);
+
+    return end_immediate_commands(cmd);
+  }
+
+  template<typename T> std::span<T> Context::get_host_visible_span(Buffer buffer, u64 offset, u64 count)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Host-visible spans need a trivially copyable element type");
+    assert(offset % alignof(T) == 0);
+    assert(offset + count * sizeof(T) <= get_buffer_size(buffer));
+
+    void *data = get_host_visible_pointer(buffer, offset);
+    if (!data)
+      return {};
+    return {static_cast<T *>(data), count};
+  }
 } // namespace ia::gpu::vulkan
\ No newline at end of file
@@ -0,0 +1,81 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+namespace ia::gpu::vulkan
+{
+  // Descriptor sets carved from a chain of pools that grows on demand.
+  //
+  // A pool that runs out stays in the chain and a larger one is appended, sized from the mix of descriptor types
+  // allocated so far, so allocation only fails when the device itself is out of memory. Persistent allocators free
+  // sets one at a time and revisit older pools before growing. Transient allocators never free individual sets, their
+  // sets live until the next reset, which recycles every pool at once no matter how many sets were handed out.
+  class DescriptorAllocator
+  {
+public:
+    struct Allocation
+    {
+      VkDescriptorSet set{VK_NULL_HANDLE};
+      VkDescriptorPool pool{VK_NULL_HANDLE};
+    };
+
+    auto initialize(VkDevice device, bool is_transient, u32 initial_set_count) -> Result<void>;
+    auto destroy() -> void;
+
+    auto allocate(Ref<BindingLayoutImpl> layout) -> Result<Allocation>;
+
+    // Transient allocators only. Invalidates every set allocated since the previous reset. When that took more than
+    // one pool, the chain is replaced by a single pool large enough for all of it.
+    auto reset() -> Result<void>;
+
+    [[nodiscard]] auto is_transient() const -> bool
+    {
+      return m_is_transient;
+    }
+
+    [[nodiscard]] auto get_pool_count() const -> u32
+    {
+      return (u32) m_pools.size();
+    }
+
+private:
+    static constexpr u32 DESCRIPTOR_TYPE_COUNT = 4;
+
+    struct Usage
+    {
+      u64 set_count{};
+      u64 descriptor_counts[DESCRIPTOR_TYPE_COUNT]{};
+    };
+
+    auto create_pool(u32 set_count, Ref<Usage> minimum) -> Result<void>;
+    auto try_allocate(VkDescriptorPool pool, VkDescriptorSetLayout layout, MutRef<VkDescriptorSet> out) -> VkResult;
+
+private:
+    VkDevice m_device{};
+    bool m_is_transient{};
+    u32 m_initial_set_count{};
+
+    Vec<VkDescriptorPool> m_pools;
+    u32 m_current_pool{};
+    u32 m_last_pool_set_count{};
+
+    // Everything ever allocated decides the type mix of new pools, the current cycle sizes a transient reset.
+    Usage m_total_usage{};
+    Usage m_cycle_usage{};
+  };
+} // namespace ia::gpu::vulkan
@@ -19,6 +19,14 @@
 
 namespace ia::gpu::vulkan
 {
+  // The physical device override of ContextConfig.
+  struct DeviceSelection
+  {
+    u32 index = UINT32_MAX;
+    const char *uuid = nullptr;
+    const char *name = nullptr;
+  };
+
   class Device
   {
 public:
@@ -28,10 +36,14 @@ public:
     Device(Device &&) = default;
     Device &operator=(Device &&) = default;
 
-    auto boot(VkInstance instance, VkSurfaceKHR surface, Span<const char *> extensions) -> Result<void>;
+    auto boot(VkInstance instance, VkSurfaceKHR surface, Span<const char *> extensions, bool enable_bindless,
+              bool enable_profiling, Ref<DeviceSelection> selection, u64 device_memory_limit) -> Result<void>;
 
     auto wait_idle() -> void;
 
+    // Tears the device down ahead of the destructor, so that the instance it was created from can go after it.
+    auto destroy() -> void;
+
 public:
     [[nodiscard]] auto get_handle() const -> VkDevice
     {
@@ -48,9 +60,60 @@ public:
       return m_allocator;
     }
 
-    [[nodiscard]] auto get_descriptor_pool() const -> VkDescriptorPool
+    // Descriptor indexing with update-after-bind, requested through ContextConfig::bindless_enabled.
+    [[nodiscard]] auto is_bindless_enabled() const -> bool
+    {
+      return m_is_bindless_enabled;
+    }
+
+    // Host query resets for the GPU profiler, requested through ContextConfig::gpu_profiling_enabled.
+    [[nodiscard]] auto is_profiling_enabled() const -> bool
+    {
+      return m_is_profiling_enabled;
+    }
+
+    [[nodiscard]] auto is_pipeline_statistics_supported() const -> bool
     {
-      return m_descriptor_pool;
+      return m_is_pipeline_statistics_supported;
+    }
+
+    // VK_EXT_conditional_rendering, enabled whenever the device offers it.
+    [[nodiscard]] auto is_conditional_rendering_supported() const -> bool
+    {
+      return m_is_conditional_rendering_supported;
+    }
+
+    // VK_EXT_memory_budget, without it the allocator estimates the budgets from the heap sizes.
+    [[nodiscard]] auto is_memory_budget_supported() const -> bool
+    {
+      return m_is_memory_budget_supported;
+    }
+
+    // VK_EXT_memory_priority, allocations made with a priority get one device memory object each.
+    [[nodiscard]] auto is_memory_priority_supported() const -> bool
+    {
+      return m_is_memory_priority_supported;
+    }
+
+    // VK_EXT_pageable_device_local_memory, the priority of an allocation can be changed after it was made.
+    [[nodiscard]] auto is_pageable_memory_supported() const -> bool
+    {
+      return m_is_pageable_memory_supported;
+    }
+
+    // ContextConfig::device_memory_limit the allocator's device-local heaps were limited to, 0 for none.
+    [[nodiscard]] auto get_device_memory_limit() const -> u64
+    {
+      return m_device_memory_limit;
+    }
+
+    // A device timestamp and the host's monotonic clock (in nanoseconds) sampled at the same moment. False when the
+    // device cannot calibrate its timestamps against that clock.
+    auto get_calibrated_timestamps(MutRef<u64> device_ticks, MutRef<u64> host_ns) const -> bool;
+
+    [[nodiscard]] auto get_command_submit_fence() const -> VkFence
+    {
+      return m_command_submit_fence;
     }
 
     [[nodiscard]] auto get_graphics_queue() const -> VkQueue
@@ -63,6 +126,12 @@ public:
       return m_compute_queue;
     }
 
+    // A compute queue other than the main one, null when the device has none to spare.
+    [[nodiscard]] auto get_async_compute_queue() const -> VkQueue
+    {
+      return m_async_compute_queue;
+    }
+
     [[nodiscard]] auto get_transfer_queue() const -> VkQueue
     {
       return m_transfer_queue;
@@ -78,15 +147,24 @@ public:
       return m_compute_queue_family;
     }
 
+    [[nodiscard]] auto get_async_compute_queue_family() const -> u32
+    {
+      return m_async_compute_queue_family;
+    }
+
     [[nodiscard]] auto get_transfer_queue_family() const -> u32
     {
       return m_transfer_queue_family;
     }
 
 private:
-    auto initialize_device(VkInstance instance, Span<const char *> extensions) -> Result<void>;
+    auto initialize_device(VkInstance instance, Span<const char *> extensions, bool enable_bindless,
+                           bool enable_profiling, Ref<DeviceSelection> selection, u64 device_memory_limit)
+        -> Result<void>;
 
-    auto select_physical_device(VkInstance instance) -> Result<VkPhysicalDevice>;
+    // Picks the suitable device with the highest score, or the one the selection names.
+    auto select_physical_device(VkInstance instance, Span<const char *> extensions, bool enable_bindless,
+                                Ref<DeviceSelection> selection) -> Result<VkPhysicalDevice>;
 
 private:
     UniqueHandle<VkDevice, VK_NULL_HANDLE, [](VkDevice device) { vkDestroyDevice(device, nullptr); }> m_handle;
@@ -95,22 +173,28 @@ private:
     VkQueue m_compute_queue{};
     VkQueue m_graphics_queue{};
     VkQueue m_transfer_queue{};
+    VkQueue m_async_compute_queue{};
     u32 m_graphics_queue_family{UINT32_MAX};
     u32 m_compute_queue_family{UINT32_MAX};
+    u32 m_async_compute_queue_family{UINT32_MAX};
     u32 m_transfer_queue_family{UINT32_MAX};
 
     UniqueHandle<VmaAllocator, VK_NULL_HANDLE, vmaDestroyAllocator> m_allocator;
 
     VkSurfaceKHR m_surface{};
+    bool m_is_bindless_enabled{};
+    bool m_is_profiling_enabled{};
+    bool m_is_pipeline_statistics_supported{};
+    bool m_is_conditional_rendering_supported{};
+    bool m_is_memory_budget_supported{};
+    bool m_is_memory_priority_supported{};
+    bool m_is_pageable_memory_supported{};
+    u64 m_device_memory_limit{};
+    PFN_vkGetCalibratedTimestampsKHR m_get_calibrated_timestamps{};
 
     UniqueDependentHandle<VkFence, VkDevice, VK_NULL_HANDLE,
                           [](VkDevice device, VkFence fence) { vkDestroyFence(device, fence, nullptr); }>
         m_command_submit_fence;
-    UniqueDependentHandle<VkDescriptorPool, VkDevice, VK_NULL_HANDLE,
-                          [](VkDevice device, VkDescriptorPool pool) {
-                            vkDestroyDescriptorPool(device, pool, nullptr);
-                          }>
-        m_descriptor_pool;
 
 public:
     Device() = default;
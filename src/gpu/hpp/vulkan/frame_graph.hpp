@@ -0,0 +1,218 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/command_list.hpp>
+
+#include <functional>
+#include <utility>
+
+namespace ia::gpu::vulkan
+{
+  enum class EPassType
+  {
+    Compute = 0,
+    Transfer,
+#if !IAGPU_DISABLE_GRAPHICS
+    Render,
+#endif
+  };
+
+  // Schedules the passes of one frame from their declared resource accesses.
+  //
+  // Passes run in the order they were added and declare every Texture/Buffer they touch. compile() culls the passes
+  // that contribute nothing to an exported resource, then places each transition at the pass boundary that lets the
+  // most transitions share one barrier: a transition may move anywhere between the last pass using the resource's old
+  // state and the pass needing the new one. Attachment load/store ops are derived from whether the contents are
+  // produced earlier in the graph and consumed later. Resources are transitioned as a whole.
+  //
+  // A graph is rebuilt every frame: reset(), add the passes, compile(), execute(). Storage is kept across resets.
+  class FrameGraph
+  {
+public:
+    using PassCallback = std::function<void(CommandList *cmd)>;
+
+    class PassBuilder
+    {
+  public:
+      // Without a state, reads default to GeneralRead (TransferSrc in transfer passes) and writes to GeneralWrite
+      // (TransferDst). A resource both read and written by a pass needs one writable state for both.
+      auto read(Texture texture) -> PassBuilder &;
+      auto read(Texture texture, EResourceState state) -> PassBuilder &;
+      auto read(Buffer buffer) -> PassBuilder &;
+      auto read(Buffer buffer, EResourceState state) -> PassBuilder &;
+      auto write(Texture texture) -> PassBuilder &;
+      auto write(Texture texture, EResourceState state) -> PassBuilder &;
+      auto write(Buffer buffer) -> PassBuilder &;
+      auto write(Buffer buffer, EResourceState state) -> PassBuilder &;
+
+#if !IAGPU_DISABLE_GRAPHICS
+      // Attachments of a render pass, in binding order. The clear variants overwrite the whole attachment, the others
+      // load it when an earlier pass or the outside world produced its contents.
+      auto color_attachment(Texture texture, Texture resolve_target = {}) -> PassBuilder &;
+      auto clear_color_attachment(Texture texture, f32 r, f32 g, f32 b, f32 a, Texture resolve_target = {})
+          -> PassBuilder &;
+      auto depth_attachment(Texture texture) -> PassBuilder &;
+      auto clear_depth_attachment(Texture texture, f32 depth) -> PassBuilder &;
+#endif
+
+      // The pass has effects the graph cannot see (host readback, queries...) and is never culled.
+      auto side_effects() -> PassBuilder &;
+
+  private:
+      friend class FrameGraph;
+
+      PassBuilder(FrameGraph *graph, u32 pass) : m_graph(graph), m_pass(pass)
+      {
+      }
+
+      FrameGraph *m_graph{};
+      u32 m_pass{};
+    };
+
+    auto add_compute_pass(const char *name, PassCallback callback) -> PassBuilder;
+    auto add_transfer_pass(const char *name, PassCallback callback) -> PassBuilder;
+#if !IAGPU_DISABLE_GRAPHICS
+    auto add_render_pass(const char *name, PassCallback callback) -> PassBuilder;
+#endif
+
+    // Contents produced outside the graph, e.g. uploads or earlier frames. Attachments that are not cleared load them.
+    auto import_texture(Texture texture) -> void;
+    auto import_buffer(Buffer buffer) -> void;
+
+    // Contents used after the graph. The passes producing them are kept, and the resource ends up in `final_state`
+    // (Undefined leaves it in the state of its last use). Exported resources are imported as well.
+    auto export_texture(Texture texture, EResourceState final_state = EResourceState::Undefined) -> void;
+    auto export_buffer(Buffer buffer, EResourceState final_state = EResourceState::Undefined) -> void;
+
+    auto compile() -> Result<void>;
+
+    // Records the compiled schedule. The command list must not be inside a render or compute scope.
+    auto execute(MutRef<CommandList> cmd) -> void;
+
+    auto reset() -> void;
+
+    [[nodiscard]] auto get_culled_pass_count() const -> u32
+    {
+      return (u32) (m_passes.size() - m_schedule.size());
+    }
+
+    // Pass boundaries that issue a barrier, which bounds the number of vkCmdPipelineBarrier2 calls of execute().
+    [[nodiscard]] auto get_barrier_point_count() const -> u32
+    {
+      return m_barrier_point_count;
+    }
+
+    // Whether the pass, by the order passes were added in, survived culling in the last compile().
+    [[nodiscard]] auto is_pass_scheduled(u32 pass) const -> bool
+    {
+      return m_compiled && m_passes[pass].alive;
+    }
+
+#if !IAGPU_DISABLE_GRAPHICS
+    // Load and store ops compile() chose for the attachment `texture` of a scheduled render pass.
+    [[nodiscard]] auto get_attachment_ops(u32 pass, Texture texture) const -> std::pair<ELoadOp, EStoreOp>;
+#endif
+
+private:
+    enum class EAccess : u8
+    {
+      Read = 0,
+      Write,
+      ColorAttachment,
+      DepthAttachment,
+      ResolveAttachment,
+    };
+
+    struct Access
+    {
+      u32 resource;
+      EAccess access;
+      EResourceState state;
+      bool clear;
+      Texture resolve_target;
+      f32 clear_value[4];
+
+      // Filled in by compile() for attachments.
+      ELoadOp load_op;
+      EStoreOp store_op;
+    };
+
+    struct Pass
+    {
+      const char *name;
+      EPassType type;
+      PassCallback callback;
+      Vec<Access> accesses;
+      bool side_effects;
+      bool has_conflict;
+      bool alive;
+    };
+
+    struct Resource
+    {
+      void *handle;
+      bool is_texture;
+      bool imported;
+      bool exported;
+      EResourceState final_state;
+
+      // Compile state: schedule index of the last pass using the resource and the state it left it in, whether the
+      // contents at that point are worth keeping, and the attachment access whose store op a later use decides.
+      bool needed;
+      bool has_contents;
+      bool state_known;
+      i32 last_use;
+      EResourceState state;
+      Access *last_attachment;
+    };
+
+    struct Transition
+    {
+      u32 resource;
+      EResourceState state;
+      u32 earliest;
+      u32 latest;
+      u32 placement;
+      bool is_attachment;
+    };
+
+    auto add_pass(const char *name, EPassType type, PassCallback callback) -> PassBuilder;
+    auto add_access(u32 pass_index, void *handle, bool is_texture, EAccess access, EResourceState state)
+        -> MutRef<Access>;
+    auto get_resource(void *handle, bool is_texture) -> u32;
+
+    static auto overwrites_contents(Ref<Access> access) -> bool;
+
+    auto cull_passes() -> void;
+    auto resolve_accesses() -> void;
+    auto place_transitions() -> void;
+
+    auto record_transition(MutRef<CommandList> cmd, Ref<Transition> transition) -> void;
+
+    Vec<Pass> m_passes;
+    Vec<Resource> m_resources;
+    HashMap<u64, u32> m_texture_indices;
+    HashMap<u64, u32> m_buffer_indices;
+
+    // Compiled: indices of the passes that survived culling in execution order, and the transitions sorted by
+    // placement.
+    Vec<u32> m_schedule;
+    Vec<Transition> m_transitions;
+    u32 m_barrier_point_count{};
+    bool m_compiled{};
+  };
+} // namespace ia::gpu::vulkan
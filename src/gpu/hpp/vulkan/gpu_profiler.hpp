@@ -0,0 +1,111 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+#include <atomic>
+
+namespace ia::gpu::vulkan
+{
+  class Device;
+
+  // Named GPU timing scopes, recorded as pairs of timestamp queries.
+  //
+  // Every frame slot owns a timestamp query pool, so a slot's results are read back when the slot is reopened after
+  // its submission finished, never waiting on the GPU. Scopes nest per command list; lists recorded on worker threads
+  // form their own trees. Scope names are not copied and must outlive the frame's readback (literals are ideal).
+  class GpuProfiler
+  {
+public:
+    static constexpr u32 INVALID_SCOPE = UINT32_MAX;
+
+    // Kept by each command list: the track it was given in the slot use it last recorded a scope into.
+    struct Track
+    {
+      u64 slot_use{};
+      u32 index{};
+    };
+
+    auto initialize(Ref<Device> device, u32 queue_family, u32 max_scopes) -> Result<void>;
+    auto destroy() -> void;
+
+    // Reads the results the slot collected during its previous use, resets its pool and makes it the slot new scopes
+    // are recorded into. `submitted_value` is the main timeline value of that previous use.
+    auto open_slot(u32 slot, u64 submitted_value) -> void;
+
+    // Both are safe to call from several recording threads at once and take no lock: scope and track indices are
+    // reserved with atomics, and each scope's record is only written by the thread that reserved it. The returned
+    // handle names the slot the scope was begun in, so a list whose recording outlives its frame (async compute, worker
+    // threads) still ends the scope in that slot's pool. A parent begun in another slot is treated as no parent.
+    auto begin_scope(MutRef<Track> track, VkCommandBuffer cmd, u32 parent, const char *name) -> u32;
+    auto end_scope(VkCommandBuffer cmd, u32 scope) -> void;
+
+    [[nodiscard]] auto get_last_frame() const -> Ref<GpuFrameTimings>
+    {
+      return m_last_frame;
+    }
+
+private:
+    struct Scope
+    {
+      const char *name;
+      u32 parent;
+      u32 track;
+    };
+
+    // Handles interleave the slot index with the scope index in that slot.
+    static auto make_scope_handle(u32 slot, u32 scope) -> u32
+    {
+      return scope * MAX_PENDING_FRAME_COUNT + slot;
+    }
+
+    static auto get_scope_slot(u32 handle) -> u32
+    {
+      return handle % MAX_PENDING_FRAME_COUNT;
+    }
+
+    static auto get_scope_index(u32 handle) -> u32
+    {
+      return handle / MAX_PENDING_FRAME_COUNT;
+    }
+
+    // `scopes` is sized to max_scopes once, the counts may run past it when scopes overflow. `use` tells the slot's
+    // uses apart, a list whose Track carries an older one asks for a new track index.
+    struct Slot
+    {
+      VkQueryPool pool{VK_NULL_HANDLE};
+      Vec<Scope> scopes;
+      std::atomic<u32> scope_count{};
+      std::atomic<u32> track_count{};
+      u64 use{};
+    };
+
+    // Converts the slot's query results into m_last_frame and resets the slot for its next use.
+    auto read_back_slot(MutRef<Slot> slot, u64 submitted_value) -> void;
+
+    const Device *m_device{};
+    f32 m_timestamp_period{};
+    u32 m_max_scopes{};
+
+    Slot m_slots[MAX_PENDING_FRAME_COUNT];
+    std::atomic<u32> m_active_slot{};
+    u64 m_use_count{};
+
+    Vec<u64> m_query_results;
+    GpuFrameTimings m_last_frame;
+  };
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,38 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+namespace ia::gpu::vulkan
+{
+  // Deduplicated, reference counted descriptor set and pipeline layouts.
+  //
+  // Pipelines built from the same interface share one VkDescriptorSetLayout per set and one VkPipelineLayout, which
+  // keeps layouts compatible across pipelines so bound descriptor sets survive pipeline switches. Every function here
+  // takes ResourceTables::layout_mutex, so pipelines may be built from several threads at once.
+
+  // Returns the layout matching `entries`, creating it on first use. Each call holds one reference.
+  auto acquire_binding_layout(VkDevice device, MutRef<ResourceTables> resources,
+                              std::span<const BindingLayoutEntry> entries) -> Result<BindingLayout>;
+  auto release_binding_layout(VkDevice device, MutRef<ResourceTables> resources, BindingLayout layout) -> void;
+
+  // Points `pipeline.layout` and `pipeline.layout_key` at the pipeline layout for the given sets and push constants.
+  auto acquire_pipeline_layout(VkDevice device, MutRef<ResourceTables> resources,
+                               std::span<const BindingLayout> set_layouts, Ref<VkPushConstantRange> push_constant_range,
+                               MutRef<PipelineImpl> pipeline) -> Result<void>;
+  auto release_pipeline_layout(VkDevice device, MutRef<ResourceTables> resources, u64 key) -> void;
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,82 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+#include <string>
+
+namespace ia::gpu::vulkan
+{
+  // Owns the device's VkPipelineCache and persists it between runs.
+  //
+  // The file wraps the driver blob in a header carrying the vendor, device, driver version and pipeline cache UUID it
+  // was produced with, plus a checksum of the blob. A file that does not match the running device, or is truncated, is
+  // ignored and the cache starts empty. Saving writes a temporary file next to the target and renames it over, so an
+  // interrupted save never leaves a corrupt cache behind.
+  class PipelineCache
+  {
+public:
+    PipelineCache() = default;
+    ~PipelineCache();
+
+    PipelineCache(const PipelineCache &) = delete;
+    PipelineCache &operator=(const PipelineCache &) = delete;
+
+    PipelineCache(PipelineCache &&other) noexcept;
+    PipelineCache &operator=(PipelineCache &&other) noexcept;
+
+    // An empty path keeps the cache in memory only.
+    auto initialize(VkDevice device, VkPhysicalDevice physical_device, const char *path) -> Result<void>;
+
+    auto save() -> Result<void>;
+
+    // Saves the cache if it has a path and destroys it. The destructor does the same when this was not called.
+    auto destroy() -> void;
+
+    [[nodiscard]] auto get_handle() const -> VkPipelineCache
+    {
+      return m_handle;
+    }
+
+private:
+    struct FileHeader
+    {
+      u32 magic;
+      u32 version;
+      u32 vendor_id;
+      u32 device_id;
+      u32 driver_version;
+      u8 pipeline_cache_uuid[VK_UUID_SIZE];
+      u32 reserved; // keeps the header free of padding, it is compared with memcmp
+      u64 data_size;
+      u64 checksum;
+    };
+
+    static constexpr u32 FILE_MAGIC = 0x43504149; // "IAPC"
+    static constexpr u32 FILE_VERSION = 1;
+
+    auto load_file() -> Vec<u8>;
+    auto make_header(u64 data_size, u64 checksum) const -> FileHeader;
+    auto release() -> void;
+
+private:
+    VkDevice m_device{};
+    VkPipelineCache m_handle{VK_NULL_HANDLE};
+    VkPhysicalDeviceProperties m_properties{};
+    std::string m_path;
+  };
+} // namespace ia::gpu::vulkan
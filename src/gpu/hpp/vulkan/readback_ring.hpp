@@ -0,0 +1,132 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+#include <deque>
+#include <mutex>
+
+namespace ia::gpu::vulkan
+{
+  // Persistently mapped, host-cached ring that GPU copies read back into.
+  //
+  // Every copy gets a ticket that remembers the command buffer it was recorded into until that buffer is submitted,
+  // and the queue timeline value of the submission afterwards. Once the value is reached the ticket's range is
+  // invalidated (a no-op on coherent memory) and handed out in place. Ranges are reclaimed in allocation order as
+  // their tickets are released, so one ticket held for long keeps the ring from reusing anything after it. Copies
+  // that find the ring full, or are larger than half of it, spill into a dedicated buffer freed with their ticket.
+  // Readbacks may be recorded from thread lists, so every call takes the ring's lock.
+  class ReadbackRing
+  {
+public:
+    enum class EQueue
+    {
+      Main = 0,
+      AsyncCompute,
+    };
+
+    struct Allocation
+    {
+      ReadbackTicket ticket{};
+      VkBuffer buffer{VK_NULL_HANDLE};
+      u64 offset{};
+    };
+
+    auto initialize(VmaAllocator allocator, u64 capacity, std::span<const u32> queue_families) -> Result<void>;
+    auto destroy() -> void;
+
+    auto allocate(VkCommandBuffer cmd, u64 size) -> Result<Allocation>;
+
+    // Tickets recorded into `cmd` complete once `queue`'s timeline reaches `value`, 0 for a submission already waited.
+    auto submit(VkCommandBuffer cmd, EQueue queue, u64 value) -> void;
+
+    // Empty until the ticket's copy has completed, judged by the completed values of the two timelines.
+    auto get_data(ReadbackTicket ticket, u64 main_completed, u64 async_completed) -> std::span<const u8>;
+
+    // The range is reused once the copy has completed, releasing early only drops the result.
+    auto release(ReadbackTicket ticket, u64 main_completed, u64 async_completed) -> void;
+
+    // Reclaims the ranges of released tickets whose copies have completed.
+    auto collect(u64 main_completed, u64 async_completed) -> void;
+
+    [[nodiscard]] auto is_valid(ReadbackTicket ticket) const -> bool
+    {
+      return m_entries.is_valid(ticket);
+    }
+
+private:
+    struct Entry
+    {
+      VkCommandBuffer cmd{VK_NULL_HANDLE}; // null once submitted
+      EQueue queue{};
+      u64 value{};
+
+      VkBuffer buffer{VK_NULL_HANDLE};
+      VmaAllocation allocation{VK_NULL_HANDLE};
+      u8 *mapped{};
+      u64 offset{};
+      u64 size{};
+
+      // Ring entries only: head after the allocation and the bytes it consumed including alignment and wrap padding.
+      u64 end{};
+      u64 consumed{};
+
+      bool is_spill{};
+      bool is_invalidated{};
+      bool is_released{};
+    };
+
+    struct MappedBuffer
+    {
+      VkBuffer handle{VK_NULL_HANDLE};
+      VmaAllocation allocation{VK_NULL_HANDLE};
+      u8 *mapped{};
+    };
+
+    static auto is_complete(Ref<Entry> entry, u64 main_completed, u64 async_completed) -> bool;
+
+    // collect with the lock already held.
+    auto collect_locked(u64 main_completed, u64 async_completed) -> void;
+
+    auto create_buffer(u64 size) -> Result<MappedBuffer>;
+    auto allocate_from_ring(MutRef<Entry> entry) -> bool;
+    auto free_entry(ReadbackTicket ticket) -> void;
+
+    std::mutex m_mutex;
+
+    VmaAllocator m_allocator{};
+    Vec<u32> m_queue_families;
+
+    MappedBuffer m_ring{};
+    u64 m_capacity{};
+
+    u64 m_head{};
+    u64 m_tail{};
+    u64 m_used{};
+
+    SlotMap<Entry, ReadbackTicket> m_entries;
+
+    // Ring tickets in allocation order, the front one owns the tail of the ring.
+    std::deque<ReadbackTicket> m_ring_order;
+
+    // Tickets not yet submitted, few at a time.
+    Vec<ReadbackTicket> m_unsubmitted;
+
+    // Released spills whose copies may still be running.
+    Vec<ReadbackTicket> m_released_spills;
+  };
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,88 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/device.hpp>
+
+namespace ia::gpu::vulkan
+{
+  // Keeps the context under its memory ceiling by moving low priority allocations out of the way.
+  //
+  // Heap budgets are sampled once per frame. A device-local heap whose usage passes the pressure threshold puts the
+  // context under pressure until usage falls back below the threshold minus a margin. Under pressure new low priority
+  // resources are placed in host memory, and with pageable device-local memory the low priority allocations already on
+  // the heap are demoted, largest first, until they cover the overshoot. The driver pages demoted memory out when it
+  // needs the room and back in when it is used, so handles and descriptors stay valid. Demotions are undone once the
+  // pressure is gone.
+  class ResidencyManager
+  {
+public:
+    auto initialize(Ref<Device> device, f32 pressure_threshold) -> void;
+
+    // Allocation parameters for a resource of the given priority, `usage` being what it would get without pressure.
+    [[nodiscard]] auto build_allocation_create_info(EMemoryPriority priority, VmaMemoryUsage usage) const
+        -> VmaAllocationCreateInfo;
+
+    // Low priority allocations are tracked from creation until they are destroyed, anything else is ignored.
+    auto track(EMemoryPriority priority, VmaAllocation allocation, Ref<VmaAllocationInfo> info) -> void;
+    auto untrack(VmaAllocation allocation) -> void;
+
+    // Samples the budgets and demotes or restores tracked allocations. True when the context just came under pressure.
+    auto update() -> bool;
+
+    [[nodiscard]] auto get_budget() const -> MemoryBudget;
+
+    // Summed over the device-local heaps, for error messages.
+    [[nodiscard]] auto get_device_local_usage() const -> std::pair<u64, u64>;
+
+    [[nodiscard]] auto is_under_pressure() const -> bool
+    {
+      return m_is_under_pressure;
+    }
+
+private:
+    struct TrackedAllocation
+    {
+      VkDeviceMemory memory{};
+      u64 size{};
+      u32 heap{};
+      bool is_demoted{};
+    };
+
+    auto get_heap_budget(Ref<VmaBudget> budget) const -> u64;
+    auto demote(u32 heap, u64 bytes) -> void;
+    auto restore(u32 heap) -> void;
+
+private:
+    VkDevice m_device{};
+    VmaAllocator m_allocator{};
+    bool m_is_memory_budget_supported{};
+    bool m_is_memory_priority_supported{};
+    bool m_is_pageable_memory_supported{};
+    u64 m_device_memory_limit{};
+    f32 m_pressure_threshold{};
+
+    u32 m_heap_count{};
+    u32 m_memory_type_heaps[VK_MAX_MEMORY_TYPES]{};
+    bool m_is_heap_device_local[VK_MAX_MEMORY_HEAPS]{};
+    bool m_is_heap_under_pressure[VK_MAX_MEMORY_HEAPS]{};
+    u64 m_demoted_bytes[VK_MAX_MEMORY_HEAPS]{};
+    bool m_is_under_pressure{};
+    u32 m_frame_index{};
+
+    HashMap<VmaAllocation, TrackedAllocation> m_tracked;
+  };
+} // namespace ia::gpu::vulkan
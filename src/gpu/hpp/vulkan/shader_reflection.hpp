@@ -0,0 +1,30 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+namespace ia::gpu::vulkan
+{
+  // Reads the descriptor bindings and the push constant block size of a SPIR-V module. Every binding is made visible
+  // to `stage` only.
+  auto reflect_shader(std::span<const u32> words, EShaderStage stage) -> Result<ShaderReflection>;
+
+  // Merges the reflected interfaces of a pipeline's shaders into one sorted entry list per descriptor set. A binding
+  // used by several stages becomes one entry visible to all of them, a binding whose type or count differs between
+  // stages fails. Sets in between that no shader uses come back empty.
+  auto merge_shader_bindings(std::span<const ShaderReflection *const> shaders) -> Result<Vec<Vec<BindingLayoutEntry>>>;
+} // namespace ia::gpu::vulkan
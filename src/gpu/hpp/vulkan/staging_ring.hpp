@@ -0,0 +1,84 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+namespace ia::gpu::vulkan
+{
+  // Persistently mapped upload ring shared by the pending frames.
+  //
+  // Allocations made while a frame is recording are charged to that frame and the whole region is reclaimed at once
+  // when the frame's fence signals, so frames retire in submission order and the ring never needs per-allocation
+  // bookkeeping. Uploads larger than a frame's share of the ring, or that find the ring full, spill into a dedicated
+  // buffer that is released together with the frame instead of stalling the ring.
+  class StagingRing
+  {
+public:
+    struct Allocation
+    {
+      Buffer buffer{};
+      u64 offset{};
+      void *mapped{};
+    };
+
+    auto initialize(VmaAllocator allocator, ResourceTables *resources, u64 capacity) -> Result<void>;
+    auto destroy() -> void;
+
+    auto allocate(u64 size, u64 alignment) -> Result<Allocation>;
+    auto flush(Ref<Allocation> allocation, u64 size) -> void;
+
+    // The frame's fence has signaled, everything it allocated can be reused.
+    auto retire_frame(u32 frame_index) -> void;
+
+    // The frame has been submitted, everything allocated since the previous close belongs to it.
+    auto close_frame(u32 frame_index) -> void;
+
+    [[nodiscard]] auto get_stats() const -> StagingStats;
+
+private:
+    auto create_buffer(u64 size) -> Result<Allocation>;
+    auto destroy_buffer(Buffer buffer) -> void;
+
+    auto spill(u64 size) -> Result<Allocation>;
+
+private:
+    struct FrameRegion
+    {
+      u64 end{};
+      u64 bytes{};
+      Vec<Buffer> spills;
+      bool in_flight{};
+    };
+
+    VmaAllocator m_allocator{};
+    ResourceTables *m_resources{};
+
+    Buffer m_buffer{};
+    u8 *m_mapped{};
+    u64 m_capacity{};
+
+    u64 m_head{};
+    u64 m_tail{};
+    u64 m_used{};
+
+    u64 m_open_bytes{};
+    Vec<Buffer> m_open_spills;
+    FrameRegion m_frames[MAX_PENDING_FRAME_COUNT];
+
+    StagingStats m_stats{};
+  };
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,81 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/base.hpp>
+
+#include <functional>
+
+namespace ia::gpu::vulkan
+{
+  // Monotonically increasing submission counter of one queue, backed by a timeline semaphore.
+  //
+  // Every submission signals the next value, so "has submission N finished" is a single counter comparison and the
+  // host can wait on any earlier submission without owning a fence for it. Value 0 is signaled from the start and
+  // stands for "no submission".
+  class Timeline
+  {
+public:
+    auto initialize(VkDevice device, const char *name) -> Result<void>;
+    auto destroy() -> void;
+
+    // Reserves the value the next submission to this queue signals.
+    auto advance() -> u64;
+
+    [[nodiscard]] auto get_signal_info(u64 value, VkPipelineStageFlags2 stage) const -> VkSemaphoreSubmitInfo;
+    [[nodiscard]] auto get_wait_info(u64 value, VkPipelineStageFlags2 stage) const -> VkSemaphoreSubmitInfo;
+
+    [[nodiscard]] auto get_completed_value() const -> u64;
+    auto wait(u64 value, u64 timeout) const -> bool;
+
+    [[nodiscard]] auto get_last_submitted_value() const -> u64
+    {
+      return m_last_submitted_value;
+    }
+
+    [[nodiscard]] auto get_semaphore() const -> VkSemaphore
+    {
+      return m_semaphore;
+    }
+
+private:
+    VkDevice m_device{};
+    VkSemaphore m_semaphore{VK_NULL_HANDLE};
+    u64 m_last_submitted_value{};
+  };
+
+  // Releases that have to wait until the GPU is done with the object, keyed by a timeline value.
+  class DeferredReleaseQueue
+  {
+public:
+    auto push(u64 value, std::function<void()> release) -> void;
+
+    // Runs every release whose value has been reached, in the order they were pushed.
+    auto collect(u64 completed_value) -> void;
+
+    // Runs everything regardless of its value, the caller guarantees the device is idle.
+    auto drain() -> void;
+
+private:
+    struct Entry
+    {
+      u64 value{};
+      std::function<void()> release;
+    };
+
+    Vec<Entry> m_entries;
+  };
+} // namespace ia::gpu::vulkan
@@ -0,0 +1,114 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vulkan/command_list.hpp>
+#include <vulkan/staging_ring.hpp>
+#include <vulkan/timeline.hpp>
+
+namespace ia::gpu::vulkan
+{
+  // Records uploads on the dedicated transfer queue so that streaming overlaps with the graphics/compute queue.
+  //
+  // Uploads are batched into one transfer submission that signals a timeline semaphore value. The consumer queue
+  // waits on that value and acquires ownership of the uploaded resources before using them. A batch in turn waits for
+  // the main queue submissions made before its uploads were recorded, so it never overwrites what those still use.
+  // Only the texture subresources a copy writes are transitioned, from the layout the main queue tracks for them and
+  // back to it afterwards, so other mips and layers keep their contents and the tracking stays untouched. Subresources
+  // that were never used end up in the GeneralRead state. A consumer family of VK_QUEUE_FAMILY_IGNORED means resources
+  // are shared concurrently and need no ownership transfer.
+  class UploadQueue
+  {
+public:
+    auto initialize(VkDevice device, VmaAllocator allocator, ResourceTables *resources, VkQueue queue,
+                    u32 queue_family, u32 consumer_queue_family, VkSemaphore main_timeline, u64 ring_size)
+        -> Result<void>;
+    auto destroy() -> void;
+
+    // Both return the timeline value that signals once the upload is complete, which is the value of the open batch.
+    // The batch waits for `main_wait_value` on the main timeline, the last main queue submission that may use `dst`.
+    auto upload_buffer(Buffer dst, u64 offset, std::span<const u8> data, u64 main_wait_value) -> Result<u64>;
+    auto upload_texture(Texture dst, std::span<const u8> data, std::span<const BufferTextureCopyRegion> regions,
+                        u64 main_wait_value) -> Result<u64>;
+
+    // Submits the open batch. Returns the last submitted timeline value.
+    auto flush() -> Result<u64>;
+
+    [[nodiscard]] auto get_completed_value() const -> u64;
+    auto wait(u64 value, u64 timeout) const -> bool;
+
+    // Records the consumer side of the ownership transfers submitted since the last call and returns the timeline
+    // value the consumer submission must wait on, or 0 if there is nothing new to wait for.
+    auto acquire_submitted(MutRef<CommandList> cmd) -> u64;
+
+    [[nodiscard]] auto has_unacquired_uploads() const -> bool
+    {
+      return m_last_acquired_value != m_timeline.get_last_submitted_value();
+    }
+
+    [[nodiscard]] auto get_timeline() const -> Ref<Timeline>
+    {
+      return m_timeline;
+    }
+
+private:
+    auto open_batch(u64 main_wait_value) -> Result<VkCommandBuffer>;
+    auto retire_completed_batches() -> void;
+
+private:
+    struct Batch
+    {
+      VkCommandBuffer command_buffer{VK_NULL_HANDLE};
+      u64 value{};
+      u64 main_wait_value{};
+      bool recording{};
+      bool in_flight{};
+    };
+
+    VkDevice m_device{};
+    ResourceTables *m_resources{};
+
+    VkQueue m_queue{};
+    VkSemaphore m_main_timeline{VK_NULL_HANDLE};
+    u32 m_queue_family{};
+    u32 m_consumer_queue_family{};
+
+    Timeline m_timeline;
+    VkCommandPool m_command_pool{VK_NULL_HANDLE};
+
+    Batch m_batches[MAX_PENDING_FRAME_COUNT];
+    u32 m_batch_index{};
+
+    u64 m_last_acquired_value{};
+
+    // A texture written by the open batch, with the state each subresource goes back to once the batch is done. Indexed
+    // like TextureImpl's own states, layer-major.
+    struct OpenTexture
+    {
+      Texture texture{};
+      Vec<bool> written;
+      Vec<EResourceState> restore_states;
+    };
+
+    Vec<Buffer> m_open_buffers;
+    Vec<OpenTexture> m_open_textures;
+
+    Vec<VkBufferMemoryBarrier2> m_acquire_buffer_barriers;
+    Vec<VkImageMemoryBarrier2> m_acquire_image_barriers;
+
+    StagingRing m_staging;
+  };
+} // namespace ia::gpu::vulkan
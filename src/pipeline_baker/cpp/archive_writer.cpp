@@ -0,0 +1,152 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <archive_writer.hpp>
+
+#include <cstring>
+#include <fstream>
+
+namespace ia::gpu::baker
+{
+  static auto align_up(u64 value, u64 alignment) -> u64
+  {
+    return (value + alignment - 1) & ~(alignment - 1);
+  }
+
+  auto ArchiveWriter::add_string(std::string_view text) -> PipelineArchiveString
+  {
+    const PipelineArchiveString result{
+        .offset = (u32) m_strings.size(),
+        .length = (u32) text.size(),
+    };
+    m_strings.append(text);
+    return result;
+  }
+
+  auto ArchiveWriter::add_shader(Ref<std::string> name, Ref<ShaderDecl> decl, Ref<CompiledShader> shader) -> u32
+  {
+    m_shaders.push_back({
+        .name = add_string(name),
+        .entry_point = add_string(decl.entry_point),
+        .code_size = shader.spirv.size() * sizeof(u32),
+        .stage = (u32) decl.stage,
+        .first_binding = (u32) m_bindings.size(),
+        .binding_count = (u32) shader.bindings.size(),
+        .push_constant_size = shader.push_constant_size,
+    });
+    m_code.push_back(shader.spirv);
+    m_bindings.insert(m_bindings.end(), shader.bindings.begin(), shader.bindings.end());
+
+    return (u32) m_shaders.size() - 1;
+  }
+
+  auto ArchiveWriter::add_pipeline(Ref<std::string> name, Ref<PipelineDecl> decl, std::span<const u32> shader_indices)
+      -> void
+  {
+    Mut<PipelineArchivePipeline> pipeline = decl.fixed_state;
+    pipeline.name = add_string(name);
+
+    if (decl.is_graphics)
+    {
+      pipeline.vertex_shader = shader_indices[0];
+      pipeline.fragment_shader = shader_indices[1];
+    }
+    else
+    {
+      pipeline.compute_shader = shader_indices[0];
+
+      // Compute pipelines take their push constant range from the shader itself.
+      pipeline.push_constant_size = m_shaders[shader_indices[0]].push_constant_size;
+    }
+
+    pipeline.first_vertex_binding = (u32) m_vertex_bindings.size();
+    pipeline.vertex_binding_count = (u32) decl.vertex_bindings.size();
+    pipeline.first_vertex_attribute = (u32) m_vertex_attributes.size();
+    pipeline.vertex_attribute_count = (u32) decl.vertex_attributes.size();
+    m_vertex_bindings.insert(m_vertex_bindings.end(), decl.vertex_bindings.begin(), decl.vertex_bindings.end());
+    m_vertex_attributes.insert(m_vertex_attributes.end(), decl.vertex_attributes.begin(),
+                               decl.vertex_attributes.end());
+
+    m_pipelines.push_back(pipeline);
+  }
+
+  auto ArchiveWriter::write(Ref<std::filesystem::path> path) const -> Result<void>
+  {
+    Mut<PipelineArchiveHeader> header{
+        .magic = PIPELINE_ARCHIVE_MAGIC,
+        .version = PIPELINE_ARCHIVE_VERSION,
+        .shader_count = (u32) m_shaders.size(),
+        .pipeline_count = (u32) m_pipelines.size(),
+        .binding_count = (u32) m_bindings.size(),
+        .vertex_binding_count = (u32) m_vertex_bindings.size(),
+        .vertex_attribute_count = (u32) m_vertex_attributes.size(),
+    };
+
+    // Layout: header, tables, string table, then the SPIR-V blobs, each section 8-byte aligned.
+    Mut<u64> offset = sizeof(PipelineArchiveHeader);
+    const auto place = [&](u64 size) {
+      const u64 start = align_up(offset, 8);
+      offset = start + size;
+      return start;
+    };
+    header.shader_table_offset = place(m_shaders.size() * sizeof(PipelineArchiveShader));
+    header.pipeline_table_offset = place(m_pipelines.size() * sizeof(PipelineArchivePipeline));
+    header.binding_table_offset = place(m_bindings.size() * sizeof(PipelineArchiveBinding));
+    header.vertex_binding_table_offset = place(m_vertex_bindings.size() * sizeof(PipelineArchiveVertexBinding));
+    header.vertex_attribute_table_offset =
+        place(m_vertex_attributes.size() * sizeof(PipelineArchiveVertexAttribute));
+    header.string_table_offset = place(m_strings.size());
+    header.string_table_size = m_strings.size();
+
+    Mut<Vec<PipelineArchiveShader>> shaders = m_shaders;
+    for (Mut<u64> i = 0; i < shaders.size(); i++)
+      shaders[i].code_offset = place(shaders[i].code_size);
+
+    Mut<Vec<u8>> data(offset, 0);
+    const auto copy = [&](u64 at, const void *src, u64 size) {
+      if (size)
+        memcpy(data.data() + at, src, size);
+    };
+    copy(0, &header, sizeof(header));
+    copy(header.shader_table_offset, shaders.data(), shaders.size() * sizeof(PipelineArchiveShader));
+    copy(header.pipeline_table_offset, m_pipelines.data(), m_pipelines.size() * sizeof(PipelineArchivePipeline));
+    copy(header.binding_table_offset, m_bindings.data(), m_bindings.size() * sizeof(PipelineArchiveBinding));
+    copy(header.vertex_binding_table_offset, m_vertex_bindings.data(),
+         m_vertex_bindings.size() * sizeof(PipelineArchiveVertexBinding));
+    copy(header.vertex_attribute_table_offset, m_vertex_attributes.data(),
+         m_vertex_attributes.size() * sizeof(PipelineArchiveVertexAttribute));
+    copy(header.string_table_offset, m_strings.data(), m_strings.size());
+    for (Mut<u64> i = 0; i < shaders.size(); i++)
+      copy(shaders[i].code_offset, m_code[i].data(), shaders[i].code_size);
+
+    const std::filesystem::path temp_path = path.string() + ".tmp";
+    {
+      Mut<std::ofstream> file(temp_path, std::ios::binary | std::ios::trunc);
+      if (!file)
+        return fail("failed to open '{}' for writing", temp_path.string());
+
+      file.write(reinterpret_cast<const char *>(data.data()), (std::streamsize) data.size());
+      if (!file.flush())
+        return fail("failed to write '{}'", temp_path.string());
+    }
+
+    Mut<std::error_code> ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec)
+      return fail("failed to replace '{}': {}", path.string(), ec.message());
+
+    return {};
+  }
+} // namespace ia::gpu::baker
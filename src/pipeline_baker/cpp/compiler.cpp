@@ -0,0 +1,189 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <compiler.hpp>
+
+#include <spirv_reflect.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ia::gpu::baker
+{
+  static auto map_stage(EShaderStage stage) -> SlangStage
+  {
+    switch (stage)
+    {
+    case EShaderStage::Vertex:
+      return SLANG_STAGE_VERTEX;
+    case EShaderStage::Fragment:
+      return SLANG_STAGE_FRAGMENT;
+    case EShaderStage::Compute:
+      return SLANG_STAGE_COMPUTE;
+    default:
+      return SLANG_STAGE_NONE;
+    }
+  }
+
+  static auto diagnostics_text(slang::IBlob *diagnostics) -> std::string
+  {
+    if (!diagnostics)
+      return "no diagnostics";
+    return std::string(static_cast<const char *>(diagnostics->getBufferPointer()), diagnostics->getBufferSize());
+  }
+
+  auto ShaderCompiler::initialize(Ref<Vec<std::string>> include_dirs) -> Result<void>
+  {
+    m_include_dirs = include_dirs;
+
+    if (SLANG_FAILED(slang::createGlobalSession(m_global_session.writeRef())))
+      return fail("failed to create the Slang global session");
+
+    return {};
+  }
+
+  auto ShaderCompiler::compile(Ref<ShaderDecl> decl, Ref<ShaderPermutation> permutation) -> Result<CompiledShader>
+  {
+    const slang::TargetDesc target_desc{
+        .format = SLANG_SPIRV,
+        .profile = m_global_session->findProfile("spirv_1_5"),
+    };
+
+    // Sources may import modules next to them as well as from the include directories.
+    const std::string source_dir = decl.source.parent_path().string();
+    Mut<Vec<const char *>> search_paths{source_dir.c_str()};
+    for (const auto &dir : m_include_dirs)
+      search_paths.push_back(dir.c_str());
+
+    Mut<Vec<slang::PreprocessorMacroDesc>> macros;
+    for (const auto &[name, value] : permutation.defines)
+      macros.push_back({name.c_str(), value.c_str()});
+
+    Mut<slang::SessionDesc> session_desc{};
+    session_desc.targets = &target_desc;
+    session_desc.targetCount = 1;
+    session_desc.searchPaths = search_paths.data();
+    session_desc.searchPathCount = (SlangInt) search_paths.size();
+    session_desc.preprocessorMacros = macros.data();
+    session_desc.preprocessorMacroCount = (SlangInt) macros.size();
+
+    Mut<Slang::ComPtr<slang::ISession>> session;
+    if (SLANG_FAILED(m_global_session->createSession(session_desc, session.writeRef())))
+      return fail("failed to create a Slang session for '{}'", permutation.name);
+
+    Mut<Slang::ComPtr<slang::IBlob>> diagnostics;
+
+    slang::IModule *module = session->loadModule(decl.source.string().c_str(), diagnostics.writeRef());
+    if (!module)
+      return fail("'{}': {}", decl.source.string(), diagnostics_text(diagnostics));
+
+    Mut<Slang::ComPtr<slang::IEntryPoint>> entry_point;
+    if (SLANG_FAILED(module->findAndCheckEntryPoint(decl.entry_point.c_str(), map_stage(decl.stage),
+                                                    entry_point.writeRef(), diagnostics.writeRef())))
+      return fail("'{}': entry point '{}': {}", decl.source.string(), decl.entry_point, diagnostics_text(diagnostics));
+
+    slang::IComponentType *components[] = {module, entry_point};
+    Mut<Slang::ComPtr<slang::IComponentType>> composite;
+    if (SLANG_FAILED(session->createCompositeComponentType(components, 2, composite.writeRef(),
+                                                           diagnostics.writeRef())))
+      return fail("'{}': {}", permutation.name, diagnostics_text(diagnostics));
+
+    Mut<Slang::ComPtr<slang::IComponentType>> linked;
+    if (SLANG_FAILED(composite->link(linked.writeRef(), diagnostics.writeRef())))
+      return fail("'{}': linking failed: {}", permutation.name, diagnostics_text(diagnostics));
+
+    Mut<Slang::ComPtr<slang::IBlob>> code;
+    if (SLANG_FAILED(linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef())))
+      return fail("'{}': code generation failed: {}", permutation.name, diagnostics_text(diagnostics));
+
+    if (code->getBufferSize() % sizeof(u32))
+      return fail("'{}': SPIR-V size is not a multiple of 4", permutation.name);
+
+    Mut<CompiledShader> result;
+    result.spirv.resize(code->getBufferSize() / sizeof(u32));
+    memcpy(result.spirv.data(), code->getBufferPointer(), code->getBufferSize());
+
+    AU_TRY_PURE(reflect_spirv(result.spirv, decl.stage, result));
+
+    return result;
+  }
+
+  static auto map_descriptor_type(SpvReflectDescriptorType type) -> Result<EDescriptorType>
+  {
+    switch (type)
+    {
+    case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+      return EDescriptorType::UniformBuffer;
+    case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+      return EDescriptorType::StorageBuffer;
+    case SPV_REFLECT_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+    case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+      return EDescriptorType::SampledImage;
+    case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+      return EDescriptorType::StorageImage;
+    default:
+      return fail("descriptor type {} has no EDescriptorType equivalent", (i32) type);
+    }
+  }
+
+  auto reflect_spirv(std::span<const u32> spirv, EShaderStage stage, MutRef<CompiledShader> out) -> Result<void>
+  {
+    Mut<SpvReflectShaderModule> module{};
+    if (spvReflectCreateShaderModule(spirv.size_bytes(), spirv.data(), &module) != SPV_REFLECT_RESULT_SUCCESS)
+      return fail("failed to reflect SPIR-V");
+
+    Mut<u32> binding_count = 0;
+    spvReflectEnumerateDescriptorBindings(&module, &binding_count, nullptr);
+    Mut<Vec<SpvReflectDescriptorBinding *>> bindings(binding_count);
+    spvReflectEnumerateDescriptorBindings(&module, &binding_count, bindings.data());
+
+    Mut<Result<void>> result{};
+    for (const auto *binding : bindings)
+    {
+      const auto type = map_descriptor_type(binding->descriptor_type);
+      if (!type)
+      {
+        result = fail("binding {}.{} ('{}'): {}", binding->set, binding->binding,
+                      binding->name ? binding->name : "", type.error());
+        break;
+      }
+
+      out.bindings.push_back({
+          .set = binding->set,
+          .binding = binding->binding,
+          .count = std::max(binding->count, 1u),
+          .type = (u32) *type,
+          .visibility = (u32) stage,
+      });
+    }
+
+    Mut<u32> push_constant_count = 0;
+    spvReflectEnumeratePushConstantBlocks(&module, &push_constant_count, nullptr);
+    Mut<Vec<SpvReflectBlockVariable *>> push_constants(push_constant_count);
+    spvReflectEnumeratePushConstantBlocks(&module, &push_constant_count, push_constants.data());
+    for (const auto *block : push_constants)
+      out.push_constant_size = std::max(out.push_constant_size, block->offset + block->size);
+
+    spvReflectDestroyShaderModule(&module);
+
+    // Sorted so that identical interfaces produce identical tables regardless of declaration order.
+    std::sort(out.bindings.begin(), out.bindings.end(),
+              [](Ref<PipelineArchiveBinding> a, Ref<PipelineArchiveBinding> b) {
+                return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+              });
+
+    return result;
+  }
+} // namespace ia::gpu::baker
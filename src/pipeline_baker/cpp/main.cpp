@@ -0,0 +1,165 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <archive_writer.hpp>
+
+#include <cstdio>
+
+using namespace ia;
+using namespace ia::gpu;
+using namespace ia::gpu::baker;
+
+static constexpr const char *USAGE = "usage: iagpu_pipeline_baker <manifest> -o <archive> [-I <include dir>]...\n";
+
+struct Options
+{
+  std::filesystem::path manifest;
+  std::filesystem::path output;
+  Vec<std::string> include_dirs;
+};
+
+static auto parse_options(int argc, char **argv) -> Result<Options>
+{
+  Mut<Options> options;
+  for (Mut<int> i = 1; i < argc; i++)
+  {
+    const std::string_view arg = argv[i];
+    if ((arg == "-o" || arg == "-I") && i + 1 == argc)
+      return fail("'{}' expects a value", arg);
+
+    if (arg == "-o")
+      options.output = argv[++i];
+    else if (arg == "-I")
+      options.include_dirs.emplace_back(argv[++i]);
+    else if (options.manifest.empty())
+      options.manifest = arg;
+    else
+      return fail("unexpected argument '{}'", arg);
+  }
+
+  if (options.manifest.empty() || options.output.empty())
+    return fail("a manifest and an output path are required");
+
+  return options;
+}
+
+// The part of a permutation name inside the brackets, empty for a shader without macros.
+static auto get_permutation_suffix(Ref<std::string> name) -> std::string_view
+{
+  const u64 open = name.find('[');
+  if (open == std::string::npos)
+    return {};
+  return std::string_view(name).substr(open + 1, name.size() - open - 2);
+}
+
+static auto bake(Ref<Options> options) -> Result<void>
+{
+  const Manifest manifest = AU_TRY(parse_manifest(options.manifest));
+
+  Mut<ShaderCompiler> compiler;
+  AU_TRY_PURE(compiler.initialize(options.include_dirs));
+
+  Mut<ArchiveWriter> writer;
+
+  // Archive shader indices and names of every permutation, per shader declaration.
+  Mut<HashMap<std::string, u32>> decl_indices;
+  Mut<Vec<Vec<std::pair<u32, std::string>>>> permutations(manifest.shaders.size());
+
+  for (Mut<u32> i = 0; i < manifest.shaders.size(); i++)
+  {
+    Ref<ShaderDecl> decl = manifest.shaders[i];
+    if (!decl_indices.emplace(decl.name, i).second)
+      return fail("shader '{}' is declared twice", decl.name);
+
+    for (const auto &permutation : expand_permutations(manifest, i))
+    {
+      BAKER_LOG_INFO("Compiling {}", permutation.name);
+      const CompiledShader shader = AU_TRY(compiler.compile(decl, permutation));
+      permutations[i].emplace_back(writer.add_shader(permutation.name, decl, shader), permutation.name);
+    }
+  }
+
+  for (const auto &pipeline : manifest.pipelines)
+  {
+    const EShaderStage expected_stages[] = {pipeline.is_graphics ? EShaderStage::Vertex : EShaderStage::Compute,
+                                            EShaderStage::Fragment};
+
+    Mut<Vec<u32>> shader_decls;
+    for (Mut<u32> i = 0; i < pipeline.shaders.size(); i++)
+    {
+      const auto it = decl_indices.find(pipeline.shaders[i]);
+      if (it == decl_indices.end())
+        return fail("pipeline '{}' uses undeclared shader '{}'", pipeline.name, pipeline.shaders[i]);
+      if (manifest.shaders[it->second].stage != expected_stages[i])
+        return fail("pipeline '{}': shader '{}' has the wrong stage", pipeline.name, pipeline.shaders[i]);
+      shader_decls.push_back(it->second);
+    }
+
+    // One pipeline per combination of the permutations of its shaders, counting like an odometer.
+    Mut<Vec<u32>> choice(shader_decls.size(), 0);
+    while (true)
+    {
+      Mut<Vec<u32>> shader_indices;
+      Mut<std::string> suffix;
+      for (Mut<u32> i = 0; i < shader_decls.size(); i++)
+      {
+        Ref<std::pair<u32, std::string>> permutation = permutations[shader_decls[i]][choice[i]];
+        shader_indices.push_back(permutation.first);
+
+        const auto shader_suffix = get_permutation_suffix(permutation.second);
+        if (!shader_suffix.empty())
+        {
+          if (!suffix.empty())
+            suffix += ',';
+          suffix += shader_suffix;
+        }
+      }
+      writer.add_pipeline(suffix.empty() ? pipeline.name : pipeline.name + '[' + suffix + ']', pipeline,
+                          shader_indices);
+
+      Mut<u64> digit = shader_decls.size();
+      while (digit > 0 && ++choice[digit - 1] == permutations[shader_decls[digit - 1]].size())
+        choice[--digit] = 0;
+      if (digit == 0)
+        break;
+    }
+  }
+
+  AU_TRY_PURE(writer.write(options.output));
+
+  BAKER_LOG_INFO("Wrote {} shaders and {} pipelines to {}", writer.get_shader_count(), writer.get_pipeline_count(),
+                 options.output.string());
+  return {};
+}
+
+int main(int argc, char **argv)
+{
+  const auto options = parse_options(argc, argv);
+  if (!options)
+  {
+    BAKER_LOG_ERROR("{}", options.error());
+    fputs(USAGE, stderr);
+    return 2;
+  }
+
+  const auto result = bake(*options);
+  if (!result)
+  {
+    BAKER_LOG_ERROR("{}", result.error());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,322 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <manifest.hpp>
+
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+namespace ia::gpu::baker
+{
+  template<typename E> struct NamedValue
+  {
+    const char *name;
+    E value;
+  };
+
+  static constexpr NamedValue<EShaderStage> SHADER_STAGES[] = {
+      {"vertex", EShaderStage::Vertex},
+      {"fragment", EShaderStage::Fragment},
+      {"compute", EShaderStage::Compute},
+      {"all", EShaderStage::All},
+  };
+
+  static constexpr NamedValue<EFormat> FORMATS[] = {
+      {"rgba8_unorm", EFormat::R8G8B8A8Unorm},
+      {"rgba8_srgb", EFormat::R8G8B8A8Srgb},
+      {"bgra8_srgb", EFormat::B8G8R8A8Srgb},
+      {"bgra8_unorm", EFormat::B8G8R8A8Unorm},
+      {"r32_uint", EFormat::R32Uint},
+      {"r32_float", EFormat::R32Float},
+      {"rg32_float", EFormat::R32G32Float},
+      {"rgb32_float", EFormat::R32G32B32Float},
+      {"rgba32_float", EFormat::R32G32B32A32Float},
+      {"d16_unorm", EFormat::D16Unorm},
+      {"d16_unorm_s8_uint", EFormat::D16UnormS8Uint},
+      {"d24_unorm_s8_uint", EFormat::D24UnormS8Uint},
+      {"d32_float", EFormat::D32Sfloat},
+      {"d32_float_s8_uint", EFormat::D32SfloatS8Uint},
+  };
+
+  static constexpr NamedValue<ECullMode> CULL_MODES[] = {
+      {"none", ECullMode::None},
+      {"back", ECullMode::Back},
+      {"front", ECullMode::Front},
+  };
+
+  static constexpr NamedValue<EBlendMode> BLEND_MODES[] = {
+      {"opaque", EBlendMode::Opaque},
+      {"alpha", EBlendMode::Alpha},
+      {"premultiplied", EBlendMode::Premultiplied},
+      {"additive", EBlendMode::Additive},
+      {"multiply", EBlendMode::Multiply},
+      {"modulate", EBlendMode::Modulate},
+  };
+
+  static constexpr NamedValue<EPolygonMode> POLYGON_MODES[] = {
+      {"fill", EPolygonMode::Fill},
+      {"line", EPolygonMode::Line},
+      {"point", EPolygonMode::Point},
+  };
+
+  static constexpr NamedValue<EPrimitiveType> PRIMITIVE_TYPES[] = {
+      {"points", EPrimitiveType::PointList},
+      {"lines", EPrimitiveType::LineList},
+      {"line_strip", EPrimitiveType::LineStrip},
+      {"triangles", EPrimitiveType::TriangleList},
+      {"triangle_strip", EPrimitiveType::TriangleStrip},
+  };
+
+  template<typename E, u64 N> static auto lookup(const NamedValue<E> (&table)[N], std::string_view name) -> Result<E>
+  {
+    for (const auto &entry : table)
+    {
+      if (name == entry.name)
+        return entry.value;
+    }
+    return fail("unknown value '{}'", name);
+  }
+
+  static auto split(std::string_view text, char separator) -> Vec<std::string_view>
+  {
+    Mut<Vec<std::string_view>> parts;
+    Mut<u64> begin = 0;
+    while (true)
+    {
+      const u64 end = text.find(separator, begin);
+      parts.push_back(text.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin));
+      if (end == std::string_view::npos)
+        break;
+      begin = end + 1;
+    }
+    return parts;
+  }
+
+  static auto parse_u32(std::string_view text) -> Result<u32>
+  {
+    Mut<u32> value{};
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || ptr != text.data() + text.size())
+      return fail("'{}' is not a number", text);
+    return value;
+  }
+
+  static auto parse_graphics_key(MutRef<PipelineDecl> pipeline, std::string_view key, std::string_view value)
+      -> Result<void>
+  {
+    MutRef<PipelineArchivePipeline> state = pipeline.fixed_state;
+
+    if (key == "color")
+    {
+      for (const auto format : split(value, ','))
+      {
+        if (state.color_attachment_count == 7)
+          return fail("more than 7 color attachments");
+        state.color_formats[state.color_attachment_count++] = (u32) AU_TRY(lookup(FORMATS, format));
+      }
+    }
+    else if (key == "depth")
+      state.depth_format = (u32) AU_TRY(lookup(FORMATS, value));
+    else if (key == "cull")
+      state.cull_mode = (u32) AU_TRY(lookup(CULL_MODES, value));
+    else if (key == "blend")
+      state.blend_mode = (u32) AU_TRY(lookup(BLEND_MODES, value));
+    else if (key == "polygon")
+      state.polygon_mode = (u32) AU_TRY(lookup(POLYGON_MODES, value));
+    else if (key == "topology")
+      state.primitive_type = (u32) AU_TRY(lookup(PRIMITIVE_TYPES, value));
+    else if (key == "push")
+      state.push_constant_size = AU_TRY(parse_u32(value));
+    else if (key == "vb")
+    {
+      const auto fields = split(value, ':');
+      if (fields.size() < 2 || fields.size() > 3 || (fields.size() == 3 && fields[2] != "instance"))
+        return fail("vb expects <binding>:<stride>[:instance]");
+      pipeline.vertex_bindings.push_back({
+          .binding = AU_TRY(parse_u32(fields[0])),
+          .stride = AU_TRY(parse_u32(fields[1])),
+          .input_rate = (u32) (fields.size() == 3 ? EInputRate::Instance : EInputRate::Vertex),
+      });
+    }
+    else if (key == "va")
+    {
+      const auto fields = split(value, ':');
+      if (fields.size() != 4)
+        return fail("va expects <location>:<binding>:<format>:<offset>");
+      pipeline.vertex_attributes.push_back({
+          .location = AU_TRY(parse_u32(fields[0])),
+          .binding = AU_TRY(parse_u32(fields[1])),
+          .format = (u32) AU_TRY(lookup(FORMATS, fields[2])),
+          .offset = AU_TRY(parse_u32(fields[3])),
+      });
+    }
+    else
+      return fail("unknown graphics key '{}'", key);
+
+    return {};
+  }
+
+  static auto make_pipeline_decl(std::string name, bool is_graphics) -> PipelineDecl
+  {
+    Mut<PipelineDecl> pipeline{.name = std::move(name), .is_graphics = is_graphics};
+
+    // Same defaults as GraphicsPipelineDesc.
+    MutRef<PipelineArchivePipeline> state = pipeline.fixed_state;
+    state.compute_shader = PIPELINE_ARCHIVE_INVALID_INDEX;
+    state.vertex_shader = PIPELINE_ARCHIVE_INVALID_INDEX;
+    state.fragment_shader = PIPELINE_ARCHIVE_INVALID_INDEX;
+    state.push_constant_stages = (u32) (is_graphics ? EShaderStage::All : EShaderStage::Compute);
+    state.cull_mode = (u32) ECullMode::Back;
+    state.blend_mode = (u32) EBlendMode::Alpha;
+    state.polygon_mode = (u32) EPolygonMode::Fill;
+    state.primitive_type = (u32) EPrimitiveType::TriangleList;
+
+    return pipeline;
+  }
+
+  static auto parse_line(MutRef<Manifest> manifest, Ref<std::filesystem::path> base_dir, Ref<Vec<std::string>> tokens)
+      -> Result<void>
+  {
+    Ref<std::string> kind = tokens[0];
+
+    if (kind == "shader")
+    {
+      if (tokens.size() < 5)
+        return fail("shader expects <name> <source> <entry> <stage>");
+
+      Mut<ShaderDecl> shader{
+          .name = tokens[1],
+          .source = base_dir / tokens[2],
+          .entry_point = tokens[3],
+          .stage = AU_TRY(lookup(SHADER_STAGES, tokens[4])),
+      };
+      for (Mut<u64> i = 5; i < tokens.size(); i++)
+      {
+        const u64 equals = tokens[i].find('=');
+        if (equals == std::string::npos)
+          return fail("macro '{}' has no values", tokens[i]);
+
+        Mut<Vec<std::string>> values;
+        for (const auto value : split(std::string_view(tokens[i]).substr(equals + 1), '|'))
+          values.emplace_back(value);
+        shader.macros.emplace_back(tokens[i].substr(0, equals), std::move(values));
+      }
+      manifest.shaders.push_back(std::move(shader));
+    }
+    else if (kind == "compute")
+    {
+      if (tokens.size() != 3)
+        return fail("compute expects <name> <shader>");
+
+      Mut<PipelineDecl> pipeline = make_pipeline_decl(tokens[1], false);
+      pipeline.shaders = {tokens[2]};
+      manifest.pipelines.push_back(std::move(pipeline));
+    }
+    else if (kind == "graphics")
+    {
+      if (tokens.size() < 4)
+        return fail("graphics expects <name> <vertex shader> <fragment shader>");
+
+      Mut<PipelineDecl> pipeline = make_pipeline_decl(tokens[1], true);
+      pipeline.shaders = {tokens[2], tokens[3]};
+      for (Mut<u64> i = 4; i < tokens.size(); i++)
+      {
+        const u64 equals = tokens[i].find('=');
+        if (equals == std::string::npos)
+          return fail("expected key=value, got '{}'", tokens[i]);
+        AU_TRY_PURE(parse_graphics_key(pipeline, std::string_view(tokens[i]).substr(0, equals),
+                                       std::string_view(tokens[i]).substr(equals + 1)));
+      }
+      manifest.pipelines.push_back(std::move(pipeline));
+    }
+    else
+      return fail("unknown declaration '{}'", kind);
+
+    return {};
+  }
+
+  auto parse_manifest(Ref<std::filesystem::path> path) -> Result<Manifest>
+  {
+    Mut<std::ifstream> file(path);
+    if (!file)
+      return fail("failed to open manifest '{}'", path.string());
+
+    Mut<Manifest> manifest;
+    const std::filesystem::path base_dir = path.parent_path();
+
+    Mut<std::string> line;
+    for (Mut<u32> line_number = 1; std::getline(file, line); line_number++)
+    {
+      line = line.substr(0, line.find('#'));
+
+      Mut<std::istringstream> stream(line);
+      Mut<Vec<std::string>> tokens;
+      for (Mut<std::string> token; stream >> token;)
+        tokens.push_back(std::move(token));
+      if (tokens.empty())
+        continue;
+
+      const auto result = parse_line(manifest, base_dir, tokens);
+      if (!result)
+        return fail("{}:{}: {}", path.string(), line_number, result.error());
+    }
+
+    return manifest;
+  }
+
+  auto expand_permutations(Ref<Manifest> manifest, u32 decl_index) -> Vec<ShaderPermutation>
+  {
+    Ref<ShaderDecl> decl = manifest.shaders[decl_index];
+
+    Mut<Vec<ShaderPermutation>> permutations(1);
+    permutations[0].decl_index = decl_index;
+
+    // Cartesian product, the first macro varies slowest.
+    for (const auto &[macro, values] : decl.macros)
+    {
+      Mut<Vec<ShaderPermutation>> expanded;
+      expanded.reserve(permutations.size() * values.size());
+      for (const auto &permutation : permutations)
+      {
+        for (const auto &value : values)
+        {
+          expanded.push_back(permutation);
+          expanded.back().defines.emplace_back(macro, value);
+        }
+      }
+      permutations = std::move(expanded);
+    }
+
+    // Permutations are named "<shader>[MACRO=value,...]", a shader without macros keeps its plain name.
+    for (auto &permutation : permutations)
+    {
+      permutation.name = decl.name;
+      if (permutation.defines.empty())
+        continue;
+
+      permutation.name += '[';
+      for (Mut<u64> i = 0; i < permutation.defines.size(); i++)
+      {
+        if (i)
+          permutation.name += ',';
+        permutation.name += permutation.defines[i].first + '=' + permutation.defines[i].second;
+      }
+      permutation.name += ']';
+    }
+
+    return permutations;
+  }
+} // namespace ia::gpu::baker
@@ -0,0 +1,56 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <compiler.hpp>
+
+namespace ia::gpu::baker
+{
+  // Accumulates compiled shaders and pipelines and serializes them in the PipelineArchiveHeader layout.
+  class ArchiveWriter
+  {
+public:
+    auto add_shader(Ref<std::string> name, Ref<ShaderDecl> decl, Ref<CompiledShader> shader) -> u32;
+
+    // shader_indices are archive shader indices, one per shader of the declaration and in the same order.
+    auto add_pipeline(Ref<std::string> name, Ref<PipelineDecl> decl, std::span<const u32> shader_indices) -> void;
+
+    // Written to a temporary file first and renamed over the target, so build systems never see a partial archive.
+    auto write(Ref<std::filesystem::path> path) const -> Result<void>;
+
+    [[nodiscard]] auto get_shader_count() const -> u32
+    {
+      return (u32) m_shaders.size();
+    }
+
+    [[nodiscard]] auto get_pipeline_count() const -> u32
+    {
+      return (u32) m_pipelines.size();
+    }
+
+private:
+    auto add_string(std::string_view text) -> PipelineArchiveString;
+
+private:
+    Vec<PipelineArchiveShader> m_shaders;
+    Vec<Vec<u32>> m_code;
+    Vec<PipelineArchiveBinding> m_bindings;
+    Vec<PipelineArchivePipeline> m_pipelines;
+    Vec<PipelineArchiveVertexBinding> m_vertex_bindings;
+    Vec<PipelineArchiveVertexAttribute> m_vertex_attributes;
+    std::string m_strings;
+  };
+} // namespace ia::gpu::baker
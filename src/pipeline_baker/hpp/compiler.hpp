@@ -0,0 +1,46 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <manifest.hpp>
+
+#include <slang-com-ptr.h>
+#include <slang.h>
+
+namespace ia::gpu::baker
+{
+  struct CompiledShader
+  {
+    Vec<u32> spirv;
+    Vec<PipelineArchiveBinding> bindings;
+    u32 push_constant_size = 0;
+  };
+
+  // Compiles Slang entry points to SPIR-V and reflects their resource interface.
+  class ShaderCompiler
+  {
+public:
+    auto initialize(Ref<Vec<std::string>> include_dirs) -> Result<void>;
+
+    auto compile(Ref<ShaderDecl> decl, Ref<ShaderPermutation> permutation) -> Result<CompiledShader>;
+
+private:
+    Slang::ComPtr<slang::IGlobalSession> m_global_session;
+    Vec<std::string> m_include_dirs;
+  };
+
+  auto reflect_spirv(std::span<const u32> spirv, EShaderStage stage, MutRef<CompiledShader> out) -> Result<void>;
+} // namespace ia::gpu::baker
@@ -0,0 +1,82 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <gpu/gpu.hpp>
+#include <gpu/pipeline_archive.hpp>
+
+#include <crux/logger.hpp>
+
+#include <filesystem>
+#include <string>
+#include <utility>
+
+#define BAKER_LOG_INFO(...) IA_LOG_INFO("[Baker]: " __VA_ARGS__)
+#define BAKER_LOG_WARN(...) IA_LOG_WARN("[Baker]: " __VA_ARGS__)
+#define BAKER_LOG_ERROR(...) IA_LOG_ERROR("[Baker]: " __VA_ARGS__)
+
+namespace ia::gpu::baker
+{
+  // A shader entry point together with every value each of its macros may take. Baking compiles one permutation
+  // for every combination of the values.
+  struct ShaderDecl
+  {
+    std::string name;
+    std::filesystem::path source;
+    std::string entry_point;
+    EShaderStage stage = EShaderStage::None;
+    Vec<std::pair<std::string, Vec<std::string>>> macros;
+  };
+
+  struct ShaderPermutation
+  {
+    std::string name;
+    u32 decl_index = 0;
+    Vec<std::pair<std::string, std::string>> defines;
+  };
+
+  // A pipeline over base shader names, expanded once per combination of the permutations of its shaders. Shader
+  // indices and vertex input ranges in fixed_state are filled in when the archive is written.
+  struct PipelineDecl
+  {
+    std::string name;
+    bool is_graphics = false;
+    Vec<std::string> shaders;
+
+    PipelineArchivePipeline fixed_state{};
+    Vec<PipelineArchiveVertexBinding> vertex_bindings;
+    Vec<PipelineArchiveVertexAttribute> vertex_attributes;
+  };
+
+  struct Manifest
+  {
+    Vec<ShaderDecl> shaders;
+    Vec<PipelineDecl> pipelines;
+  };
+
+  // Line based manifest, '#' starts a comment:
+  //
+  //   shader   <name> <source.slang> <entry> <vertex|fragment|compute> [MACRO=a|b|c ...]
+  //   compute  <name> <shader>
+  //   graphics <name> <vertex shader> <fragment shader> [key=value ...]
+  //
+  // Graphics keys: color=<format>[,<format>...] depth=<format> cull=<mode> blend=<mode> polygon=<mode>
+  // topology=<type> push=<bytes> vb=<binding>:<stride>[:instance] va=<location>:<binding>:<format>:<offset>.
+  // Sources are resolved relative to the manifest.
+  auto parse_manifest(Ref<std::filesystem::path> path) -> Result<Manifest>;
+
+  auto expand_permutations(Ref<Manifest> manifest, u32 decl_index) -> Vec<ShaderPermutation>;
+} // namespace ia::gpu::baker
@@ -0,0 +1,235 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <test.hpp>
+
+#include <vulkan/context.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace ia;
+using namespace ia::gpu;
+using ia::gpu::vulkan::Context;
+
+static constexpr u32 ELEMENT_COUNT = 1 << 20;
+static constexpr u32 DISPATCHES_PER_QUEUE = 8;
+static constexpr u32 FILL_GROUP_SIZE = 64;
+
+// A single run can land both queues' work back to back on a busy device, a few attempts keep the test from flaking.
+static constexpr u32 ATTEMPT_COUNT = 4;
+
+struct FillPushConstants
+{
+  u32 count;
+  u32 value;
+};
+
+struct QueueWork
+{
+  Vec<Buffer> buffers;
+  Vec<DescriptorTable> tables;
+};
+
+static auto create_queue_work(MutRef<Context> ctx, Ref<LoadedPipeline> fill, MutRef<QueueWork> work) -> bool
+{
+  const Vec<BufferDesc> descs(DISPATCHES_PER_QUEUE, BufferDesc{
+                                                        .size_bytes = (u64) ELEMENT_COUNT * sizeof(u32),
+                                                        .usage = EBufferUsage::Storage,
+                                                        .debug_name = "test_async_output",
+                                                    });
+  work.buffers.resize(DISPATCHES_PER_QUEUE);
+  work.tables.resize(DISPATCHES_PER_QUEUE);
+  if (!ctx.create_buffers(descs, work.buffers) || !ctx.create_descriptor_tables(fill.layouts[0], work.tables))
+    return false;
+
+  Mut<Vec<DescriptorUpdate>> updates;
+  for (Mut<u32> i = 0; i < DISPATCHES_PER_QUEUE; i++)
+    updates.push_back({.table = work.tables[i], .binding = 0, .buffer = work.buffers[i]});
+  ctx.update_descriptor_tables(updates);
+  return true;
+}
+
+static auto record_queue_work(Context::CmdListType *cmd, Ref<LoadedPipeline> fill, Ref<QueueWork> work,
+                              const char *scope) -> void
+{
+  const FillPushConstants push_constants{.count = ELEMENT_COUNT, .value = 1};
+
+  cmd->begin_gpu_scope(scope);
+  for (const auto buffer : work.buffers)
+    cmd->transition_buffer(buffer, EResourceState::GeneralWrite);
+  cmd->begin_compute();
+  cmd->bind_pipeline(fill.pipeline);
+  cmd->push_constants(EShaderStage::Compute, 0, sizeof(push_constants), &push_constants);
+  for (const auto table : work.tables)
+  {
+    cmd->bind_descriptor_table(0, table);
+    cmd->dispatch(ELEMENT_COUNT / FILL_GROUP_SIZE, 1, 1);
+  }
+  cmd->end_compute();
+  cmd->end_gpu_scope();
+}
+
+// Submits the async compute work before the frame, without a wait on it, and waits for both queues.
+static auto run_both_queues(MutRef<Context> ctx, Ref<LoadedPipeline> fill, Ref<QueueWork> main_work,
+                            Ref<QueueWork> async_work) -> bool
+{
+  const auto cmd = ctx.begin_frame().first;
+  record_queue_work(cmd, fill, main_work, "main_queue");
+
+  const auto async_cmd = ctx.begin_async_compute_commands();
+  if (!async_cmd)
+  {
+    ctx.end_frame(cmd);
+    return false;
+  }
+  record_queue_work(async_cmd, fill, async_work, "async_compute_queue");
+
+  const u64 async_value = ctx.submit_async_compute_commands(async_cmd, 0);
+  ctx.end_frame(cmd);
+
+  ctx.wait_for_submission(ctx.get_last_submission_value(), UINT64_MAX);
+  return async_value && ctx.wait_for_async_compute(async_value, UINT64_MAX);
+}
+
+// Nanoseconds both queues' scopes overlapped in the frame the profiler read back last, -1 when one is missing.
+static auto get_scope_overlap_ns(Ref<GpuFrameTimings> timings) -> i64
+{
+  const GpuScopeTiming *main_scope = nullptr;
+  const GpuScopeTiming *async_scope = nullptr;
+  for (const auto &scope : timings.scopes)
+  {
+    if (!strcmp(scope.name, "main_queue"))
+      main_scope = &scope;
+    else if (!strcmp(scope.name, "async_compute_queue"))
+      async_scope = &scope;
+  }
+  if (!main_scope || !async_scope)
+    return -1;
+
+  const u64 begin = std::max(main_scope->begin_ns, async_scope->begin_ns);
+  const u64 end = std::min(main_scope->end_ns, async_scope->end_ns);
+  return end > begin ? (i64) (end - begin) : 0;
+}
+
+static auto destroy_queue_work(MutRef<Context> ctx, MutRef<QueueWork> work) -> void
+{
+  for (Mut<DescriptorTable> table : work.tables)
+  {
+    if (table)
+      ctx.destroy_descriptor_tables({&table, 1});
+  }
+  for (const auto buffer : work.buffers)
+  {
+    if (buffer)
+      ctx.destroy_buffers({&buffer, 1});
+  }
+}
+
+// Work submitted to a separate async compute family without a wait on the frame must run beside the frame's work,
+// checked against the calibrated GPU timestamps of both queues.
+int main()
+{
+#if !IAGPU_DISABLE_GRAPHICS
+  TEST_LOG_WARN("Skipped: creating a context needs a surface in graphics builds");
+  return test::SKIP_EXIT_CODE;
+#else
+#ifndef IAGPU_TEST_ARCHIVE
+  TEST_LOG_WARN("Skipped: built without the pipeline baker, there is no test archive");
+  return test::SKIP_EXIT_CODE;
+#else
+  const ContextConfig config{
+      .app_name = "iagpu_tests",
+      .validation_enabled = 0,
+      .pipeline_cache_path = nullptr,
+      .async_compute_enabled = 1,
+      .gpu_profiling_enabled = 1,
+  };
+  auto created = Context::create(config);
+  if (!created)
+  {
+    TEST_LOG_WARN("Skipped: no context could be created: {}", created.error());
+    return test::SKIP_EXIT_CODE;
+  }
+  MutRef<Context> ctx = *created;
+  if (!ctx.has_async_compute_family())
+  {
+    TEST_LOG_WARN("Skipped: the device has no separate async compute queue family");
+    return test::SKIP_EXIT_CODE;
+  }
+
+  auto loaded = ctx.load_pipeline_archive(IAGPU_TEST_ARCHIVE, 0);
+  if (!loaded)
+  {
+    TEST_LOG_ERROR("The test archive failed to load: {}", loaded.error());
+    return 1;
+  }
+  Mut<LoadedPipelineArchive> archive = std::move(*loaded);
+  const LoadedPipeline *fill = archive.find_pipeline("fill");
+  TEST_CHECK(fill != nullptr);
+
+  Mut<QueueWork> main_work;
+  Mut<QueueWork> async_work;
+  Mut<int> exit_code = 0;
+  if (!fill)
+    exit_code = 1;
+  else if (!create_queue_work(ctx, *fill, main_work) || !create_queue_work(ctx, *fill, async_work))
+  {
+    TEST_LOG_ERROR("Creating the queues' buffers failed");
+    exit_code = 1;
+  }
+  else
+  {
+    Mut<i64> overlap = -1;
+    Mut<bool> is_calibrated = true;
+    for (Mut<u32> attempt = 0; attempt < ATTEMPT_COUNT && overlap <= 0 && is_calibrated; attempt++)
+    {
+      TEST_CHECK(run_both_queues(ctx, *fill, main_work, async_work));
+
+      // The profiler reads a frame slot back when the slot is reopened, MAX_PENDING_FRAME_COUNT frames later.
+      for (Mut<u32> i = 0; i < MAX_PENDING_FRAME_COUNT; i++)
+        ctx.end_frame(ctx.begin_frame().first);
+
+      const auto timings = ctx.get_gpu_frame_timings();
+      is_calibrated = timings.is_calibrated;
+      overlap = get_scope_overlap_ns(timings);
+    }
+
+    if (!is_calibrated)
+    {
+      TEST_LOG_WARN("Skipped: GPU timestamps are not calibrated, the queues' times can't be compared");
+      exit_code = test::SKIP_EXIT_CODE;
+    }
+    else if (overlap < 0)
+    {
+      TEST_LOG_WARN("Skipped: GPU timestamps are unavailable on one of the queues");
+      exit_code = test::SKIP_EXIT_CODE;
+    }
+    else
+    {
+      TEST_LOG_INFO("The queues overlapped for {} ns", overlap);
+      TEST_CHECK(overlap > 0);
+    }
+  }
+
+  destroy_queue_work(ctx, main_work);
+  destroy_queue_work(ctx, async_work);
+  ctx.wait_idle();
+  ctx.unload_pipeline_archive(archive);
+
+  return exit_code ? exit_code : test::get_exit_code();
+#endif
+#endif
+}
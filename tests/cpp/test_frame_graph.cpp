@@ -0,0 +1,162 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <test.hpp>
+
+#include <vulkan/frame_graph.hpp>
+
+using namespace ia;
+using namespace ia::gpu;
+using ia::gpu::vulkan::FrameGraph;
+
+// compile() only looks at the handles, so the graphs are built from made-up ones without a device.
+static auto make_buffer(u64 id) -> Buffer
+{
+  return reinterpret_cast<Buffer>(id);
+}
+
+#if !IAGPU_DISABLE_GRAPHICS
+static auto make_texture(u64 id) -> Texture
+{
+  return reinterpret_cast<Texture>(id);
+}
+#endif
+
+static auto no_commands(vulkan::CommandList *) -> void
+{
+}
+
+// Passes whose outputs nothing exported consumes are dropped, along with the chains feeding only them. Passes with
+// side effects stay.
+static auto test_pass_culling() -> void
+{
+  Mut<FrameGraph> graph;
+  graph.add_compute_pass("produce_a", no_commands).write(make_buffer(1));
+  graph.add_compute_pass("produce_b", no_commands).write(make_buffer(2));
+  graph.add_compute_pass("unused_output", no_commands).write(make_buffer(4));
+  graph.add_compute_pass("consume", no_commands).read(make_buffer(1)).read(make_buffer(2)).write(make_buffer(3));
+  graph.add_compute_pass("dead_chain_head", no_commands).write(make_buffer(5));
+  graph.add_compute_pass("dead_chain_tail", no_commands).read(make_buffer(5)).write(make_buffer(6));
+  graph.add_transfer_pass("readback", no_commands).read(make_buffer(3)).side_effects();
+  graph.export_buffer(make_buffer(3));
+
+  TEST_CHECK(graph.compile());
+  TEST_CHECK(graph.get_culled_pass_count() == 3);
+  TEST_CHECK(graph.is_pass_scheduled(0));
+  TEST_CHECK(graph.is_pass_scheduled(1));
+  TEST_CHECK(!graph.is_pass_scheduled(2));
+  TEST_CHECK(graph.is_pass_scheduled(3));
+  TEST_CHECK(!graph.is_pass_scheduled(4));
+  TEST_CHECK(!graph.is_pass_scheduled(5));
+  TEST_CHECK(graph.is_pass_scheduled(6));
+
+  // Nothing exported, everything but the pass with side effects goes.
+  graph.reset();
+  graph.add_compute_pass("produce", no_commands).write(make_buffer(1));
+  graph.add_compute_pass("side_effects", no_commands).read(make_buffer(2)).side_effects();
+
+  TEST_CHECK(graph.compile());
+  TEST_CHECK(graph.get_culled_pass_count() == 1);
+  TEST_CHECK(!graph.is_pass_scheduled(0));
+  TEST_CHECK(graph.is_pass_scheduled(1));
+}
+
+// Transitions move to the latest pass boundary that still serves the most of them: the two independent producers
+// share one barrier, the consumer's reads another. A chain where each pass needs the previous one's output can't be
+// batched and keeps one barrier per pass.
+static auto test_barrier_batching() -> void
+{
+  Mut<FrameGraph> graph;
+  graph.add_compute_pass("produce_a", no_commands).write(make_buffer(1));
+  graph.add_compute_pass("produce_b", no_commands).write(make_buffer(2));
+  graph.add_compute_pass("consume", no_commands).read(make_buffer(1)).read(make_buffer(2)).write(make_buffer(3));
+  graph.export_buffer(make_buffer(3));
+
+  TEST_CHECK(graph.compile());
+  TEST_CHECK(graph.get_culled_pass_count() == 0);
+  TEST_CHECK(graph.get_barrier_point_count() == 2);
+
+  graph.reset();
+  graph.add_compute_pass("first", no_commands).write(make_buffer(1));
+  graph.add_compute_pass("second", no_commands).read(make_buffer(1)).write(make_buffer(2));
+  graph.add_compute_pass("third", no_commands).read(make_buffer(2)).write(make_buffer(3));
+  graph.export_buffer(make_buffer(3));
+
+  TEST_CHECK(graph.compile());
+  TEST_CHECK(graph.get_barrier_point_count() == 3);
+
+  // Final states of exports are placed after the last pass, all of them in one barrier.
+  graph.reset();
+  graph.add_compute_pass("produce_a", no_commands).write(make_buffer(1));
+  graph.add_compute_pass("produce_b", no_commands).write(make_buffer(2));
+  graph.export_buffer(make_buffer(1), EResourceState::GeneralRead);
+  graph.export_buffer(make_buffer(2), EResourceState::GeneralRead);
+
+  TEST_CHECK(graph.compile());
+  TEST_CHECK(graph.get_barrier_point_count() == 2);
+}
+
+#if !IAGPU_DISABLE_GRAPHICS
+// Attachments load only contents produced earlier (imports included), clear when asked to, and store only what a
+// later pass or the outside world reads.
+static auto test_attachment_ops() -> void
+{
+  const Texture cleared = make_texture(1);
+  const Texture transient = make_texture(2);
+  const Texture imported = make_texture(3);
+  const Texture depth = make_texture(4);
+
+  Mut<FrameGraph> graph;
+  graph.import_texture(imported);
+  graph.add_render_pass("gbuffer", no_commands)
+      .clear_color_attachment(cleared, 0.0f, 0.0f, 0.0f, 1.0f)
+      .depth_attachment(depth);
+  graph.add_render_pass("overlay", no_commands).color_attachment(imported).color_attachment(transient);
+  graph.add_compute_pass("resolve", no_commands).read(transient).write(make_buffer(5));
+  graph.export_texture(cleared);
+  graph.export_texture(imported);
+  graph.export_buffer(make_buffer(5));
+
+  TEST_CHECK(graph.compile());
+  TEST_CHECK(graph.get_culled_pass_count() == 0);
+
+  using Ops = std::pair<ELoadOp, EStoreOp>;
+  TEST_CHECK(graph.get_attachment_ops(0, cleared) == Ops(ELoadOp::Clear, EStoreOp::Store));
+  TEST_CHECK(graph.get_attachment_ops(0, depth) == Ops(ELoadOp::DontCare, EStoreOp::DontCare));
+  TEST_CHECK(graph.get_attachment_ops(1, imported) == Ops(ELoadOp::Load, EStoreOp::Store));
+  TEST_CHECK(graph.get_attachment_ops(1, transient) == Ops(ELoadOp::DontCare, EStoreOp::Store));
+
+  // A second pass drawing onto the same attachment loads what the first one stored.
+  graph.reset();
+  graph.add_render_pass("background", no_commands).clear_color_attachment(cleared, 0.0f, 0.0f, 0.0f, 1.0f);
+  graph.add_render_pass("foreground", no_commands).color_attachment(cleared);
+  graph.export_texture(cleared);
+
+  TEST_CHECK(graph.compile());
+  TEST_CHECK(graph.get_attachment_ops(0, cleared) == Ops(ELoadOp::Clear, EStoreOp::Store));
+  TEST_CHECK(graph.get_attachment_ops(1, cleared) == Ops(ELoadOp::Load, EStoreOp::Store));
+}
+#endif
+
+int main()
+{
+  test_pass_culling();
+  test_barrier_batching();
+#if !IAGPU_DISABLE_GRAPHICS
+  test_attachment_ops();
+#endif
+
+  return test::get_exit_code();
+}
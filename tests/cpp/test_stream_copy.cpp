@@ -0,0 +1,96 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <test.hpp>
+
+#include <stream_copy.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+using namespace ia;
+using namespace ia::gpu;
+
+static constexpr EStreamCopyPath PATHS[] = {EStreamCopyPath::Memcpy, EStreamCopyPath::Sse2, EStreamCopyPath::Avx2,
+                                            EStreamCopyPath::Avx512, EStreamCopyPath::Neon};
+
+// Compares `path` byte for byte against memcpy for every destination misalignment within a cache line, with sizes
+// around the streaming threshold and around whole lines. The bytes past the copy must stay untouched.
+static auto verify_stream_copy(EStreamCopyPath path) -> bool
+{
+  static constexpr u64 LINE_SIZE = 64;
+  static constexpr u64 STREAM_THRESHOLD = 256;
+  static constexpr u64 GUARD_SIZE = LINE_SIZE;
+
+  Mut<Vec<u64>> sizes{0, 1, STREAM_THRESHOLD - 1, STREAM_THRESHOLD, STREAM_THRESHOLD + 1};
+  for (const u64 lines : {1, 2, 3, 4, 5, 8, 17, 64, 1000})
+  {
+    sizes.push_back(lines * LINE_SIZE - 1);
+    sizes.push_back(lines * LINE_SIZE);
+    sizes.push_back(lines * LINE_SIZE + 1);
+  }
+
+  const u64 max_size = 1000 * LINE_SIZE + 1;
+  Mut<Vec<u8>> src(max_size + LINE_SIZE);
+  for (Mut<u64> i = 0; i < src.size(); i++)
+    src[i] = (u8) (i * 7 + 3);
+
+  // Over-allocated so that every misalignment can be reached from a line-aligned base.
+  Mut<Vec<u8>> actual(max_size + 2 * LINE_SIZE + GUARD_SIZE);
+  Mut<Vec<u8>> expected(actual.size());
+  const u64 misalignment = reinterpret_cast<uintptr_t>(actual.data()) & (LINE_SIZE - 1);
+  const u64 base_offset = (LINE_SIZE - misalignment) & (LINE_SIZE - 1);
+  u8 *actual_base = actual.data() + base_offset;
+  u8 *expected_base = expected.data() + base_offset;
+
+  for (const u64 size : sizes)
+  {
+    for (Mut<u64> dst_offset = 0; dst_offset < LINE_SIZE; dst_offset++)
+    {
+      // The source offset varies too, the kernels load unaligned.
+      const u8 *source = src.data() + (dst_offset * 5) % LINE_SIZE;
+
+      memset(actual.data(), 0xCD, actual.size());
+      memset(expected.data(), 0xCD, expected.size());
+      stream_copy(path, actual_base + dst_offset, source, size);
+      memcpy(expected_base + dst_offset, source, size);
+
+      if (memcmp(actual.data(), expected.data(), actual.size()) != 0)
+      {
+        TEST_LOG_ERROR("stream_copy {} differs from memcpy for {} bytes at destination offset {}",
+                       get_stream_copy_path_name(path), size, dst_offset);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Every path the CPU supports, the one picked for the process among them, must copy exactly like memcpy.
+int main()
+{
+  for (const auto path : PATHS)
+  {
+    if (!is_stream_copy_path_supported(path))
+    {
+      TEST_LOG_INFO("stream_copy {} is not supported by this CPU", get_stream_copy_path_name(path));
+      continue;
+    }
+    TEST_CHECK(verify_stream_copy(path));
+  }
+
+  return test::get_exit_code();
+}
@@ -0,0 +1,59 @@
+// IAGPU: IA GPU Hardware Interface.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <gpu/gpu.hpp>
+
+#include <crux/logger.hpp>
+
+#define TEST_LOG_INFO(...) IA_LOG_INFO("[Test]: " __VA_ARGS__)
+#define TEST_LOG_WARN(...) IA_LOG_WARN("[Test]: " __VA_ARGS__)
+#define TEST_LOG_ERROR(...) IA_LOG_ERROR("[Test]: " __VA_ARGS__)
+
+// Logs the failed condition and carries on, so one run reports every failing check. The test's main returns
+// ia::gpu::test::get_exit_code() at the end.
+#define TEST_CHECK(condition)                                                                                          \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    if (!(condition))                                                                                                  \
+    {                                                                                                                  \
+      TEST_LOG_ERROR("{}:{}: check failed: {}", __FILE__, __LINE__, #condition);                                       \
+      ::ia::gpu::test::record_failure();                                                                               \
+    }                                                                                                                  \
+  } while (0)
+
+namespace ia::gpu::test
+{
+  // Exit code ctest reports as skipped (SKIP_RETURN_CODE in tests/CMakeLists.txt), for tests that need a device or a
+  // feature the machine running them lacks.
+  static constexpr int SKIP_EXIT_CODE = 77;
+
+  inline auto get_failure_count() -> MutRef<u32>
+  {
+    static Mut<u32> count = 0;
+    return count;
+  }
+
+  inline auto record_failure() -> void
+  {
+    get_failure_count()++;
+  }
+
+  inline auto get_exit_code() -> int
+  {
+    return get_failure_count() ? 1 : 0;
+  }
+} // namespace ia::gpu::test